@@ -39,6 +39,20 @@ extern "C" {
 #define LCD_GPIO_DATA14     GPIO_NUM_41
 #define LCD_GPIO_DATA15     GPIO_NUM_40
 
+/**
+ * @brief LCD Timing (800x480 panel)
+ */
+#define LCD_HSYNC_PULSE_WIDTH   4
+#define LCD_HSYNC_BACK_PORCH    8
+#define LCD_HSYNC_FRONT_PORCH   8
+#define LCD_VSYNC_PULSE_WIDTH   4
+#define LCD_VSYNC_BACK_PORCH    8
+#define LCD_VSYNC_FRONT_PORCH   8
+
+/// Blanking per line (pixel clocks) and per frame (lines)
+#define LCD_H_BLANK_PX      (LCD_HSYNC_PULSE_WIDTH + LCD_HSYNC_BACK_PORCH + LCD_HSYNC_FRONT_PORCH)
+#define LCD_V_BLANK_LINES   (LCD_VSYNC_PULSE_WIDTH + LCD_VSYNC_BACK_PORCH + LCD_VSYNC_FRONT_PORCH)
+
 /**
  * @brief LCD configuration structure
  */
@@ -90,6 +104,19 @@ esp_err_t waveshare_lcd_get_frame_buffer(
     void **fb1
 );
 
+/**
+ * @brief Change the pixel clock of a running panel
+ * 
+ * Takes effect at the next frame boundary. Lower clocks reduce the frame
+ * rate and the PSRAM bandwidth used by scan-out; the panel must tolerate
+ * the resulting refresh rate.
+ * 
+ * @param panel_handle LCD panel handle
+ * @param pixel_clock_hz New pixel clock frequency
+ * @return ESP_OK on success
+ */
+esp_err_t waveshare_lcd_set_pixel_clock(esp_lcd_panel_handle_t panel_handle, uint32_t pixel_clock_hz);
+
 #ifdef __cplusplus
 }
 #endif
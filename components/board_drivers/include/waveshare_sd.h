@@ -11,6 +11,7 @@
 #include "esp_vfs_fat.h"
 #include "sdmmc_cmd.h"
 #include "ch422g.h"
+#include <stdio.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -27,8 +28,42 @@ typedef struct {
     ch422g_handle_t ch422g_handle;  ///< CH422G handle for CS control
     int max_files;                  ///< Maximum number of open files
     bool format_if_mount_failed;    ///< Format card if mount fails
+    int max_freq_khz;               ///< SPI clock (0 = SDMMC_FREQ_DEFAULT)
+    size_t io_buffer_size;          ///< Per-file I/O buffer size (0 = WAVESHARE_SD_IO_BUFFER_DEFAULT)
+    bool io_buffer_in_psram;        ///< Place I/O buffers in PSRAM instead of internal DMA RAM
 } waveshare_sd_config_t;
 
+/**
+ * @brief Default per-file I/O buffer size (one FAT allocation unit)
+ */
+#define WAVESHARE_SD_IO_BUFFER_DEFAULT  (16 * 1024)
+
+/**
+ * @brief I/O buffer alignment (cache line / DMA burst friendly)
+ */
+#define WAVESHARE_SD_IO_BUFFER_ALIGN    64
+
+/**
+ * @brief Latency percentiles for one benchmark phase (microseconds)
+ */
+typedef struct {
+    uint32_t ops;                   ///< Number of timed operations
+    uint32_t kbytes_per_sec;        ///< Throughput over the whole phase
+    uint32_t p50_us;                ///< Median operation latency
+    uint32_t p90_us;                ///< 90th percentile latency
+    uint32_t p99_us;                ///< 99th percentile latency
+    uint32_t max_us;                ///< Worst operation latency
+} waveshare_sd_bench_phase_t;
+
+/**
+ * @brief SD card benchmark results
+ */
+typedef struct {
+    waveshare_sd_bench_phase_t seq_write;     ///< Sequential write, io_buffer_size chunks
+    waveshare_sd_bench_phase_t seq_read;      ///< Sequential read, io_buffer_size chunks
+    waveshare_sd_bench_phase_t random_write;  ///< Small random writes, each followed by fsync
+} waveshare_sd_bench_result_t;
+
 /**
  * @brief SD card handle
  */
@@ -78,6 +113,42 @@ bool waveshare_sd_file_exists(const char *path);
  */
 esp_err_t waveshare_sd_read_file(const char *path, char **buffer, size_t *size);
 
+/**
+ * @brief Read entire file into a buffer allocated with the given heap caps
+ * 
+ * Reads through an aligned DMA-capable bounce buffer when the destination
+ * is not DMA-capable (e.g. PSRAM), so the card is still read in
+ * multi-sector transfers.
+ * 
+ * @param path Full path to the file
+ * @param caps heap_caps flags for the output buffer (e.g. MALLOC_CAP_SPIRAM)
+ * @param buffer Pointer to store allocated buffer (caller must free)
+ * @param size Pointer to store file size
+ * @return ESP_OK on success
+ */
+esp_err_t waveshare_sd_read_file_caps(const char *path, uint32_t caps, char **buffer, size_t *size);
+
+/**
+ * @brief Open a file with a driver-allocated stdio buffer
+ * 
+ * Same as fopen(), but replaces newlib's small default buffer with an
+ * aligned buffer of the configured I/O buffer size so reads and writes
+ * reach the card as multi-sector transfers. Close with waveshare_sd_fclose().
+ * 
+ * @param path Full path to the file
+ * @param mode fopen() mode string
+ * @return FILE pointer, or NULL on failure
+ */
+FILE *waveshare_sd_fopen(const char *path, const char *mode);
+
+/**
+ * @brief Close a file opened with waveshare_sd_fopen() and free its buffer
+ * 
+ * @param file File to close
+ * @return 0 on success, EOF on error (as fclose())
+ */
+int waveshare_sd_fclose(FILE *file);
+
 /**
  * @brief Write data to file atomically (write to temp, then rename)
  * 
@@ -88,6 +159,27 @@ esp_err_t waveshare_sd_read_file(const char *path, char **buffer, size_t *size);
  */
 esp_err_t waveshare_sd_write_file_atomic(const char *path, const char *data, size_t size);
 
+/**
+ * @brief Run the SD card I/O benchmark
+ * 
+ * Writes and reads back a scratch file at @p path, then performs small
+ * random writes into it, timing each operation. The file is deleted
+ * afterwards.
+ * 
+ * @param path Scratch file path (e.g., "/sdcard/bench.bin")
+ * @param total_bytes Size of the sequential phases
+ * @param result Output: throughput and latency percentiles per phase
+ * @return ESP_OK on success
+ */
+esp_err_t waveshare_sd_benchmark(const char *path, size_t total_bytes, waveshare_sd_bench_result_t *result);
+
+/**
+ * @brief Log benchmark results
+ * 
+ * @param result Results from waveshare_sd_benchmark()
+ */
+void waveshare_sd_benchmark_log(const waveshare_sd_bench_result_t *result);
+
 #ifdef __cplusplus
 }
 #endif
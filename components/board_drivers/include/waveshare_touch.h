@@ -20,6 +20,8 @@ extern "C" {
 
 /**
  * @brief GPIO4 used for touch reset timing
+ * 
+ * After reset it is the GT911 INT output (falling edge per report).
  */
 #define TOUCH_GPIO4         GPIO_NUM_4
 
@@ -31,6 +33,8 @@ typedef struct {
     int h_res;                      ///< Horizontal resolution
     int v_res;                      ///< Vertical resolution
     ch422g_handle_t ch422g_handle;  ///< CH422G handle for reset sequence
+    bool use_interrupt;             ///< Configure GPIO4 as the INT input (register the
+                                    ///< handler with esp_lcd_touch_register_interrupt_callback)
 } waveshare_touch_config_t;
 
 /**
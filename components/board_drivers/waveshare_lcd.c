@@ -24,12 +24,12 @@ esp_err_t waveshare_lcd_init(const waveshare_lcd_config_t *config, esp_lcd_panel
             .h_res = config->h_res,
             .v_res = config->v_res,
             // Timing parameters for 800x480 panel
-            .hsync_pulse_width = 4,
-            .hsync_back_porch = 8,
-            .hsync_front_porch = 8,
-            .vsync_pulse_width = 4,
-            .vsync_back_porch = 8,
-            .vsync_front_porch = 8,
+            .hsync_pulse_width = LCD_HSYNC_PULSE_WIDTH,
+            .hsync_back_porch = LCD_HSYNC_BACK_PORCH,
+            .hsync_front_porch = LCD_HSYNC_FRONT_PORCH,
+            .vsync_pulse_width = LCD_VSYNC_PULSE_WIDTH,
+            .vsync_back_porch = LCD_VSYNC_BACK_PORCH,
+            .vsync_front_porch = LCD_VSYNC_FRONT_PORCH,
             .flags = {
                 .pclk_active_neg = 1,
             },
@@ -121,3 +121,10 @@ esp_err_t waveshare_lcd_get_frame_buffer(
         return esp_lcd_rgb_panel_get_frame_buffer(panel_handle, 2, fb0, fb1);
     }
 }
+
+esp_err_t waveshare_lcd_set_pixel_clock(esp_lcd_panel_handle_t panel_handle, uint32_t pixel_clock_hz)
+{
+    ESP_RETURN_ON_FALSE(panel_handle != NULL, ESP_ERR_INVALID_ARG, TAG, "panel_handle is NULL");
+
+    return esp_lcd_rgb_panel_set_pclk(panel_handle, pixel_clock_hz);
+}
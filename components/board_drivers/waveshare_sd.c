@@ -8,12 +8,36 @@
 #include "esp_check.h"
 #include "driver/sdspi_host.h"
 #include "driver/spi_common.h"
+#include "esp_heap_caps.h"
+#include "esp_memory_utils.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include <stdlib.h>
 #include <string.h>
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <sys/unistd.h>
 
 static const char *TAG = "waveshare_sd";
 
+/// Max files opened with waveshare_sd_fopen() at once
+#define WAVESHARE_SD_MAX_BUFFERED_FILES 8
+
+/// Benchmark random-write phase: operation count and write size
+#define WAVESHARE_SD_BENCH_RANDOM_OPS   128
+#define WAVESHARE_SD_BENCH_RANDOM_SIZE  512
+
+// Buffered I/O settings (set by waveshare_sd_init, used by the path helpers)
+static size_t s_io_buf_size = WAVESHARE_SD_IO_BUFFER_DEFAULT;
+static uint32_t s_io_buf_caps = MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA;
+
+// Buffers owned by files opened with waveshare_sd_fopen()
+static struct {
+    FILE *file;
+    void *buf;
+} s_file_bufs[WAVESHARE_SD_MAX_BUFFERED_FILES];
+static portMUX_TYPE s_file_bufs_lock = portMUX_INITIALIZER_UNLOCKED;
+
 /**
  * @brief SD card device structure
  */
@@ -60,6 +84,9 @@ esp_err_t waveshare_sd_init(const waveshare_sd_config_t *config, waveshare_sd_ha
     };
 
     dev->host = (sdmmc_host_t)SDSPI_HOST_DEFAULT();
+    if (config->max_freq_khz > 0) {
+        dev->host.max_freq_khz = config->max_freq_khz;
+    }
     
     ret = spi_bus_initialize(dev->host.slot, &bus_cfg, SDSPI_DEFAULT_DMA);
     if (ret != ESP_OK) {
@@ -94,6 +121,12 @@ esp_err_t waveshare_sd_init(const waveshare_sd_config_t *config, waveshare_sd_ha
 
     dev->mounted = true;
     
+    // Buffered I/O settings
+    s_io_buf_size = config->io_buffer_size > 0 ? config->io_buffer_size : WAVESHARE_SD_IO_BUFFER_DEFAULT;
+    s_io_buf_caps = config->io_buffer_in_psram ? MALLOC_CAP_SPIRAM : (MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+    ESP_LOGI(TAG, "I/O buffers: %zu bytes in %s", s_io_buf_size,
+             config->io_buffer_in_psram ? "PSRAM" : "internal DMA RAM");
+    
     // Print card info
     sdmmc_card_print_info(stdout, dev->card);
 
@@ -137,7 +170,85 @@ bool waveshare_sd_file_exists(const char *path)
     return (stat(path, &st) == 0);
 }
 
+/**
+ * @brief Allocate an aligned I/O buffer, falling back to internal RAM
+ */
+static void *alloc_io_buffer(size_t size)
+{
+    void *buf = heap_caps_aligned_alloc(WAVESHARE_SD_IO_BUFFER_ALIGN, size, s_io_buf_caps);
+    if (!buf && s_io_buf_caps != (MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA)) {
+        buf = heap_caps_aligned_alloc(WAVESHARE_SD_IO_BUFFER_ALIGN, size, MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+    }
+    return buf;
+}
+
+FILE *waveshare_sd_fopen(const char *path, const char *mode)
+{
+    FILE *f = fopen(path, mode);
+    if (f == NULL) {
+        return NULL;
+    }
+
+    void *buf = alloc_io_buffer(s_io_buf_size);
+    if (buf == NULL) {
+        ESP_LOGW(TAG, "No memory for I/O buffer, using default buffering for %s", path);
+        return f;
+    }
+
+    bool registered = false;
+    portENTER_CRITICAL(&s_file_bufs_lock);
+    for (int i = 0; i < WAVESHARE_SD_MAX_BUFFERED_FILES; i++) {
+        if (s_file_bufs[i].file == NULL) {
+            s_file_bufs[i].file = f;
+            s_file_bufs[i].buf = buf;
+            registered = true;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_file_bufs_lock);
+
+    if (!registered || setvbuf(f, buf, _IOFBF, s_io_buf_size) != 0) {
+        // Keep newlib's default buffering; the buffer is freed on close
+        // if it was registered, otherwise right away
+        if (!registered) {
+            heap_caps_free(buf);
+        }
+        ESP_LOGW(TAG, "Using default buffering for %s", path);
+    }
+
+    return f;
+}
+
+int waveshare_sd_fclose(FILE *file)
+{
+    if (file == NULL) {
+        return EOF;
+    }
+
+    int ret = fclose(file);
+
+    void *buf = NULL;
+    portENTER_CRITICAL(&s_file_bufs_lock);
+    for (int i = 0; i < WAVESHARE_SD_MAX_BUFFERED_FILES; i++) {
+        if (s_file_bufs[i].file == file) {
+            buf = s_file_bufs[i].buf;
+            s_file_bufs[i].file = NULL;
+            s_file_bufs[i].buf = NULL;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_file_bufs_lock);
+
+    heap_caps_free(buf);
+    return ret;
+}
+
 esp_err_t waveshare_sd_read_file(const char *path, char **buffer, size_t *size)
+{
+    return waveshare_sd_read_file_caps(path, MALLOC_CAP_DEFAULT, buffer, size);
+}
+
+esp_err_t waveshare_sd_read_file_caps(const char *path, uint32_t caps, char **buffer, size_t *size)
 {
     ESP_RETURN_ON_FALSE(path != NULL, ESP_ERR_INVALID_ARG, TAG, "path is NULL");
     ESP_RETURN_ON_FALSE(buffer != NULL, ESP_ERR_INVALID_ARG, TAG, "buffer is NULL");
@@ -149,23 +260,52 @@ esp_err_t waveshare_sd_read_file(const char *path, char **buffer, size_t *size)
         return ESP_ERR_NOT_FOUND;
     }
 
-    FILE *f = fopen(path, "r");
-    if (f == NULL) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
         ESP_LOGE(TAG, "Failed to open file: %s", path);
         return ESP_FAIL;
     }
 
     *size = st.st_size;
-    *buffer = malloc(*size + 1);
+    *buffer = heap_caps_malloc(*size + 1, caps);
     if (*buffer == NULL) {
-        fclose(f);
+        close(fd);
         return ESP_ERR_NO_MEM;
     }
 
-    size_t read_size = fread(*buffer, 1, *size, f);
-    fclose(f);
+    // The SD driver only does multi-sector DMA into DMA-capable, word
+    // aligned memory; anything else is read one sector at a time through
+    // its own bounce buffer. Use a large bounce buffer of our own instead.
+    char *bounce = NULL;
+    if (!esp_ptr_dma_capable(*buffer) || ((uintptr_t)*buffer & 3) != 0) {
+        bounce = heap_caps_aligned_alloc(WAVESHARE_SD_IO_BUFFER_ALIGN, s_io_buf_size,
+                                         MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+    }
 
-    if (read_size != *size) {
+    size_t total = 0;
+    while (total < *size) {
+        size_t want = *size - total;
+        ssize_t got;
+        if (bounce) {
+            if (want > s_io_buf_size) {
+                want = s_io_buf_size;
+            }
+            got = read(fd, bounce, want);
+            if (got > 0) {
+                memcpy(*buffer + total, bounce, got);
+            }
+        } else {
+            got = read(fd, *buffer + total, want);
+        }
+        if (got <= 0) {
+            break;
+        }
+        total += got;
+    }
+    close(fd);
+    heap_caps_free(bounce);
+
+    if (total != *size) {
         free(*buffer);
         *buffer = NULL;
         return ESP_FAIL;
@@ -187,16 +327,17 @@ esp_err_t waveshare_sd_write_file_atomic(const char *path, const char *data, siz
     snprintf(temp_path, sizeof(temp_path), "%s.tmp", path);
 
     // Write to temp file
-    FILE *f = fopen(temp_path, "w");
+    FILE *f = waveshare_sd_fopen(temp_path, "w");
     if (f == NULL) {
         ESP_LOGE(TAG, "Failed to create temp file: %s", temp_path);
         return ESP_FAIL;
     }
 
     size_t written = fwrite(data, 1, size, f);
-    fclose(f);
+    bool synced = (fflush(f) == 0) && (fsync(fileno(f)) == 0);
+    waveshare_sd_fclose(f);
 
-    if (written != size) {
+    if (written != size || !synced) {
         ESP_LOGE(TAG, "Failed to write all data to temp file");
         unlink(temp_path);
         return ESP_FAIL;
@@ -217,3 +358,147 @@ esp_err_t waveshare_sd_write_file_atomic(const char *path, const char *data, siz
     ESP_LOGD(TAG, "Atomically wrote %zu bytes to %s", size, path);
     return ESP_OK;
 }
+
+// ============================================================================
+// Benchmark
+// ============================================================================
+
+static int compare_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Fill in throughput and latency percentiles for one phase
+ */
+static void bench_summarize(uint32_t *lat_us, uint32_t ops, size_t bytes, int64_t elapsed_us,
+                            waveshare_sd_bench_phase_t *phase)
+{
+    memset(phase, 0, sizeof(*phase));
+    phase->ops = ops;
+    if (ops == 0) {
+        return;
+    }
+
+    qsort(lat_us, ops, sizeof(uint32_t), compare_u32);
+    phase->p50_us = lat_us[(ops * 50) / 100];
+    phase->p90_us = lat_us[(ops * 90) / 100];
+    phase->p99_us = lat_us[(ops * 99) / 100];
+    phase->max_us = lat_us[ops - 1];
+    if (elapsed_us > 0) {
+        phase->kbytes_per_sec = (uint32_t)(((uint64_t)bytes * 1000000ULL) / ((uint64_t)elapsed_us * 1024ULL));
+    }
+}
+
+esp_err_t waveshare_sd_benchmark(const char *path, size_t total_bytes, waveshare_sd_bench_result_t *result)
+{
+    ESP_RETURN_ON_FALSE(path != NULL, ESP_ERR_INVALID_ARG, TAG, "path is NULL");
+    ESP_RETURN_ON_FALSE(result != NULL, ESP_ERR_INVALID_ARG, TAG, "result is NULL");
+
+    size_t chunk = s_io_buf_size;
+    uint32_t seq_ops = (total_bytes + chunk - 1) / chunk;
+    ESP_RETURN_ON_FALSE(seq_ops > 0, ESP_ERR_INVALID_ARG, TAG, "total_bytes is 0");
+    total_bytes = (size_t)seq_ops * chunk;
+    uint32_t max_ops = seq_ops > WAVESHARE_SD_BENCH_RANDOM_OPS ? seq_ops : WAVESHARE_SD_BENCH_RANDOM_OPS;
+
+    esp_err_t ret = ESP_OK;
+    FILE *f = NULL;
+    int fd = -1;
+    uint8_t *data = heap_caps_aligned_alloc(WAVESHARE_SD_IO_BUFFER_ALIGN, chunk, MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+    uint32_t *lat_us = malloc(max_ops * sizeof(uint32_t));
+    ESP_GOTO_ON_FALSE(data != NULL && lat_us != NULL, ESP_ERR_NO_MEM, cleanup, TAG, "Failed to allocate benchmark buffers");
+
+    for (size_t i = 0; i < chunk; i++) {
+        data[i] = (uint8_t)i;
+    }
+
+    ESP_LOGI(TAG, "Benchmark: %zu bytes in %zu byte chunks at %s", total_bytes, chunk, path);
+
+    // Sequential write (the final op includes flush + fsync)
+    f = waveshare_sd_fopen(path, "wb");
+    ESP_GOTO_ON_FALSE(f != NULL, ESP_FAIL, cleanup, TAG, "Failed to create %s", path);
+    int64_t phase_start = esp_timer_get_time();
+    for (uint32_t i = 0; i < seq_ops; i++) {
+        int64_t t0 = esp_timer_get_time();
+        ESP_GOTO_ON_FALSE(fwrite(data, 1, chunk, f) == chunk, ESP_FAIL, cleanup, TAG, "Sequential write failed");
+        if (i == seq_ops - 1) {
+            fflush(f);
+            fsync(fileno(f));
+        }
+        lat_us[i] = (uint32_t)(esp_timer_get_time() - t0);
+    }
+    bench_summarize(lat_us, seq_ops, total_bytes, esp_timer_get_time() - phase_start, &result->seq_write);
+    waveshare_sd_fclose(f);
+    f = NULL;
+
+    // Sequential read
+    f = waveshare_sd_fopen(path, "rb");
+    ESP_GOTO_ON_FALSE(f != NULL, ESP_FAIL, cleanup, TAG, "Failed to open %s", path);
+    phase_start = esp_timer_get_time();
+    for (uint32_t i = 0; i < seq_ops; i++) {
+        int64_t t0 = esp_timer_get_time();
+        ESP_GOTO_ON_FALSE(fread(data, 1, chunk, f) == chunk, ESP_FAIL, cleanup, TAG, "Sequential read failed");
+        lat_us[i] = (uint32_t)(esp_timer_get_time() - t0);
+    }
+    bench_summarize(lat_us, seq_ops, total_bytes, esp_timer_get_time() - phase_start, &result->seq_read);
+    waveshare_sd_fclose(f);
+    f = NULL;
+
+    // Small random writes, each made durable (like config/scene updates)
+    fd = open(path, O_RDWR);
+    ESP_GOTO_ON_FALSE(fd >= 0, ESP_FAIL, cleanup, TAG, "Failed to open %s", path);
+    uint32_t slots = total_bytes / WAVESHARE_SD_BENCH_RANDOM_SIZE;
+    uint32_t seed = 0x12345678;
+    phase_start = esp_timer_get_time();
+    for (uint32_t i = 0; i < WAVESHARE_SD_BENCH_RANDOM_OPS; i++) {
+        seed = seed * 1664525 + 1013904223;  // LCG, deterministic across runs
+        off_t offset = (off_t)(seed % slots) * WAVESHARE_SD_BENCH_RANDOM_SIZE;
+        int64_t t0 = esp_timer_get_time();
+        ESP_GOTO_ON_FALSE(lseek(fd, offset, SEEK_SET) == offset &&
+                          write(fd, data, WAVESHARE_SD_BENCH_RANDOM_SIZE) == WAVESHARE_SD_BENCH_RANDOM_SIZE &&
+                          fsync(fd) == 0,
+                          ESP_FAIL, cleanup, TAG, "Random write failed");
+        lat_us[i] = (uint32_t)(esp_timer_get_time() - t0);
+    }
+    bench_summarize(lat_us, WAVESHARE_SD_BENCH_RANDOM_OPS,
+                    (size_t)WAVESHARE_SD_BENCH_RANDOM_OPS * WAVESHARE_SD_BENCH_RANDOM_SIZE,
+                    esp_timer_get_time() - phase_start, &result->random_write);
+
+cleanup:
+    if (fd >= 0) {
+        close(fd);
+    }
+    if (f != NULL) {
+        waveshare_sd_fclose(f);
+    }
+    unlink(path);
+    heap_caps_free(data);
+    free(lat_us);
+    return ret;
+}
+
+void waveshare_sd_benchmark_log(const waveshare_sd_bench_result_t *result)
+{
+    if (result == NULL) {
+        return;
+    }
+
+    const struct {
+        const char *name;
+        const waveshare_sd_bench_phase_t *phase;
+    } phases[] = {
+        { "seq write", &result->seq_write },
+        { "seq read", &result->seq_read },
+        { "rand write", &result->random_write },
+    };
+
+    for (size_t i = 0; i < sizeof(phases) / sizeof(phases[0]); i++) {
+        const waveshare_sd_bench_phase_t *p = phases[i].phase;
+        ESP_LOGI(TAG, "%-10s: %6lu KB/s, %4lu ops, p50=%lu us p90=%lu us p99=%lu us max=%lu us",
+                 phases[i].name, (unsigned long)p->kbytes_per_sec, (unsigned long)p->ops,
+                 (unsigned long)p->p50_us, (unsigned long)p->p90_us,
+                 (unsigned long)p->p99_us, (unsigned long)p->max_us);
+    }
+}
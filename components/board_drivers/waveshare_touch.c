@@ -88,7 +88,7 @@ esp_err_t waveshare_touch_init(const waveshare_touch_config_t *config, esp_lcd_t
         .x_max = config->h_res,
         .y_max = config->v_res,
         .rst_gpio_num = -1,     // Reset handled via CH422G
-        .int_gpio_num = -1,     // Interrupt not used (polling)
+        .int_gpio_num = config->use_interrupt ? TOUCH_GPIO4 : -1,  // Input, falling edge
         .levels = {
             .reset = 0,
             .interrupt = 0,
@@ -105,7 +105,8 @@ esp_err_t waveshare_touch_init(const waveshare_touch_config_t *config, esp_lcd_t
         TAG, "Failed to create GT911 touch controller"
     );
 
-    ESP_LOGI(TAG, "GT911 touch controller initialized (%dx%d)", config->h_res, config->v_res);
+    ESP_LOGI(TAG, "GT911 touch controller initialized (%dx%d, %s)", config->h_res, config->v_res,
+             config->use_interrupt ? "interrupt" : "polled");
     return ESP_OK;
 }
 
@@ -93,8 +93,11 @@
 #define LV_SPRINTF_CUSTOM 0
 #define LV_USE_USER_DATA 1
 #define LV_ENABLE_GC 0
+#define LV_USE_SNAPSHOT 1
 
 /* Tick settings */
-#define LV_TICK_CUSTOM 0
+#define LV_TICK_CUSTOM 1
+#define LV_TICK_CUSTOM_INCLUDE "esp_timer.h"
+#define LV_TICK_CUSTOM_SYS_TIME_EXPR (esp_timer_get_time() / 1000LL)
 
 #endif /* LV_CONF_H */
@@ -0,0 +1,132 @@
+/**
+ * @file boot_timeline.c
+ * @brief Boot phase timestamps and dependencies implementation
+ * 
+ * Each phase has one bit in an event group, set when the phase ends.
+ * Times are esp_timer microseconds, which count from early start-up, so
+ * they are comparable with the "ms after boot" log lines.
+ */
+
+#include "boot_timeline.h"
+
+#include <stdio.h>
+#include <string.h>
+#include "freertos/task.h"
+#include "freertos/event_groups.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+
+static const char *TAG = "boot";
+
+/**
+ * @brief Timestamps of one phase
+ */
+typedef struct {
+    int64_t start_us;
+    int64_t end_us;
+    esp_err_t result;
+    char task[configMAX_TASK_NAME_LEN];
+    int8_t core;
+    bool started;
+    bool ended;
+} boot_phase_record_t;
+
+static const char *const s_phase_names[BOOT_PHASE_COUNT] = {
+    [BOOT_PHASE_STORAGE]      = "storage",
+    [BOOT_PHASE_HARDWARE]     = "hardware",
+    [BOOT_PHASE_SD_SYNC]      = "sd sync",
+    [BOOT_PHASE_SPLASH]       = "splash",
+    [BOOT_PHASE_SPLASH_CACHE] = "splash cache",
+    [BOOT_PHASE_LCC]          = "lcc",
+    [BOOT_PHASE_POWER]        = "power",
+    [BOOT_PHASE_LVGL]         = "lvgl",
+    [BOOT_PHASE_SCENES]       = "scenes",
+    [BOOT_PHASE_UI]           = "ui",
+};
+
+static struct {
+    boot_phase_record_t phases[BOOT_PHASE_COUNT];
+    int64_t interactive_us;
+    EventGroupHandle_t done;
+    StaticEventGroup_t done_buf;
+    portMUX_TYPE lock;
+} s_boot = {
+    .lock = portMUX_INITIALIZER_UNLOCKED,
+};
+
+esp_err_t boot_timeline_init(void)
+{
+    s_boot.done = xEventGroupCreateStatic(&s_boot.done_buf);
+    return s_boot.done ? ESP_OK : ESP_FAIL;
+}
+
+void boot_phase_begin(boot_phase_t phase)
+{
+    boot_phase_record_t *rec = &s_boot.phases[phase];
+    const char *task = pcTaskGetName(NULL);
+    
+    portENTER_CRITICAL(&s_boot.lock);
+    rec->start_us = esp_timer_get_time();
+    rec->core = (int8_t)xPortGetCoreID();
+    rec->started = true;
+    strlcpy(rec->task, task, sizeof(rec->task));
+    portEXIT_CRITICAL(&s_boot.lock);
+}
+
+void boot_phase_end(boot_phase_t phase, esp_err_t result)
+{
+    boot_phase_record_t *rec = &s_boot.phases[phase];
+    
+    portENTER_CRITICAL(&s_boot.lock);
+    rec->end_us = esp_timer_get_time();
+    rec->result = result;
+    rec->ended = true;
+    portEXIT_CRITICAL(&s_boot.lock);
+    
+    ESP_LOGI(TAG, "%s: %lld ms%s", s_phase_names[phase], (rec->end_us - rec->start_us) / 1000,
+             result == ESP_OK ? "" : " (failed)");
+    xEventGroupSetBits(s_boot.done, BIT(phase));
+}
+
+esp_err_t boot_phase_wait(boot_phase_t phase)
+{
+    xEventGroupWaitBits(s_boot.done, BIT(phase), pdFALSE, pdTRUE, portMAX_DELAY);
+    return s_boot.phases[phase].result;
+}
+
+void boot_timeline_mark_interactive(void)
+{
+    s_boot.interactive_us = esp_timer_get_time();
+}
+
+void boot_timeline_report(void)
+{
+    boot_phase_record_t phases[BOOT_PHASE_COUNT];
+    portENTER_CRITICAL(&s_boot.lock);
+    memcpy(phases, s_boot.phases, sizeof(phases));
+    portEXIT_CRITICAL(&s_boot.lock);
+    
+    printf("Boot timeline (ms since boot):\n");
+    printf("  %-13s %-16s %4s %7s %7s %7s  %s\n", "phase", "task", "core", "start", "end", "took", "result");
+    for (int i = 0; i < BOOT_PHASE_COUNT; i++) {
+        const boot_phase_record_t *rec = &phases[i];
+        if (!rec->started) {
+            printf("  %-13s (not run)\n", s_phase_names[i]);
+            continue;
+        }
+        if (!rec->ended) {
+            printf("  %-13s %-16s %4d %7lld %7s %7s  running\n", s_phase_names[i], rec->task, rec->core,
+                   rec->start_us / 1000, "-", "-");
+            continue;
+        }
+        printf("  %-13s %-16s %4d %7lld %7lld %7lld  %s\n", s_phase_names[i], rec->task, rec->core,
+               rec->start_us / 1000, rec->end_us / 1000, (rec->end_us - rec->start_us) / 1000,
+               esp_err_to_name(rec->result));
+    }
+    
+    if (s_boot.interactive_us > 0) {
+        printf("  Interactive at %lld ms\n", s_boot.interactive_us / 1000);
+    } else {
+        printf("  Not interactive yet\n");
+    }
+}
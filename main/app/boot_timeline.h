@@ -0,0 +1,85 @@
+/**
+ * @file boot_timeline.h
+ * @brief Boot phase timestamps and dependencies
+ * 
+ * app_main() runs independent parts of start-up in parallel: the splash
+ * on the main task, LCC initialization on one boot task and LVGL, scene
+ * loading and the main screen on another. Each phase is bracketed with
+ * boot_phase_begin() and boot_phase_end(); a phase that depends on another
+ * waits for it with boot_phase_wait(). boot_timeline_report() prints when
+ * and where each phase ran, and the `boot` console command prints it again
+ * later.
+ * 
+ * @see docs/ARCHITECTURE.md Boot Sequence
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Boot phases, in report order
+ */
+typedef enum {
+    BOOT_PHASE_STORAGE = 0,   ///< NVS and flash store mapping
+    BOOT_PHASE_HARDWARE,      ///< I2C, IO expander, LCD, touch and SD card
+    BOOT_PHASE_SD_SYNC,       ///< Flash store import/export, default scenes
+    BOOT_PHASE_SPLASH,        ///< Splash image from the cache or the JPEG
+    BOOT_PHASE_SPLASH_CACHE,  ///< Splash cache write (first boot with an image)
+    BOOT_PHASE_LCC,           ///< OpenMRN node and TWAI
+    BOOT_PHASE_POWER,         ///< Power management and screen timeout
+    BOOT_PHASE_LVGL,          ///< LVGL, draw self-checks, JSON arena, SD worker
+    BOOT_PHASE_SCENES,        ///< Scene store load
+    BOOT_PHASE_UI,            ///< Main screen construction
+    BOOT_PHASE_COUNT,
+} boot_phase_t;
+
+/**
+ * @brief Start the timeline; call first in app_main()
+ * 
+ * @return esp_err_t ESP_OK on success
+ */
+esp_err_t boot_timeline_init(void);
+
+/**
+ * @brief Record the start of a phase on the calling task
+ */
+void boot_phase_begin(boot_phase_t phase);
+
+/**
+ * @brief Record the end of a phase and release tasks waiting for it
+ * 
+ * @param phase Phase that finished
+ * @param result Outcome; a failed phase still ends, so waits never hang
+ */
+void boot_phase_end(boot_phase_t phase, esp_err_t result);
+
+/**
+ * @brief Wait for a phase to end
+ * 
+ * @param phase Phase to wait for
+ * @return esp_err_t The result the phase ended with
+ */
+esp_err_t boot_phase_wait(boot_phase_t phase);
+
+/**
+ * @brief Record that the UI is on screen and accepting touches
+ */
+void boot_timeline_mark_interactive(void);
+
+/**
+ * @brief Print the boot timeline to stdout
+ * 
+ * One line per phase with its task, core, start and end time since boot
+ * and result, then the time to the interactive UI.
+ */
+void boot_timeline_report(void);
+
+#ifdef __cplusplus
+}
+#endif
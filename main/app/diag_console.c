@@ -0,0 +1,137 @@
+/**
+ * @file diag_console.c
+ * @brief Diagnostic command console on the USB serial port
+ */
+
+#include "diag_console.h"
+#include "boot_timeline.h"
+#include "power_save.h"
+#include "screen_timeout.h"
+#include "ui_common.h"
+
+#include <stdint.h>
+#include <string.h>
+#include "esp_console.h"
+#include "esp_check.h"
+#include "esp_log.h"
+
+static const char *TAG = "diag_console";
+
+/**
+ * @brief Show or hide the perf overlay (LVGL context, via ui_post())
+ */
+static void overlay_cmd(void *arg)
+{
+    ui_perf_set_overlay_visible((bool)(uintptr_t)arg);
+}
+
+/**
+ * @brief Turn the PIE fill kernels on or off (LVGL context, via ui_post())
+ */
+static void pie_cmd(void *arg)
+{
+    ui_draw_set_pie_enabled((bool)(uintptr_t)arg);
+}
+
+/**
+ * @brief perf - dump or reset render pipeline statistics, toggle the overlay
+ */
+static int cmd_perf(int argc, char **argv)
+{
+    if (argc == 1) {
+        ui_perf_dump();
+        return 0;
+    }
+    
+    if (strcmp(argv[1], "reset") == 0) {
+        ui_perf_reset();
+        printf("Render statistics cleared\n");
+        return 0;
+    }
+    
+    if (strcmp(argv[1], "overlay") == 0 && argc == 3) {
+        bool visible = (strcmp(argv[2], "on") == 0);
+        ui_post(overlay_cmd, (void *)(uintptr_t)visible);
+        return 0;
+    }
+    
+    if (strcmp(argv[1], "pie") == 0 && argc == 3) {
+        bool enabled = (strcmp(argv[2], "on") == 0);
+        ui_post(pie_cmd, (void *)(uintptr_t)enabled);
+        return 0;
+    }
+    
+    printf("Usage: perf [reset|overlay on|overlay off|pie on|pie off]\n");
+    return 1;
+}
+
+/**
+ * @brief power - power saving statistics, or switch the screen off now
+ */
+static int cmd_power(int argc, char **argv)
+{
+    if (argc == 1) {
+        power_save_dump();
+        return 0;
+    }
+    
+    if (strcmp(argv[1], "off") == 0) {
+        if (screen_timeout_get_duration() == 0) {
+            printf("Screen timeout is disabled; set it in the LCC configuration\n");
+            return 1;
+        }
+        screen_timeout_sleep();
+        printf("Screen turning off; touch to wake\n");
+        return 0;
+    }
+    
+    printf("Usage: power [off]\n");
+    return 1;
+}
+
+/**
+ * @brief boot - boot phase timeline
+ */
+static int cmd_boot(int argc, char **argv)
+{
+    boot_timeline_report();
+    return 0;
+}
+
+esp_err_t diag_console_start(void)
+{
+    esp_console_repl_t *repl = NULL;
+    esp_console_repl_config_t repl_config = ESP_CONSOLE_REPL_CONFIG_DEFAULT();
+    repl_config.prompt = "lcc>";
+    
+    esp_console_dev_usb_serial_jtag_config_t dev_config = ESP_CONSOLE_DEV_USB_SERIAL_JTAG_CONFIG_DEFAULT();
+    ESP_RETURN_ON_ERROR(esp_console_new_repl_usb_serial_jtag(&dev_config, &repl_config, &repl),
+                        TAG, "Failed to create console");
+    
+    ESP_RETURN_ON_ERROR(esp_console_register_help_command(), TAG, "Failed to register help");
+    
+    const esp_console_cmd_t perf_cmd = {
+        .command = "perf",
+        .help = "Render pipeline histograms: perf [reset|overlay on|overlay off|pie on|pie off]",
+        .func = cmd_perf,
+    };
+    ESP_RETURN_ON_ERROR(esp_console_cmd_register(&perf_cmd), TAG, "Failed to register perf");
+    
+    const esp_console_cmd_t power_cmd = {
+        .command = "power",
+        .help = "Screen-off power saving and wake latency: power [off]",
+        .func = cmd_power,
+    };
+    ESP_RETURN_ON_ERROR(esp_console_cmd_register(&power_cmd), TAG, "Failed to register power");
+    
+    const esp_console_cmd_t boot_cmd = {
+        .command = "boot",
+        .help = "Boot phase timeline: when and on which task each phase ran",
+        .func = cmd_boot,
+    };
+    ESP_RETURN_ON_ERROR(esp_console_cmd_register(&boot_cmd), TAG, "Failed to register boot");
+    
+    ESP_RETURN_ON_ERROR(esp_console_start_repl(repl), TAG, "Failed to start console");
+    ESP_LOGI(TAG, "Diagnostic console started (type 'help')");
+    return ESP_OK;
+}
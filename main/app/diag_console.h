@@ -0,0 +1,33 @@
+/**
+ * @file diag_console.h
+ * @brief Diagnostic command console on the USB serial port
+ * 
+ * Runs an esp_console REPL on the USB Serial/JTAG console so diagnostics
+ * can be dumped on demand instead of being logged continuously.
+ * 
+ * Commands:
+ * - perf [reset|overlay on|overlay off|pie on|pie off]: render pipeline histograms
+ * - power [off]: screen-off power saving and wake latency
+ * - boot: boot phase timeline
+ */
+
+#pragma once
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Register the diagnostic commands and start the console REPL
+ * 
+ * Call after ui_init(); the console runs in its own task.
+ * 
+ * @return esp_err_t ESP_OK on success
+ */
+esp_err_t diag_console_start(void);
+
+#ifdef __cplusplus
+}
+#endif
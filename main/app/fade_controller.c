@@ -5,12 +5,18 @@
  * Sends lighting scene parameters and transition duration to LED controllers.
  * LED controllers perform local high-fidelity fading. For long fades (>255s),
  * automatically segments into multiple command sets with intermediate targets.
+ * Live preview targets from slider drags are coalesced and sent from the tick
+ * at a bounded rate.
+ * 
+ * Every change to the current values or the running fade is saved to the
+ * warm restart record, so a reset can pick the fade up where it was.
  * 
  * @see docs/ARCHITECTURE.md §6 for Fade Algorithm specification
  */
 
 #include "fade_controller.h"
 #include "lcc_node.h"
+#include "warm_restart.h"
 
 #include <string.h>
 #include <math.h>
@@ -24,6 +30,9 @@ static const char *TAG = "fade_ctrl";
 /// Maximum duration that can be sent in a single command (255 seconds)
 #define MAX_SEGMENT_DURATION_SEC  255
 
+/// Minimum spacing between live preview commands
+#define LIVE_INTERVAL_US  ((int64_t)CONFIG_LIVE_PREVIEW_INTERVAL_MS * 1000)
+
 /**
  * @brief Internal fade state
  */
@@ -55,6 +64,22 @@ typedef struct {
 
 static fade_state_internal_t s_fade = {0};
 
+/**
+ * @brief Live preview mailbox
+ * 
+ * Written by the UI on slider drags, drained by fade_controller_tick() on
+ * the lighting task, so only one task ever transmits live commands.
+ */
+static struct {
+    portMUX_TYPE lock;
+    lighting_state_t target;            // Latest slider values
+    bool pending;                       // Target not yet sent
+    bool commit;                        // Send all parameters (slider released)
+    int64_t last_send_us;               // Lighting task only
+} s_live = {
+    .lock = portMUX_INITIALIZER_UNLOCKED,
+};
+
 /**
  * @brief Get parameter value from lighting_state_t by index
  */
@@ -71,6 +96,36 @@ static void interpolate_state(const lighting_state_t *start, const lighting_stat
     result->brightness = start->brightness + (int16_t)(end->brightness - start->brightness) * progress;
 }
 
+/**
+ * @brief Number of segments needed for a fade of @p duration_ms
+ */
+static int segment_count(uint32_t duration_ms)
+{
+    if (duration_ms == 0) {
+        return 1;
+    }
+    return (duration_ms + (MAX_SEGMENT_DURATION_SEC * 1000 - 1)) / (MAX_SEGMENT_DURATION_SEC * 1000);
+}
+
+/**
+ * @brief Save the current values and the running fade for a warm restart
+ */
+static void save_warm_state(void)
+{
+    if (s_fade.state != FADE_STATE_FADING) {
+        warm_restart_save_lighting(&s_fade.current, NULL, 0);
+        return;
+    }
+    
+    fade_plan_t plan = {
+        .start = s_fade.original_start,
+        .target = s_fade.final_target,
+        .duration_ms = s_fade.total_duration_ms,
+    };
+    int64_t elapsed_us = esp_timer_get_time() - s_fade.fade_start_us;
+    warm_restart_save_lighting(&s_fade.current, &plan, (uint32_t)(elapsed_us / 1000));
+}
+
 /**
  * @brief Send all 6 LCC events (RGBW + Brightness + Duration)
  */
@@ -105,6 +160,90 @@ static esp_err_t send_lighting_command(const lighting_state_t *target, uint8_t d
     return ESP_OK;
 }
 
+/**
+ * @brief Send a live preview target
+ * 
+ * Partial updates send only the parameters that differ from the last
+ * command; the zero duration then applies them on the receivers.
+ */
+static esp_err_t send_live_command(const lighting_state_t *target, bool full)
+{
+    static const light_param_t params[] = {
+        LIGHT_PARAM_RED, LIGHT_PARAM_GREEN, LIGHT_PARAM_BLUE,
+        LIGHT_PARAM_WHITE, LIGHT_PARAM_BRIGHTNESS
+    };
+    const uint8_t next[] = { target->red, target->green, target->blue,
+                             target->white, target->brightness };
+    const uint8_t last[] = { s_fade.current.red, s_fade.current.green, s_fade.current.blue,
+                             s_fade.current.white, s_fade.current.brightness };
+    int sent = 0;
+    
+    for (size_t i = 0; i < sizeof(params) / sizeof(params[0]); i++) {
+        if (full || next[i] != last[i]) {
+            esp_err_t ret = lcc_node_send_lighting_event(params[i], next[i]);
+            if (ret != ESP_OK) return ret;
+            sent++;
+        }
+    }
+    
+    if (sent == 0) {
+        return ESP_OK;
+    }
+    
+    esp_err_t ret = lcc_node_send_lighting_event(LIGHT_PARAM_DURATION, 0);
+    if (ret != ESP_OK) return ret;
+    
+    ESP_LOGD(TAG, "Live (%d param%s): R=%d G=%d B=%d W=%d Br=%d",
+             sent, sent > 1 ? "s" : "", target->red, target->green,
+             target->blue, target->white, target->brightness);
+    
+    return ESP_OK;
+}
+
+/**
+ * @brief Send the pending live target once the interval has elapsed
+ */
+static void process_live_update(void)
+{
+    int64_t now_us = esp_timer_get_time();
+    lighting_state_t target;
+    bool full = false;
+    bool due = false;
+    
+    portENTER_CRITICAL(&s_live.lock);
+    if (s_live.commit || (s_live.pending && now_us - s_live.last_send_us >= LIVE_INTERVAL_US)) {
+        target = s_live.target;
+        full = s_live.commit;
+        s_live.pending = false;
+        s_live.commit = false;
+        due = true;
+    }
+    portEXIT_CRITICAL(&s_live.lock);
+    
+    if (!due) {
+        return;
+    }
+    
+    // Live values replace whatever the receivers were fading to
+    if (s_fade.state == FADE_STATE_FADING) {
+        ESP_LOGD(TAG, "Fade superseded by live preview");
+        s_fade.state = FADE_STATE_IDLE;
+    }
+    
+    s_live.last_send_us = now_us;
+    esp_err_t ret = send_live_command(&target, full);
+    if (ret != ESP_OK) {
+        if (full) {
+            ESP_LOGW(TAG, "Failed to send live preview: %s", esp_err_to_name(ret));
+        }
+        return;
+    }
+    
+    s_fade.final_target = target;
+    s_fade.current = target;
+    save_warm_state();
+}
+
 /**
  * @brief Start the next segment of a multi-segment fade
  * 
@@ -171,18 +310,19 @@ esp_err_t fade_controller_start(const fade_params_t *params)
         return ESP_ERR_INVALID_ARG;
     }
     
+    // An explicit command replaces any live preview still waiting to go out
+    portENTER_CRITICAL(&s_live.lock);
+    s_live.pending = false;
+    s_live.commit = false;
+    portEXIT_CRITICAL(&s_live.lock);
+    
     // Store original start (current LED state) and final target
     s_fade.original_start = s_fade.current;
     s_fade.final_target = params->target;
     s_fade.total_duration_ms = params->duration_ms;
     
     // Calculate number of segments needed
-    if (params->duration_ms == 0) {
-        s_fade.total_segments = 1;
-    } else {
-        s_fade.total_segments = (params->duration_ms + (MAX_SEGMENT_DURATION_SEC * 1000 - 1)) /
-                                 (MAX_SEGMENT_DURATION_SEC * 1000);
-    }
+    s_fade.total_segments = segment_count(params->duration_ms);
     
     s_fade.current_segment = -1;  // Will be incremented to 0 in start_next_segment
     s_fade.fade_start_us = esp_timer_get_time();
@@ -203,6 +343,7 @@ esp_err_t fade_controller_start(const fade_params_t *params)
     
     // Update current to target (LED controllers are now fading to this)
     s_fade.current = s_fade.segment_target;
+    save_warm_state();
     
     return ESP_OK;
 }
@@ -221,12 +362,43 @@ esp_err_t fade_controller_apply_immediate(const lighting_state_t *state)
     return fade_controller_start(&params);
 }
 
+esp_err_t fade_controller_live_update(const lighting_state_t *state)
+{
+    if (!state) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    portENTER_CRITICAL(&s_live.lock);
+    s_live.target = *state;
+    s_live.pending = true;
+    portEXIT_CRITICAL(&s_live.lock);
+    
+    return ESP_OK;
+}
+
+esp_err_t fade_controller_live_commit(const lighting_state_t *state)
+{
+    if (!state) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    portENTER_CRITICAL(&s_live.lock);
+    s_live.target = *state;
+    s_live.pending = false;
+    s_live.commit = true;
+    portEXIT_CRITICAL(&s_live.lock);
+    
+    return ESP_OK;
+}
+
 esp_err_t fade_controller_tick(void)
 {
     if (!s_fade.initialized) {
         return ESP_ERR_NOT_FOUND;
     }
     
+    process_live_update();
+    
     if (s_fade.state == FADE_STATE_IDLE) {
         return ESP_OK;
     }
@@ -256,6 +428,7 @@ esp_err_t fade_controller_tick(void)
         if (s_fade.state == FADE_STATE_FADING) {
             s_fade.current = s_fade.segment_target;
         }
+        save_warm_state();
     }
     
     return ESP_OK;
@@ -307,6 +480,30 @@ bool fade_controller_is_active(void)
     return s_fade.initialized && s_fade.state == FADE_STATE_FADING;
 }
 
+uint32_t fade_controller_get_next_due_ms(void)
+{
+    if (!s_fade.initialized) {
+        return UINT32_MAX;
+    }
+    
+    portENTER_CRITICAL(&s_live.lock);
+    bool live = s_live.pending || s_live.commit;
+    portEXIT_CRITICAL(&s_live.lock);
+    
+    if (live || s_fade.state == FADE_STATE_COMPLETE) {
+        return 0;
+    }
+    if (s_fade.state != FADE_STATE_FADING) {
+        return UINT32_MAX;
+    }
+    
+    int64_t elapsed_ms = (esp_timer_get_time() - s_fade.segment_start_us) / 1000;
+    if (elapsed_ms >= s_fade.segment_duration_ms) {
+        return 0;
+    }
+    return s_fade.segment_duration_ms - (uint32_t)elapsed_ms;
+}
+
 void fade_controller_abort(void)
 {
     if (!s_fade.initialized) {
@@ -320,6 +517,7 @@ void fade_controller_abort(void)
     }
     
     s_fade.state = FADE_STATE_IDLE;
+    save_warm_state();
 }
 
 esp_err_t fade_controller_get_current(lighting_state_t *state)
@@ -347,9 +545,81 @@ esp_err_t fade_controller_set_current(const lighting_state_t *state)
     }
     
     s_fade.current = *state;
+    save_warm_state();
     
     ESP_LOGI(TAG, "Current state set: B=%d R=%d G=%d B=%d W=%d",
              state->brightness, state->red, state->green, state->blue, state->white);
     
     return ESP_OK;
 }
+
+esp_err_t fade_controller_resume(const lighting_state_t *current, const fade_plan_t *plan,
+                                 uint32_t elapsed_ms)
+{
+    if (!s_fade.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    if (!current) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    s_fade.current = *current;
+    s_fade.state = FADE_STATE_IDLE;
+    if (!plan) {
+        save_warm_state();
+        ESP_LOGI(TAG, "Resumed: B=%d R=%d G=%d B=%d W=%d", current->brightness,
+                 current->red, current->green, current->blue, current->white);
+        return ESP_OK;
+    }
+    
+    if (elapsed_ms >= plan->duration_ms) {
+        // Finished during the restart; a long fade may still be short of
+        // its last segment, so send the target itself
+        ESP_LOGI(TAG, "Resumed fade already finished - applying its target");
+        return fade_controller_apply_immediate(&plan->target);
+    }
+    
+    s_fade.original_start = plan->start;
+    s_fade.final_target = plan->target;
+    s_fade.total_duration_ms = plan->duration_ms;
+    s_fade.total_segments = segment_count(plan->duration_ms);
+    
+    // Segments are equal (see start_next_segment), so the receivers are
+    // in segment elapsed / segment_ms, fading to its end point
+    uint32_t segment_ms = plan->duration_ms / s_fade.total_segments;
+    s_fade.current_segment = elapsed_ms / segment_ms;
+    if (s_fade.current_segment >= s_fade.total_segments) {
+        s_fade.current_segment = s_fade.total_segments - 1;
+    }
+    int64_t segment_left_ms = (int64_t)(s_fade.current_segment + 1) * segment_ms - elapsed_ms;
+    s_fade.segment_duration_ms = segment_left_ms > 0 ? (uint32_t)segment_left_ms : 0;
+    
+    float segment_end_progress = (float)(s_fade.current_segment + 1) / (float)s_fade.total_segments;
+    interpolate_state(&s_fade.original_start, &s_fade.final_target,
+                      segment_end_progress, &s_fade.segment_target);
+    
+    // Backdate the start so progress counts the time before the restart
+    int64_t now_us = esp_timer_get_time();
+    s_fade.fade_start_us = now_us - (int64_t)elapsed_ms * 1000;
+    s_fade.segment_start_us = now_us;
+    s_fade.state = FADE_STATE_FADING;
+    
+    ESP_LOGI(TAG, "Resuming fade at %lu/%lums (segment %d/%d, %lums left in it)",
+             (unsigned long)elapsed_ms, (unsigned long)plan->duration_ms,
+             s_fade.current_segment + 1, s_fade.total_segments,
+             (unsigned long)s_fade.segment_duration_ms);
+    
+    esp_err_t ret = send_lighting_command(&s_fade.segment_target,
+                                          (uint8_t)(s_fade.segment_duration_ms / 1000));
+    if (ret != ESP_OK) {
+        s_fade.state = FADE_STATE_IDLE;
+        save_warm_state();
+        return ret;
+    }
+    
+    s_fade.current = s_fade.segment_target;
+    save_warm_state();
+    
+    return ESP_OK;
+}
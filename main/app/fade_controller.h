@@ -63,6 +63,15 @@ typedef struct {
     uint32_t duration_ms;       ///< Fade duration in milliseconds (0 = instant)
 } fade_params_t;
 
+/**
+ * @brief A fade as it was started (saved for a warm restart)
+ */
+typedef struct {
+    lighting_state_t start;     ///< Lighting state the fade started from
+    lighting_state_t target;    ///< Final target lighting state
+    uint32_t duration_ms;       ///< Total fade duration (all segments)
+} fade_plan_t;
+
 /**
  * @brief Fade progress information (for UI progress bar)
  */
@@ -105,12 +114,39 @@ esp_err_t fade_controller_start(const fade_params_t *params);
  */
 esp_err_t fade_controller_apply_immediate(const lighting_state_t *state);
 
+/**
+ * @brief Queue a live preview target while a slider is being dragged
+ * 
+ * Only the latest target is kept; fade_controller_tick() sends it at most
+ * once every CONFIG_LIVE_PREVIEW_INTERVAL_MS, so intermediate positions
+ * are dropped rather than queued on the bus. Each send transmits only the
+ * parameters that changed since the last command, followed by a zero
+ * duration. Any active fade is superseded.
+ * 
+ * @param state Target lighting state
+ * @return ESP_OK on success, ESP_ERR_INVALID_ARG if state is NULL
+ */
+esp_err_t fade_controller_live_update(const lighting_state_t *state);
+
+/**
+ * @brief Finish a live preview drag with an exact final command
+ * 
+ * Replaces any pending live target and sends all 5 parameters on the
+ * next tick, so receivers end on the released slider values even if they
+ * missed an earlier partial update.
+ * 
+ * @param state Final lighting state
+ * @return ESP_OK on success, ESP_ERR_INVALID_ARG if state is NULL
+ */
+esp_err_t fade_controller_live_commit(const lighting_state_t *state);
+
 /**
  * @brief Process fade controller tick
  * 
  * Must be called periodically (recommended: every 100ms) to:
  * - Track elapsed time for progress bar display
  * - Send next segment commands for long fades (>255 seconds)
+ * - Send pending live preview targets
  * - Transition to COMPLETE state when fade finishes
  * 
  * Note: Unlike previous implementation, this does NOT send continuous
@@ -135,6 +171,17 @@ fade_state_t fade_controller_get_progress(fade_progress_t *progress);
  */
 bool fade_controller_is_active(void);
 
+/**
+ * @brief Time until fade_controller_tick() next has work
+ * 
+ * Lets the lighting task sleep between fade segments while the screen is
+ * off and no slider can queue live updates.
+ * 
+ * @return 0 if a live command is waiting or a segment is due, the time left
+ *         in the current fade segment, or UINT32_MAX when idle
+ */
+uint32_t fade_controller_get_next_due_ms(void);
+
 /**
  * @brief Abort any active fade
  * 
@@ -164,6 +211,24 @@ esp_err_t fade_controller_get_current(lighting_state_t *state);
  */
 esp_err_t fade_controller_set_current(const lighting_state_t *state);
 
+/**
+ * @brief Pick up the lighting state after a warm restart
+ * 
+ * With no fade, only sets the current state. With a fade still running,
+ * resends the segment the receivers are in with the time left in it, so
+ * they carry on towards the same point at the same rate, and the
+ * remaining segments and the progress bar follow the original plan. A
+ * fade that should have finished during the restart ends on its target
+ * immediately.
+ * 
+ * @param current Lighting state last sent before the restart
+ * @param plan Fade that was running, or NULL
+ * @param elapsed_ms Time since that fade started (UINT32_MAX if unknown)
+ * @return ESP_OK on success, or the error from sending the command
+ */
+esp_err_t fade_controller_resume(const lighting_state_t *current, const fade_plan_t *plan,
+                                 uint32_t elapsed_ms);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,690 @@
+/**
+ * @file flash_store.c
+ * @brief Internal flash store implementation
+ */
+
+#include "flash_store.h"
+#include "waveshare_sd.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_partition.h"
+#include "esp_vfs.h"
+#include "esp_rom_crc.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "esp_check.h"
+
+static const char *TAG = "flash_store";
+
+#define FLASH_STORE_MAGIC       0x5453434CUL    // "LCST"
+#define FLASH_STORE_MAX_FDS     8
+
+/**
+ * @brief Header at the start of each slot, written last to commit the slot
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t seq;       ///< Incremented on every write; highest valid slot wins
+    uint32_t length;    ///< Data length in bytes
+    uint32_t crc;       ///< CRC32 of the data
+} slot_header_t;
+
+/**
+ * @brief Record file names and slot sizes (each record has two slots)
+ */
+static const struct {
+    const char *name;
+    size_t slot_size;
+} s_layout[FLASH_STORE_RECORD_COUNT] = {
+    [FLASH_STORE_NODE_ID]    = { "nodeid.txt",     4096 },
+    [FLASH_STORE_LCC_CONFIG] = { "openmrn_config", 4096 },
+    [FLASH_STORE_SCENES]     = { "scenes.json",    16384 },
+};
+
+/**
+ * @brief Runtime state of a record
+ */
+typedef struct {
+    size_t slot_offset[2];  ///< Slot offsets within the partition
+    int active;             ///< Slot holding the current copy, -1 if empty
+    uint32_t seq;
+    uint32_t length;
+    uint8_t *shadow;        ///< VFS write buffer, NULL until opened for writing
+    size_t shadow_len;
+    bool dirty;             ///< Shadow differs from flash
+} record_state_t;
+
+/**
+ * @brief Open VFS file
+ */
+typedef struct {
+    bool used;
+    flash_store_record_t record;
+    size_t pos;
+    int flags;
+} vfs_file_t;
+
+static const esp_partition_t *s_partition = NULL;
+static const uint8_t *s_map = NULL;
+static esp_partition_mmap_handle_t s_map_handle;
+static record_state_t s_records[FLASH_STORE_RECORD_COUNT];
+static vfs_file_t s_files[FLASH_STORE_MAX_FDS];
+static SemaphoreHandle_t s_mutex = NULL;
+
+static size_t record_capacity(flash_store_record_t record)
+{
+    return s_layout[record].slot_size - sizeof(slot_header_t);
+}
+
+static const uint8_t *record_data(flash_store_record_t record)
+{
+    const record_state_t *rec = &s_records[record];
+    return s_map + rec->slot_offset[rec->active] + sizeof(slot_header_t);
+}
+
+/**
+ * @brief Check a slot header and CRC through the flash mapping
+ */
+static bool slot_is_valid(flash_store_record_t record, size_t offset, slot_header_t *out)
+{
+    const slot_header_t *hdr = (const slot_header_t *)(s_map + offset);
+    if (hdr->magic != FLASH_STORE_MAGIC || hdr->length > record_capacity(record)) {
+        return false;
+    }
+    
+    uint32_t crc = esp_rom_crc32_le(0, s_map + offset + sizeof(slot_header_t), hdr->length);
+    if (crc != hdr->crc) {
+        ESP_LOGW(TAG, "%s: CRC mismatch in slot at 0x%x", s_layout[record].name, (unsigned)offset);
+        return false;
+    }
+    
+    *out = *hdr;
+    return true;
+}
+
+/**
+ * @brief Write a record to its inactive slot (caller holds s_mutex)
+ */
+static esp_err_t write_locked(flash_store_record_t record, const void *data, size_t len)
+{
+    record_state_t *rec = &s_records[record];
+    ESP_RETURN_ON_FALSE(len <= record_capacity(record), ESP_ERR_INVALID_SIZE, TAG,
+                        "%s: %u bytes exceeds slot capacity %u", s_layout[record].name,
+                        (unsigned)len, (unsigned)record_capacity(record));
+    
+    int64_t start_us = esp_timer_get_time();
+    int target = (rec->active == 0) ? 1 : 0;
+    size_t offset = rec->slot_offset[target];
+    
+    // Erase only the sectors the header and data occupy; bytes past the
+    // length are never read (the CRC and loads stop at the length)
+    size_t erase_size = (sizeof(slot_header_t) + len + s_partition->erase_size - 1) &
+                        ~(s_partition->erase_size - 1);
+    
+    // Erase, write data, then write the header last so a power cut leaves
+    // the previous slot as the newest valid copy
+    ESP_RETURN_ON_ERROR(esp_partition_erase_range(s_partition, offset, erase_size),
+                        TAG, "Erase failed");
+    if (len > 0) {
+        ESP_RETURN_ON_ERROR(esp_partition_write(s_partition, offset + sizeof(slot_header_t), data, len),
+                            TAG, "Data write failed");
+    }
+    
+    slot_header_t hdr = {
+        .magic = FLASH_STORE_MAGIC,
+        .seq = rec->seq + 1,
+        .length = len,
+        .crc = esp_rom_crc32_le(0, data, len),
+    };
+    ESP_RETURN_ON_ERROR(esp_partition_write(s_partition, offset, &hdr, sizeof(hdr)),
+                        TAG, "Header write failed");
+    
+    rec->active = target;
+    rec->seq = hdr.seq;
+    rec->length = len;
+    
+    // Keep an open VFS shadow in step with direct writes
+    if (rec->shadow && data != rec->shadow) {
+        memcpy(rec->shadow, data, len);
+        rec->shadow_len = len;
+        rec->dirty = false;
+    }
+    
+    ESP_LOGD(TAG, "Committed %s (%u bytes, %u erased, seq %lu) in %lld us", s_layout[record].name,
+             (unsigned)len, (unsigned)erase_size, (unsigned long)hdr.seq, esp_timer_get_time() - start_us);
+    return ESP_OK;
+}
+
+// ============================================================================
+// VFS - exposes records as files for fd-based users (OpenMRN config)
+// ============================================================================
+
+static int record_from_path(const char *path)
+{
+    if (path[0] == '/') {
+        path++;
+    }
+    for (int i = 0; i < FLASH_STORE_RECORD_COUNT; i++) {
+        if (strcmp(path, s_layout[i].name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Current contents of a record as seen through the VFS
+ */
+static const uint8_t *vfs_contents(flash_store_record_t record, size_t *len)
+{
+    const record_state_t *rec = &s_records[record];
+    if (rec->shadow) {
+        *len = rec->shadow_len;
+        return rec->shadow;
+    }
+    if (rec->active < 0) {
+        *len = 0;
+        return NULL;
+    }
+    *len = rec->length;
+    return record_data(record);
+}
+
+static bool ensure_shadow(flash_store_record_t record)
+{
+    record_state_t *rec = &s_records[record];
+    if (rec->shadow) {
+        return true;
+    }
+    
+    rec->shadow = malloc(record_capacity(record));
+    if (!rec->shadow) {
+        return false;
+    }
+    rec->shadow_len = 0;
+    if (rec->active >= 0) {
+        memcpy(rec->shadow, record_data(record), rec->length);
+        rec->shadow_len = rec->length;
+    }
+    rec->dirty = false;
+    return true;
+}
+
+static int vfs_open(const char *path, int flags, int mode)
+{
+    int record = record_from_path(path);
+    if (record < 0) {
+        errno = ENOENT;
+        return -1;
+    }
+    
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    record_state_t *rec = &s_records[record];
+    int fd = -1;
+    
+    if (rec->active < 0 && !rec->shadow && !(flags & O_CREAT)) {
+        errno = ENOENT;
+        goto out;
+    }
+    
+    for (int i = 0; i < FLASH_STORE_MAX_FDS; i++) {
+        if (!s_files[i].used) {
+            fd = i;
+            break;
+        }
+    }
+    if (fd < 0) {
+        errno = ENFILE;
+        goto out;
+    }
+    
+    if ((flags & O_ACCMODE) != O_RDONLY || (flags & O_TRUNC)) {
+        if (!ensure_shadow(record)) {
+            errno = ENOMEM;
+            fd = -1;
+            goto out;
+        }
+        if (flags & O_TRUNC) {
+            rec->shadow_len = 0;
+            rec->dirty = true;
+        }
+    }
+    
+    s_files[fd] = (vfs_file_t) {
+        .used = true,
+        .record = record,
+        .pos = 0,
+        .flags = flags,
+    };
+
+out:
+    xSemaphoreGive(s_mutex);
+    return fd;
+}
+
+static ssize_t vfs_read(int fd, void *dst, size_t size)
+{
+    if (fd < 0 || fd >= FLASH_STORE_MAX_FDS || !s_files[fd].used) {
+        errno = EBADF;
+        return -1;
+    }
+    
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    vfs_file_t *file = &s_files[fd];
+    size_t len;
+    const uint8_t *contents = vfs_contents(file->record, &len);
+    size_t n = 0;
+    if (file->pos < len) {
+        n = len - file->pos;
+        if (n > size) {
+            n = size;
+        }
+        memcpy(dst, contents + file->pos, n);
+        file->pos += n;
+    }
+    xSemaphoreGive(s_mutex);
+    return n;
+}
+
+static ssize_t vfs_write(int fd, const void *data, size_t size)
+{
+    if (fd < 0 || fd >= FLASH_STORE_MAX_FDS || !s_files[fd].used ||
+        (s_files[fd].flags & O_ACCMODE) == O_RDONLY) {
+        errno = EBADF;
+        return -1;
+    }
+    
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    vfs_file_t *file = &s_files[fd];
+    record_state_t *rec = &s_records[file->record];
+    size_t capacity = record_capacity(file->record);
+    
+    if (file->flags & O_APPEND) {
+        file->pos = rec->shadow_len;
+    }
+    
+    ssize_t n = -1;
+    if (file->pos >= capacity) {
+        errno = ENOSPC;
+        goto out;
+    }
+    
+    n = (file->pos + size > capacity) ? (ssize_t)(capacity - file->pos) : (ssize_t)size;
+    if (file->pos > rec->shadow_len) {
+        // Writing past the end after a seek - fill the gap
+        memset(rec->shadow + rec->shadow_len, 0, file->pos - rec->shadow_len);
+    }
+    memcpy(rec->shadow + file->pos, data, n);
+    file->pos += n;
+    if (file->pos > rec->shadow_len) {
+        rec->shadow_len = file->pos;
+    }
+    rec->dirty = true;
+
+out:
+    xSemaphoreGive(s_mutex);
+    return n;
+}
+
+static off_t vfs_lseek(int fd, off_t offset, int whence)
+{
+    if (fd < 0 || fd >= FLASH_STORE_MAX_FDS || !s_files[fd].used) {
+        errno = EBADF;
+        return -1;
+    }
+    
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    vfs_file_t *file = &s_files[fd];
+    size_t len;
+    vfs_contents(file->record, &len);
+    
+    off_t base = 0;
+    if (whence == SEEK_CUR) {
+        base = file->pos;
+    } else if (whence == SEEK_END) {
+        base = len;
+    }
+    
+    off_t pos = base + offset;
+    if (whence != SEEK_SET && whence != SEEK_CUR && whence != SEEK_END) {
+        errno = EINVAL;
+        pos = -1;
+    } else if (pos < 0 || (size_t)pos > record_capacity(file->record)) {
+        errno = EINVAL;
+        pos = -1;
+    } else {
+        file->pos = pos;
+    }
+    xSemaphoreGive(s_mutex);
+    return pos;
+}
+
+static int vfs_fstat(int fd, struct stat *st)
+{
+    if (fd < 0 || fd >= FLASH_STORE_MAX_FDS || !s_files[fd].used) {
+        errno = EBADF;
+        return -1;
+    }
+    
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    size_t len;
+    vfs_contents(s_files[fd].record, &len);
+    xSemaphoreGive(s_mutex);
+    
+    memset(st, 0, sizeof(*st));
+    st->st_mode = S_IFREG | 0666;
+    st->st_size = len;
+    return 0;
+}
+
+static int vfs_stat(const char *path, struct stat *st)
+{
+    int record = record_from_path(path);
+    if (record < 0) {
+        errno = ENOENT;
+        return -1;
+    }
+    
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    bool exists = s_records[record].active >= 0 || s_records[record].shadow;
+    size_t len;
+    vfs_contents(record, &len);
+    xSemaphoreGive(s_mutex);
+    
+    if (!exists) {
+        errno = ENOENT;
+        return -1;
+    }
+    memset(st, 0, sizeof(*st));
+    st->st_mode = S_IFREG | 0666;
+    st->st_size = len;
+    return 0;
+}
+
+/**
+ * @brief Commit a dirty shadow to flash (caller holds s_mutex)
+ */
+static int commit_locked(flash_store_record_t record)
+{
+    record_state_t *rec = &s_records[record];
+    if (!rec->dirty) {
+        return 0;
+    }
+    if (write_locked(record, rec->shadow, rec->shadow_len) != ESP_OK) {
+        errno = EIO;
+        return -1;
+    }
+    rec->dirty = false;
+    return 0;
+}
+
+static int vfs_fsync(int fd)
+{
+    if (fd < 0 || fd >= FLASH_STORE_MAX_FDS || !s_files[fd].used) {
+        errno = EBADF;
+        return -1;
+    }
+    
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    int ret = commit_locked(s_files[fd].record);
+    xSemaphoreGive(s_mutex);
+    return ret;
+}
+
+static int vfs_close(int fd)
+{
+    if (fd < 0 || fd >= FLASH_STORE_MAX_FDS || !s_files[fd].used) {
+        errno = EBADF;
+        return -1;
+    }
+    
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    int ret = commit_locked(s_files[fd].record);
+    s_files[fd].used = false;
+    xSemaphoreGive(s_mutex);
+    return ret;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+esp_err_t flash_store_init(void)
+{
+    if (s_map) {
+        return ESP_OK;
+    }
+    
+    int64_t start_us = esp_timer_get_time();
+    
+    s_partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY,
+                                           FLASH_STORE_PARTITION_LABEL);
+    if (!s_partition) {
+        ESP_LOGW(TAG, "No '%s' partition - flash the current partition table", FLASH_STORE_PARTITION_LABEL);
+        return ESP_ERR_NOT_FOUND;
+    }
+    
+    size_t required = 0;
+    for (int i = 0; i < FLASH_STORE_RECORD_COUNT; i++) {
+        required += 2 * s_layout[i].slot_size;
+    }
+    ESP_RETURN_ON_FALSE(s_partition->size >= required, ESP_ERR_INVALID_SIZE, TAG,
+                        "Partition too small (%lu < %u bytes)", (unsigned long)s_partition->size,
+                        (unsigned)required);
+    
+    s_mutex = xSemaphoreCreateMutex();
+    ESP_RETURN_ON_FALSE(s_mutex != NULL, ESP_ERR_NO_MEM, TAG, "Failed to create mutex");
+    
+    const void *map = NULL;
+    esp_err_t ret = esp_partition_mmap(s_partition, 0, s_partition->size, ESP_PARTITION_MMAP_DATA,
+                                       &map, &s_map_handle);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to map partition: %s", esp_err_to_name(ret));
+        vSemaphoreDelete(s_mutex);
+        s_mutex = NULL;
+        return ret;
+    }
+    s_map = map;
+    
+    // Find the newest valid slot of each record
+    size_t offset = 0;
+    for (int i = 0; i < FLASH_STORE_RECORD_COUNT; i++) {
+        record_state_t *rec = &s_records[i];
+        rec->active = -1;
+        rec->seq = 0;
+        
+        for (int slot = 0; slot < 2; slot++) {
+            rec->slot_offset[slot] = offset;
+            offset += s_layout[i].slot_size;
+            
+            slot_header_t hdr;
+            if (slot_is_valid(i, rec->slot_offset[slot], &hdr) &&
+                (rec->active < 0 || hdr.seq > rec->seq)) {
+                rec->active = slot;
+                rec->seq = hdr.seq;
+                rec->length = hdr.length;
+            }
+        }
+        
+        if (rec->active >= 0) {
+            ESP_LOGI(TAG, "%s: %lu bytes (seq %lu)", s_layout[i].name,
+                     (unsigned long)rec->length, (unsigned long)rec->seq);
+        } else {
+            ESP_LOGI(TAG, "%s: empty", s_layout[i].name);
+        }
+    }
+    
+    esp_vfs_t vfs = {
+        .flags = ESP_VFS_FLAG_DEFAULT,
+        .open = vfs_open,
+        .read = vfs_read,
+        .write = vfs_write,
+        .lseek = vfs_lseek,
+        .fstat = vfs_fstat,
+        .stat = vfs_stat,
+        .fsync = vfs_fsync,
+        .close = vfs_close,
+    };
+    ret = esp_vfs_register(FLASH_STORE_MOUNT_POINT, &vfs, NULL);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to register VFS: %s", esp_err_to_name(ret));
+    }
+    
+    ESP_LOGI(TAG, "Flash store ready at 0x%lx (%lu KB) in %lld us",
+             (unsigned long)s_partition->address, (unsigned long)(s_partition->size / 1024),
+             esp_timer_get_time() - start_us);
+    return ESP_OK;
+}
+
+bool flash_store_is_available(void)
+{
+    return s_map != NULL;
+}
+
+const char *flash_store_record_name(flash_store_record_t record)
+{
+    if (record >= FLASH_STORE_RECORD_COUNT) {
+        return NULL;
+    }
+    return s_layout[record].name;
+}
+
+esp_err_t flash_store_get(flash_store_record_t record, const void **data, size_t *len)
+{
+    ESP_RETURN_ON_FALSE(record < FLASH_STORE_RECORD_COUNT && data && len, ESP_ERR_INVALID_ARG,
+                        TAG, "Invalid argument");
+    ESP_RETURN_ON_FALSE(s_map != NULL, ESP_ERR_INVALID_STATE, TAG, "Flash store not initialized");
+    
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+    if (s_records[record].active >= 0) {
+        *data = record_data(record);
+        *len = s_records[record].length;
+        ret = ESP_OK;
+    }
+    xSemaphoreGive(s_mutex);
+    return ret;
+}
+
+esp_err_t flash_store_write(flash_store_record_t record, const void *data, size_t len)
+{
+    ESP_RETURN_ON_FALSE(record < FLASH_STORE_RECORD_COUNT && (data || len == 0), ESP_ERR_INVALID_ARG,
+                        TAG, "Invalid argument");
+    ESP_RETURN_ON_FALSE(s_map != NULL, ESP_ERR_INVALID_STATE, TAG, "Flash store not initialized");
+    
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    esp_err_t ret = write_locked(record, data, len);
+    xSemaphoreGive(s_mutex);
+    return ret;
+}
+
+esp_err_t flash_store_import(const char *dir, bool overwrite)
+{
+    ESP_RETURN_ON_FALSE(s_map != NULL, ESP_ERR_INVALID_STATE, TAG, "Flash store not initialized");
+    
+    esp_err_t result = ESP_OK;
+    for (int i = 0; i < FLASH_STORE_RECORD_COUNT; i++) {
+        if (!overwrite && s_records[i].active >= 0) {
+            continue;
+        }
+        
+        char path[64];
+        snprintf(path, sizeof(path), "%s/%s", dir, s_layout[i].name);
+        struct stat st;
+        if (stat(path, &st) != 0) {
+            continue;
+        }
+        
+        char *buf = NULL;
+        size_t size = 0;
+        esp_err_t ret = waveshare_sd_read_file_caps(path, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT, &buf, &size);
+        if (ret == ESP_OK) {
+            ret = flash_store_write(i, buf, size);
+            free(buf);
+        }
+        
+        if (ret == ESP_OK) {
+            ESP_LOGI(TAG, "Imported %s (%u bytes)", path, (unsigned)size);
+        } else {
+            ESP_LOGE(TAG, "Failed to import %s: %s", path, esp_err_to_name(ret));
+            result = ret;
+        }
+    }
+    return result;
+}
+
+esp_err_t flash_store_export(const char *dir)
+{
+    ESP_RETURN_ON_FALSE(s_map != NULL, ESP_ERR_INVALID_STATE, TAG, "Flash store not initialized");
+    
+    esp_err_t result = ESP_OK;
+    for (int i = 0; i < FLASH_STORE_RECORD_COUNT; i++) {
+        const void *data;
+        size_t len;
+        if (flash_store_get(i, &data, &len) != ESP_OK) {
+            continue;
+        }
+        
+        char path[64];
+        snprintf(path, sizeof(path), "%s/%s", dir, s_layout[i].name);
+        esp_err_t ret = waveshare_sd_write_file_atomic(path, data, len);
+        if (ret == ESP_OK) {
+            ESP_LOGI(TAG, "Exported %s (%u bytes)", path, (unsigned)len);
+        } else {
+            ESP_LOGE(TAG, "Failed to export %s: %s", path, esp_err_to_name(ret));
+            result = ret;
+        }
+    }
+    return result;
+}
+
+void flash_store_benchmark_log(const char *dir)
+{
+    if (!s_map) {
+        return;
+    }
+    
+    ESP_LOGI(TAG, "Record access latency (full read):");
+    for (int i = 0; i < FLASH_STORE_RECORD_COUNT; i++) {
+        // Flash: look up the mapping and touch every byte
+        int64_t start_us = esp_timer_get_time();
+        const void *data;
+        size_t len;
+        if (flash_store_get(i, &data, &len) != ESP_OK) {
+            continue;
+        }
+        volatile uint32_t crc = esp_rom_crc32_le(0, data, len);
+        (void)crc;
+        int64_t flash_us = esp_timer_get_time() - start_us;
+        
+        // SD: open, read and close the same file
+        int64_t sd_us = -1;
+        if (dir) {
+            char path[64];
+            snprintf(path, sizeof(path), "%s/%s", dir, s_layout[i].name);
+            char *buf = NULL;
+            size_t size = 0;
+            start_us = esp_timer_get_time();
+            if (waveshare_sd_read_file(path, &buf, &size) == ESP_OK) {
+                sd_us = esp_timer_get_time() - start_us;
+                free(buf);
+            }
+        }
+        
+        if (sd_us >= 0) {
+            ESP_LOGI(TAG, "  %-15s %6u bytes  flash %6lld us  SD %7lld us",
+                     s_layout[i].name, (unsigned)len, flash_us, sd_us);
+        } else {
+            ESP_LOGI(TAG, "  %-15s %6u bytes  flash %6lld us  SD n/a",
+                     s_layout[i].name, (unsigned)len, flash_us);
+        }
+    }
+}
@@ -0,0 +1,126 @@
+/**
+ * @file flash_store.h
+ * @brief Internal flash store for node ID, LCC config and scenes
+ * 
+ * The primary copy of every persistent file lives in the "store" data
+ * partition. The partition is memory-mapped once at init, so reads are
+ * zero-copy pointers into flash; the SD card is only used to import or
+ * export the same files on demand.
+ * 
+ * Each record has two slots. A write erases the inactive slot, writes the
+ * data and then the header, so a power cut leaves the previous copy intact.
+ * 
+ * Records are also exposed as files under FLASH_STORE_MOUNT_POINT (e.g.
+ * "/flash/openmrn_config") for code that needs a file descriptor, such as
+ * OpenMRN's config file. Writes through the VFS go to a RAM shadow and are
+ * committed to flash on fsync() or close().
+ * 
+ * @see docs/ARCHITECTURE.md Persistent Storage
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FLASH_STORE_PARTITION_LABEL "store"
+#define FLASH_STORE_MOUNT_POINT     "/flash"
+
+/**
+ * @brief Records held in the store
+ * 
+ * Each record uses the same file name and contents as its SD card
+ * counterpart, so import and export are plain copies.
+ */
+typedef enum {
+    FLASH_STORE_NODE_ID = 0,    ///< nodeid.txt (dotted hex node ID)
+    FLASH_STORE_LCC_CONFIG,     ///< openmrn_config (OpenMRN config image)
+    FLASH_STORE_SCENES,         ///< scenes.json
+    FLASH_STORE_RECORD_COUNT,
+} flash_store_record_t;
+
+#define FLASH_STORE_NODE_ID_PATH    FLASH_STORE_MOUNT_POINT "/nodeid.txt"
+#define FLASH_STORE_LCC_CONFIG_PATH FLASH_STORE_MOUNT_POINT "/openmrn_config"
+
+/**
+ * @brief Find and map the store partition and register the VFS
+ * 
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND if the partition
+ *                   table has no store partition
+ */
+esp_err_t flash_store_init(void);
+
+/**
+ * @brief Check whether the store was initialized
+ */
+bool flash_store_is_available(void);
+
+/**
+ * @brief Get the file name of a record (e.g. "scenes.json")
+ */
+const char *flash_store_record_name(flash_store_record_t record);
+
+/**
+ * @brief Get a record without copying
+ * 
+ * The returned pointer is into memory-mapped flash and stays valid until
+ * the record has been written twice more (the slot is then reused).
+ * 
+ * @param record Record to read
+ * @param[out] data Pointer to the record contents
+ * @param[out] len Length in bytes
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND if the record is empty
+ */
+esp_err_t flash_store_get(flash_store_record_t record, const void **data, size_t *len);
+
+/**
+ * @brief Replace a record
+ * 
+ * Erases only the 4 KB sectors the new contents need (one for the node ID
+ * and LCC config, one or two for a typical scenes.json) and programs them.
+ * Each sector erase typically takes about 45 ms and can take a few hundred ms
+ * on a worn chip. While it runs, both cores are stalled for any code
+ * outside IRAM. Call it from a background task rather than LVGL context.
+ * 
+ * @param record Record to write
+ * @param data New contents
+ * @param len Length in bytes
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_SIZE if too large
+ */
+esp_err_t flash_store_write(flash_store_record_t record, const void *data, size_t len);
+
+/**
+ * @brief Copy records from files in a directory on the SD card
+ * 
+ * @param dir Directory holding the files (e.g. "/sdcard")
+ * @param overwrite If false, only records that are empty are imported
+ * @return esp_err_t ESP_OK if every present file was imported
+ */
+esp_err_t flash_store_import(const char *dir, bool overwrite);
+
+/**
+ * @brief Copy every non-empty record to files in a directory on the SD card
+ * 
+ * @param dir Destination directory (e.g. "/sdcard")
+ * @return esp_err_t ESP_OK if every record was exported
+ */
+esp_err_t flash_store_export(const char *dir);
+
+/**
+ * @brief Log access latency of each record from flash and from the SD card
+ * 
+ * Times a full read of each record through the flash mapping and through
+ * the same file in @p dir, for comparing the two storage paths.
+ * 
+ * @param dir Directory holding the SD copies, or NULL to time flash only
+ */
+void flash_store_benchmark_log(const char *dir);
+
+#ifdef __cplusplus
+}
+#endif
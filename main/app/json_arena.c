@@ -0,0 +1,150 @@
+/**
+ * @file json_arena.c
+ * @brief Bump allocator for transient cJSON work
+ */
+
+#include "json_arena.h"
+#include "cJSON.h"
+
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+
+static const char *TAG = "json_arena";
+
+/// Allocation alignment (matches malloc on Xtensa)
+#define JSON_ARENA_ALIGN    8
+
+static struct {
+    uint8_t *base;
+    size_t capacity;
+    size_t used;
+    SemaphoreHandle_t mutex;
+    json_arena_stats_t stats;
+} s_arena = {0};
+
+static void *arena_malloc(size_t size)
+{
+    size_t aligned = (size + JSON_ARENA_ALIGN - 1) & ~(size_t)(JSON_ARENA_ALIGN - 1);
+    if (aligned <= s_arena.capacity - s_arena.used) {
+        void *ptr = s_arena.base + s_arena.used;
+        s_arena.used += aligned;
+        return ptr;
+    }
+    
+    // Arena exhausted - fall back to PSRAM heap so the operation still succeeds
+    s_arena.stats.overflow_allocs++;
+    return heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+}
+
+static void arena_free(void *ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+    
+    // Arena memory is released all at once by json_arena_end()
+    if ((uint8_t *)ptr >= s_arena.base && (uint8_t *)ptr < s_arena.base + s_arena.capacity) {
+        return;
+    }
+    
+    heap_caps_free(ptr);
+}
+
+uint8_t json_arena_fragmentation_pct(size_t free_bytes, size_t largest_block)
+{
+    if (free_bytes == 0) {
+        return 0;
+    }
+    return (uint8_t)(100 - (largest_block * 100) / free_bytes);
+}
+
+esp_err_t json_arena_init(size_t capacity)
+{
+    if (s_arena.mutex == NULL) {
+        s_arena.mutex = xSemaphoreCreateMutex();
+        if (s_arena.mutex == NULL) {
+            ESP_LOGE(TAG, "Failed to create mutex");
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    
+    if (s_arena.base != NULL) {
+        return ESP_OK;
+    }
+    
+    s_arena.base = heap_caps_malloc(capacity, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (s_arena.base == NULL) {
+        ESP_LOGW(TAG, "No PSRAM for %u byte arena, cJSON will use the default heap", (unsigned)capacity);
+        return ESP_ERR_NO_MEM;
+    }
+    
+    s_arena.capacity = capacity;
+    s_arena.stats.capacity = capacity;
+    ESP_LOGI(TAG, "JSON arena: %u bytes in PSRAM", (unsigned)capacity);
+    return ESP_OK;
+}
+
+void json_arena_begin(void)
+{
+    if (s_arena.mutex) {
+        xSemaphoreTake(s_arena.mutex, portMAX_DELAY);
+    }
+    
+    s_arena.stats.internal_free_before = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    s_arena.stats.internal_largest_before = heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL);
+    
+    if (s_arena.base) {
+        s_arena.used = 0;
+        cJSON_Hooks hooks = {
+            .malloc_fn = arena_malloc,
+            .free_fn = arena_free,
+        };
+        cJSON_InitHooks(&hooks);
+    }
+}
+
+void json_arena_end(void)
+{
+    if (s_arena.base) {
+        // Restore malloc/free so cJSON use outside a session is unaffected
+        cJSON_InitHooks(NULL);
+        
+        s_arena.stats.last_used = s_arena.used;
+        if (s_arena.used > s_arena.stats.peak_used) {
+            s_arena.stats.peak_used = s_arena.used;
+        }
+        s_arena.used = 0;
+    }
+    
+    s_arena.stats.sessions++;
+    s_arena.stats.internal_free_after = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    s_arena.stats.internal_largest_after = heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL);
+    
+    ESP_LOGD(TAG, "Session used %u bytes (peak %u/%u), internal frag %u%% -> %u%%",
+             (unsigned)s_arena.stats.last_used, (unsigned)s_arena.stats.peak_used,
+             (unsigned)s_arena.capacity,
+             json_arena_fragmentation_pct(s_arena.stats.internal_free_before, s_arena.stats.internal_largest_before),
+             json_arena_fragmentation_pct(s_arena.stats.internal_free_after, s_arena.stats.internal_largest_after));
+    
+    if (s_arena.mutex) {
+        xSemaphoreGive(s_arena.mutex);
+    }
+}
+
+void json_arena_get_stats(json_arena_stats_t *stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+    
+    if (s_arena.mutex) {
+        xSemaphoreTake(s_arena.mutex, portMAX_DELAY);
+    }
+    *stats = s_arena.stats;
+    if (s_arena.mutex) {
+        xSemaphoreGive(s_arena.mutex);
+    }
+}
@@ -0,0 +1,87 @@
+/**
+ * @file json_arena.h
+ * @brief Bump allocator for transient cJSON work
+ * 
+ * Parsing and serializing scenes.json makes hundreds of small cJSON
+ * allocations that are all freed together at the end of the operation.
+ * Between json_arena_begin() and json_arena_end() cJSON allocates from a
+ * PSRAM arena instead of the default heap; frees are no-ops and the arena
+ * is reset in O(1) at the end, so the operation leaves no holes in
+ * internal RAM.
+ * 
+ * Only one arena session runs at a time (begin/end take a mutex). Anything
+ * cJSON allocated inside a session, including cJSON_Print() output, is
+ * invalid after json_arena_end().
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Arena and heap statistics
+ */
+typedef struct {
+    size_t capacity;                ///< Arena size in bytes (0 if disabled)
+    size_t peak_used;               ///< Highest arena usage across all sessions
+    size_t last_used;               ///< Arena usage of the most recent session
+    uint32_t sessions;              ///< Number of completed sessions
+    uint32_t overflow_allocs;       ///< Allocations that did not fit and went to the heap
+    size_t internal_free_before;    ///< Internal heap free bytes at start of last session
+    size_t internal_largest_before; ///< Largest internal free block at start of last session
+    size_t internal_free_after;     ///< Internal heap free bytes at end of last session
+    size_t internal_largest_after;  ///< Largest internal free block at end of last session
+} json_arena_stats_t;
+
+/**
+ * @brief Allocate the arena
+ * 
+ * If PSRAM is unavailable the arena is disabled and cJSON keeps using the
+ * default heap; begin/end still serialize sessions.
+ * 
+ * @param capacity Arena size in bytes
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NO_MEM if the arena could
+ *                   not be allocated
+ */
+esp_err_t json_arena_init(size_t capacity);
+
+/**
+ * @brief Start a cJSON session using the arena
+ * 
+ * Blocks until any other session has ended.
+ */
+void json_arena_begin(void);
+
+/**
+ * @brief End the session: reset the arena and restore default cJSON hooks
+ */
+void json_arena_end(void);
+
+/**
+ * @brief Get arena usage and internal-heap fragmentation statistics
+ * 
+ * @param stats Output statistics
+ */
+void json_arena_get_stats(json_arena_stats_t *stats);
+
+/**
+ * @brief Internal heap fragmentation as a percentage
+ * 
+ * 0 means the largest free block is all the free memory; values near 100
+ * mean free memory is scattered in small blocks.
+ * 
+ * @param free_bytes Total free bytes
+ * @param largest_block Largest free block
+ * @return Fragmentation percentage (0-100)
+ */
+uint8_t json_arena_fragmentation_pct(size_t free_bytes, size_t largest_block);
+
+#ifdef __cplusplus
+}
+#endif
@@ -3,7 +3,7 @@
  * @brief LCC/OpenMRN Node Implementation
  * 
  * Implements the OpenMRN/LCC stack initialization and event production.
- * Reads node ID from SD card, initializes TWAI hardware, and provides
+ * Reads node ID from the flash store, initializes TWAI hardware, and provides
  * event production for lighting control.
  * 
  * @see docs/ARCHITECTURE.md §5 for OpenMRN Integration
@@ -13,6 +13,8 @@
 #include "lcc_node.h"
 #include "lcc_config.hxx"
 #include "bootloader_hal.h"
+#include "sd_worker.h"
+#include "flash_store.h"
 
 #include <cstdio>
 #include <cstring>
@@ -43,7 +45,7 @@ namespace {
 /// LCC node status
 static lcc_status_t s_status = LCC_STATUS_UNINITIALIZED;
 
-/// Node ID read from SD card
+/// Node ID read from the node ID file
 static openlcb::NodeID s_node_id = 0;
 
 /// TWAI hardware driver instance
@@ -67,8 +69,8 @@ static uint16_t s_auto_apply_duration_sec = openlcb::DEFAULT_AUTO_APPLY_DURATION
 /// Cached screen timeout in seconds
 static uint16_t s_screen_timeout_sec = openlcb::DEFAULT_SCREEN_TIMEOUT_SEC;
 
-/// Config file path
-static std::string s_config_path;
+/// Config file path (CONFIG_FILENAME points here, set by lcc_node_init)
+static char s_config_filename[64] = FLASH_STORE_LCC_CONFIG_PATH;
 
 /**
  * @brief Parse a node ID from a string
@@ -119,7 +121,7 @@ static bool parse_node_id(const char *str, openlcb::NodeID *out_id)
 }
 
 /**
- * @brief Read node ID from file on SD card
+ * @brief Read node ID from file (flash store or SD card)
  * 
  * @param path Path to node ID file
  * @param out_id Output node ID
@@ -159,7 +161,7 @@ static bool read_node_id_from_file(const char *path, openlcb::NodeID *out_id)
 }
 
 /**
- * @brief Create default node ID file on SD card
+ * @brief Create default node ID file
  */
 static void create_default_nodeid_file(const char *path)
 {
@@ -186,11 +188,12 @@ static void create_default_nodeid_file(const char *path)
 }
 
 /**
- * @brief FileMemorySpace that syncs to SD card after every write
+ * @brief FileMemorySpace that syncs to storage after every write
  * 
  * ESP-IDF's FAT VFS caches file data, which can cause reads to return stale
- * data after writes unless fsync() is called. This class wraps the standard
- * file operations and calls fsync() after every write to ensure consistency.
+ * data after writes unless fsync() is called, and the flash store only
+ * commits its RAM shadow on fsync(). This class wraps the standard file
+ * operations and calls fsync() after every write to ensure consistency.
  */
 class SyncingFileMemorySpace : public openlcb::MemorySpace
 {
@@ -328,7 +331,7 @@ public:
         s_cfg->seg().lighting().base_event_id().write(fd, openlcb::DEFAULT_BASE_EVENT_ID);
         s_base_event_id = openlcb::DEFAULT_BASE_EVENT_ID;
         
-        // Sync to SD card
+        // Commit to storage
         fsync(fd);
     }
 };
@@ -338,8 +341,6 @@ static LccConfigListener *s_config_listener = nullptr;
 
 } // anonymous namespace
 
-/// Path to the configuration file on SD card
-static const char LCC_CONFIG_FILE[] = "/sdcard/openmrn_config";
 
 // ============================================================================
 // OpenMRN required external symbols
@@ -417,15 +418,15 @@ const char CDI_DATA[] =
 </segment>
 </cdi>)xmldata";
 
-/// Configuration file path
-const char *const CONFIG_FILENAME = LCC_CONFIG_FILE;
+/// Configuration file path (flash store, or SD card without a store partition)
+const char *const CONFIG_FILENAME = s_config_filename;
 
 /// Size of the configuration file (computed from ConfigDef layout)
 /// ConfigDef::size() gives the total size, offset() isn't static so we use a fixed value
 const size_t CONFIG_FILE_SIZE = ConfigDef::size() + 128;
 
 /// SNIP user data file (same as config file)
-const char *const SNIP_DYNAMIC_FILENAME = LCC_CONFIG_FILE;
+const char *const SNIP_DYNAMIC_FILENAME = s_config_filename;
 
 } // namespace openlcb
 
@@ -452,10 +453,10 @@ esp_err_t lcc_node_init(const lcc_config_t *config)
     ESP_LOGI(TAG, "  Config file: %s", cfg.config_path);
     ESP_LOGI(TAG, "  TWAI RX: GPIO%d, TX: GPIO%d", cfg.twai_rx_gpio, cfg.twai_tx_gpio);
 
-    // Save config path for later
-    s_config_path = cfg.config_path;
+    // OpenMRN opens CONFIG_FILENAME, which points at this buffer
+    strlcpy(s_config_filename, cfg.config_path, sizeof(s_config_filename));
 
-    // Read node ID from SD card
+    // Read node ID from storage
     if (!read_node_id_from_file(cfg.nodeid_path, &s_node_id)) {
         ESP_LOGW(TAG, "Using default node ID: %012llx", (unsigned long long)LCC_DEFAULT_NODE_ID);
         s_node_id = LCC_DEFAULT_NODE_ID;
@@ -502,7 +503,7 @@ esp_err_t lcc_node_init(const lcc_config_t *config)
         return ESP_FAIL;
     }
 
-    // Sync config file to SD card after factory reset writes
+    // Commit config file after factory reset writes
     fsync(config_fd);
 
     // Read initial base event ID from config
@@ -531,7 +532,7 @@ esp_err_t lcc_node_init(const lcc_config_t *config)
 
     // Register our custom SyncingFileMemorySpace instances to replace the
     // defaults registered by default_start_node(). These call fsync() after
-    // every write to ensure data is persisted to SD card.
+    // every write to ensure data is persisted to storage.
     // IMPORTANT: Must happen BEFORE start_after_delay() to avoid the race.
     
     // Space 253 (SPACE_CONFIG) - main configuration space
@@ -555,6 +556,16 @@ esp_err_t lcc_node_init(const lcc_config_t *config)
     return ESP_OK;
 }
 
+bool lcc_node_read_node_id(const char *path, uint64_t *node_id)
+{
+    openlcb::NodeID id;
+    if (!node_id || !read_node_id_from_file(path, &id)) {
+        return false;
+    }
+    *node_id = id;
+    return true;
+}
+
 lcc_status_t lcc_node_get_status(void)
 {
     return s_status;
@@ -645,6 +656,8 @@ void lcc_node_shutdown(void)
 void reboot()
 {
     ESP_LOGI(TAG, "Reboot requested via LCC");
+    // Let any queued scene writes reach storage before restarting
+    sd_worker_flush(1000);
     vTaskDelay(pdMS_TO_TICKS(200));
     esp_restart();
 }
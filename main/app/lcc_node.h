@@ -17,6 +17,7 @@ extern "C" {
 #endif
 
 #include "esp_err.h"
+#include "flash_store.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -42,7 +43,7 @@ typedef enum {
  * @brief LCC initialization configuration
  */
 typedef struct {
-    const char *nodeid_path;        /**< Path to node ID file on SD card */
+    const char *nodeid_path;        /**< Path to node ID file (flash store or SD card) */
     const char *config_path;        /**< Path to config file (for OpenMRN EEPROM emulation) */
     int twai_rx_gpio;               /**< TWAI RX GPIO pin */
     int twai_tx_gpio;               /**< TWAI TX GPIO pin */
@@ -52,8 +53,8 @@ typedef struct {
  * @brief Default LCC configuration
  */
 #define LCC_CONFIG_DEFAULT() { \
-    .nodeid_path = "/sdcard/nodeid.txt", \
-    .config_path = "/sdcard/lcc_config.bin", \
+    .nodeid_path = FLASH_STORE_NODE_ID_PATH, \
+    .config_path = FLASH_STORE_LCC_CONFIG_PATH, \
     .twai_rx_gpio = 16, \
     .twai_tx_gpio = 15, \
 }
@@ -61,7 +62,7 @@ typedef struct {
 /**
  * @brief Initialize the LCC node
  * 
- * Reads node ID from SD card, initializes TWAI (CAN) hardware,
+ * Reads node ID from the flash store, initializes TWAI (CAN) hardware,
  * and starts the OpenMRN stack.
  * 
  * @param config Configuration options
@@ -83,6 +84,18 @@ lcc_status_t lcc_node_get_status(void);
  */
 uint64_t lcc_node_get_node_id(void);
 
+/**
+ * @brief Read a node ID file without initializing the node
+ * 
+ * Used by the bootloader path, which needs the node ID before the stack
+ * is started.
+ * 
+ * @param path Path to node ID file
+ * @param[out] node_id Parsed node ID
+ * @return true if the file was read and parsed
+ */
+bool lcc_node_read_node_id(const char *path, uint64_t *node_id);
+
 /**
  * @brief Get the configured base event ID
  * 
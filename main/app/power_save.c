@@ -0,0 +1,245 @@
+/**
+ * @file power_save.c
+ * @brief Power Saving While the Screen Is Off Implementation
+ * 
+ * While the screen is on, an ESP_PM_CPU_FREQ_MAX lock keeps the CPUs at
+ * full speed, so rendering is unaffected by frequency scaling. When the
+ * screen timeout has switched the backlight off, power_save_enter():
+ * 
+ * - suspends LVGL and drops the panel to CONFIG_LCD_OFF_PIXEL_CLOCK_HZ
+ *   (ui_set_suspended())
+ * - releases the CPU lock, so esp_pm runs the CPUs at the lowest speed
+ *   the remaining locks allow
+ * - clears the awake bit that keeps power_save_wait() from blocking, so
+ *   the main loop and lighting task sleep until they have work
+ * 
+ * A touch still raises the GT911 INT line and wakes the touch task, which
+ * wakes the screen through screen_timeout_notify_activity().
+ * 
+ * While the LCC node is running an ESP_PM_APB_FREQ_MAX lock is held: TWAI
+ * is clocked from APB and cannot receive in light sleep. The RGB panel
+ * driver holds the same lock for as long as the panel exists, so on this
+ * board the CPUs go no lower than 80 MHz and light sleep does not engage;
+ * power_save_dump() lists the locks.
+ */
+
+#include "power_save.h"
+#include "lcc_node.h"
+#include "ui/ui_common.h"
+
+#include <stdio.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "esp_pm.h"
+#include "freertos/event_groups.h"
+
+#if CONFIG_POWER_SAVE
+static const char *TAG = "power_save";
+
+/// Set while the screen is on; power_save_wait() blocks while it is clear
+#define POWER_SAVE_AWAKE_BIT    BIT0
+
+/// Module state (written in LVGL context, statistics read from any task)
+static struct {
+    bool initialized;
+    bool active;
+    bool twai_held;                 ///< APB lock taken for the LCC node
+    esp_pm_lock_handle_t cpu_lock;  ///< Full CPU speed while the screen is on
+    esp_pm_lock_handle_t twai_lock; ///< APB clock and no light sleep for TWAI
+    EventGroupHandle_t events;
+    portMUX_TYPE lock;              ///< Guards the statistics
+    int64_t enter_us;
+    uint32_t periods;
+    int64_t total_us;
+    uint32_t wakes;
+    uint32_t wake_last_ms;
+    uint32_t wake_max_ms;
+    uint64_t wake_sum_ms;
+} s_ps = {
+    .lock = portMUX_INITIALIZER_UNLOCKED,
+};
+#endif
+
+esp_err_t power_save_init(void)
+{
+#if CONFIG_POWER_SAVE
+    if (s_ps.initialized) {
+        ESP_LOGW(TAG, "Already initialized");
+        return ESP_OK;
+    }
+    
+    s_ps.events = xEventGroupCreate();
+    ESP_RETURN_ON_FALSE(s_ps.events != NULL, ESP_ERR_NO_MEM, TAG, "Failed to create event group");
+    xEventGroupSetBits(s_ps.events, POWER_SAVE_AWAKE_BIT);
+    
+    // Hold full speed before frequency scaling is enabled
+    ESP_RETURN_ON_ERROR(esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "screen_on", &s_ps.cpu_lock),
+                        TAG, "Failed to create CPU lock");
+    ESP_RETURN_ON_ERROR(esp_pm_lock_create(ESP_PM_APB_FREQ_MAX, 0, "lcc_twai", &s_ps.twai_lock),
+                        TAG, "Failed to create TWAI lock");
+    esp_pm_lock_acquire(s_ps.cpu_lock);
+    
+    esp_pm_config_t pm_config = {
+        .max_freq_mhz = CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ,
+        .min_freq_mhz = CONFIG_POWER_SAVE_MIN_CPU_FREQ_MHZ,
+#if CONFIG_POWER_SAVE_LIGHT_SLEEP
+        .light_sleep_enable = true,
+#endif
+    };
+    esp_err_t ret = esp_pm_configure(&pm_config);
+    if (ret != ESP_OK) {
+        esp_pm_lock_release(s_ps.cpu_lock);
+        ESP_LOGE(TAG, "esp_pm_configure failed: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    
+    s_ps.initialized = true;
+    ESP_LOGI(TAG, "Initialized: CPU %d-%d MHz while the screen is off, light sleep %s",
+             CONFIG_POWER_SAVE_MIN_CPU_FREQ_MHZ, CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ,
+             pm_config.light_sleep_enable ? "allowed" : "off");
+#endif
+    return ESP_OK;
+}
+
+void power_save_enter(void)
+{
+#if CONFIG_POWER_SAVE
+    if (!s_ps.initialized || s_ps.active) {
+        return;
+    }
+    
+    ui_set_suspended(true);
+    
+    s_ps.twai_held = (lcc_node_get_status() == LCC_STATUS_RUNNING);
+    if (s_ps.twai_held) {
+        esp_pm_lock_acquire(s_ps.twai_lock);
+    }
+    esp_pm_lock_release(s_ps.cpu_lock);
+    
+    portENTER_CRITICAL(&s_ps.lock);
+    s_ps.active = true;
+    s_ps.enter_us = esp_timer_get_time();
+    s_ps.periods++;
+    portEXIT_CRITICAL(&s_ps.lock);
+    
+    xEventGroupClearBits(s_ps.events, POWER_SAVE_AWAKE_BIT);
+    ESP_LOGI(TAG, "Screen off - power saving%s", s_ps.twai_held ? " (TWAI lock held)" : "");
+#endif
+}
+
+void power_save_exit(void)
+{
+#if CONFIG_POWER_SAVE
+    if (!s_ps.initialized || !s_ps.active) {
+        return;
+    }
+    
+    // Full speed first, so the fade-in and everything after it runs at it
+    esp_pm_lock_acquire(s_ps.cpu_lock);
+    if (s_ps.twai_held) {
+        esp_pm_lock_release(s_ps.twai_lock);
+        s_ps.twai_held = false;
+    }
+    
+    ui_set_suspended(false);
+    
+    int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&s_ps.lock);
+    s_ps.active = false;
+    s_ps.total_us += now - s_ps.enter_us;
+    portEXIT_CRITICAL(&s_ps.lock);
+    
+    xEventGroupSetBits(s_ps.events, POWER_SAVE_AWAKE_BIT);
+    ESP_LOGI(TAG, "Screen waking after %.1f s of power saving", (now - s_ps.enter_us) / 1e6);
+#endif
+}
+
+bool power_save_is_active(void)
+{
+#if CONFIG_POWER_SAVE
+    return s_ps.active;
+#else
+    return false;
+#endif
+}
+
+bool power_save_wait(TickType_t ticks)
+{
+#if CONFIG_POWER_SAVE
+    if (!s_ps.initialized || (xEventGroupGetBits(s_ps.events) & POWER_SAVE_AWAKE_BIT)) {
+        return false;
+    }
+    
+    xEventGroupWaitBits(s_ps.events, POWER_SAVE_AWAKE_BIT, pdFALSE, pdFALSE, ticks);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void power_save_record_wake(int64_t latency_us)
+{
+#if CONFIG_POWER_SAVE
+    if (latency_us < 0) {
+        return;
+    }
+    
+    uint32_t latency_ms = (uint32_t)(latency_us / 1000);
+    portENTER_CRITICAL(&s_ps.lock);
+    s_ps.wakes++;
+    s_ps.wake_last_ms = latency_ms;
+    s_ps.wake_sum_ms += latency_ms;
+    if (latency_ms > s_ps.wake_max_ms) {
+        s_ps.wake_max_ms = latency_ms;
+    }
+    portEXIT_CRITICAL(&s_ps.lock);
+    
+    ESP_LOGI(TAG, "Wake to first frame: %lu ms", (unsigned long)latency_ms);
+#endif
+}
+
+void power_save_get_stats(power_save_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+#if CONFIG_POWER_SAVE
+    int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&s_ps.lock);
+    stats->enabled = s_ps.initialized;
+    stats->active = s_ps.active;
+    stats->periods = s_ps.periods;
+    stats->total_us = s_ps.total_us + (s_ps.active ? now - s_ps.enter_us : 0);
+    stats->wakes = s_ps.wakes;
+    stats->wake_last_ms = s_ps.wake_last_ms;
+    stats->wake_max_ms = s_ps.wake_max_ms;
+    stats->wake_avg_ms = s_ps.wakes ? (uint32_t)(s_ps.wake_sum_ms / s_ps.wakes) : 0;
+    portEXIT_CRITICAL(&s_ps.lock);
+#endif
+}
+
+void power_save_dump(void)
+{
+#if CONFIG_POWER_SAVE
+    power_save_stats_t stats;
+    power_save_get_stats(&stats);
+    
+#if CONFIG_POWER_SAVE_LIGHT_SLEEP
+    const char *light_sleep = "allowed";
+#else
+    const char *light_sleep = "off";
+#endif
+    printf("Power saving: %s, CPU %d-%d MHz, light sleep %s\n",
+           !stats.enabled ? "not initialized" : stats.active ? "active (screen off)" : "idle (screen on)",
+           CONFIG_POWER_SAVE_MIN_CPU_FREQ_MHZ, CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ, light_sleep);
+    printf("  screen off: %lu times, %.1f s in total\n",
+           (unsigned long)stats.periods, stats.total_us / 1e6);
+    printf("  wake to first frame: last %lu ms, avg %lu ms, max %lu ms (%lu wakes)\n",
+           (unsigned long)stats.wake_last_ms, (unsigned long)stats.wake_avg_ms,
+           (unsigned long)stats.wake_max_ms, (unsigned long)stats.wakes);
+    printf("esp_pm locks:\n");
+    esp_pm_dump_locks(stdout);
+#else
+    printf("Power saving: not built (CONFIG_POWER_SAVE)\n");
+#endif
+}
@@ -0,0 +1,111 @@
+/**
+ * @file power_save.h
+ * @brief Power Saving While the Screen Is Off
+ * 
+ * Once the screen timeout has faded the UI out and switched the backlight
+ * off, the CPUs no longer need to run at full speed and nothing needs to
+ * be drawn. This module lets esp_pm scale the CPU frequency down, pauses
+ * LVGL and slows the panel scan-out, and gives polling tasks a way to
+ * sleep until they have work. Touch-to-wake and the LCC node (TWAI) keep
+ * working throughout.
+ * 
+ * @see screen_timeout.h for the screen state machine that drives it
+ */
+
+#ifndef POWER_SAVE_H_
+#define POWER_SAVE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Power saving statistics
+ */
+typedef struct {
+    bool enabled;               ///< Built with CONFIG_POWER_SAVE and initialized
+    bool active;                ///< Screen is off and power saving now
+    uint32_t periods;           ///< Times power saving was entered
+    int64_t total_us;           ///< Time spent power saving, including now
+    uint32_t wakes;             ///< Wakes with a measured latency
+    uint32_t wake_last_ms;      ///< Touch to first fade-in frame, last wake
+    uint32_t wake_avg_ms;
+    uint32_t wake_max_ms;
+} power_save_stats_t;
+
+/**
+ * @brief Initialize power management
+ * 
+ * Configures esp_pm frequency scaling (and light sleep with
+ * CONFIG_POWER_SAVE_LIGHT_SLEEP) and takes a lock that keeps the CPUs at
+ * full speed until power_save_enter(). Does nothing without
+ * CONFIG_POWER_SAVE.
+ * 
+ * @return ESP_OK on success
+ */
+esp_err_t power_save_init(void);
+
+/**
+ * @brief Start saving power (screen is off)
+ * 
+ * Suspends LVGL and releases the full-speed CPU lock. Call from LVGL
+ * context once the backlight is off.
+ */
+void power_save_enter(void);
+
+/**
+ * @brief Stop saving power (screen is waking)
+ * 
+ * Restores full CPU speed first, then resumes LVGL and wakes the tasks
+ * blocked in power_save_wait(). Call from LVGL context before the fade-in.
+ */
+void power_save_exit(void);
+
+/**
+ * @brief Check if power saving is in effect
+ * 
+ * @return true between power_save_enter() and power_save_exit()
+ */
+bool power_save_is_active(void);
+
+/**
+ * @brief Block a polling task while power saving
+ * 
+ * Returns false at once when power saving is not in effect, so the caller
+ * keeps its normal period. Otherwise blocks until @p ticks have passed or
+ * the screen wakes.
+ * 
+ * @param ticks Longest time to block
+ * @return true if the task blocked
+ */
+bool power_save_wait(TickType_t ticks);
+
+/**
+ * @brief Record how long a wake took to show its first frame
+ * 
+ * @param latency_us Time from the waking touch to the first fade-in frame
+ */
+void power_save_record_wake(int64_t latency_us);
+
+/**
+ * @brief Get power saving statistics
+ * 
+ * @param stats Filled with a snapshot
+ */
+void power_save_get_stats(power_save_stats_t *stats);
+
+/**
+ * @brief Print power saving statistics and the esp_pm locks to stdout
+ */
+void power_save_dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // POWER_SAVE_H_
@@ -1,92 +1,200 @@
 /**
  * @file scene_storage.c
- * @brief Scene storage implementation - load/save scenes from/to SD card
+ * @brief Scene storage implementation - in-memory store persisted to flash
+ * 
+ * scenes.json is parsed once at init, from the flash store (or the SD card
+ * if the partition table has no store partition). After that the cache
+ * below is the source of truth: mutations update the cache and notify
+ * observers with the exact change, then queue a coalesced rewrite on the
+ * SD worker task, so LVGL callbacks never block on flash or SD I/O.
  */
 
 #include "scene_storage.h"
+#include "sd_worker.h"
+#include "json_arena.h"
+#include "flash_store.h"
+#include "waveshare_sd.h"
 #include "cJSON.h"
 #include "esp_log.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <sys/stat.h>
 
 static const char *TAG = "scene_storage";
 
-// Cached scenes
+// Cached scenes (authoritative copy)
 static ui_scene_t s_scenes[SCENE_STORAGE_MAX_SCENES];
 static size_t s_scene_count = 0;
 
+// Guards s_scenes/s_scene_count against the SD worker's snapshot
+static SemaphoreHandle_t s_cache_mutex = NULL;
+
+// Registered change observers
+static struct {
+    scene_storage_observer_t cb;
+    void *user_ctx;
+} s_observers[SCENE_STORAGE_MAX_OBSERVERS];
+
+static void cache_lock(void)
+{
+    if (s_cache_mutex) {
+        xSemaphoreTake(s_cache_mutex, portMAX_DELAY);
+    }
+}
+
+static void cache_unlock(void)
+{
+    if (s_cache_mutex) {
+        xSemaphoreGive(s_cache_mutex);
+    }
+}
+
 /**
- * @brief Initialize scene storage module
+ * @brief Notify all observers of a change
  */
-esp_err_t scene_storage_init(void)
+static void notify_observers(scene_change_type_t type, size_t index, size_t from_index,
+                             const ui_scene_t *scene)
 {
-    ESP_LOGI(TAG, "Initializing scene storage");
-    
-    // Load scenes from SD card
-    size_t count = 0;
-    esp_err_t ret = scene_storage_load(s_scenes, SCENE_STORAGE_MAX_SCENES, &count);
-    if (ret == ESP_OK) {
-        s_scene_count = count;
-        ESP_LOGI(TAG, "Loaded %d scenes from SD card", s_scene_count);
-    } else {
-        ESP_LOGW(TAG, "Failed to load scenes: %s", esp_err_to_name(ret));
-        s_scene_count = 0;
+    scene_change_t change = {
+        .type = type,
+        .index = index,
+        .from_index = from_index,
+        .count = s_scene_count,
+    };
+    if (scene) {
+        change.scene = *scene;
+    }
+    
+    for (size_t i = 0; i < SCENE_STORAGE_MAX_OBSERVERS; i++) {
+        if (s_observers[i].cb) {
+            s_observers[i].cb(&change, s_observers[i].user_ctx);
+        }
     }
-    
-    return ESP_OK;
 }
 
 /**
- * @brief Load scenes from SD card
+ * @brief Find a scene by name in the cache
+ * 
+ * @return Index of the scene, or -1 if not found
  */
-esp_err_t scene_storage_load(ui_scene_t *scenes, size_t max_count, size_t *out_count)
+static int find_scene(const char *name)
 {
-    if (!scenes || !out_count) {
-        return ESP_ERR_INVALID_ARG;
+    for (size_t i = 0; i < s_scene_count; i++) {
+        if (strcmp(s_scenes[i].name, name) == 0) {
+            return (int)i;
+        }
     }
+    return -1;
+}
+
+/**
+ * @brief Fill a scene struct from name and values
+ */
+static void set_scene(ui_scene_t *scene, const char *name, uint8_t brightness,
+                      uint8_t red, uint8_t green, uint8_t blue, uint8_t white)
+{
+    strncpy(scene->name, name, sizeof(scene->name) - 1);
+    scene->name[sizeof(scene->name) - 1] = '\0';
+    scene->brightness = brightness;
+    scene->red = red;
+    scene->green = green;
+    scene->blue = blue;
+    scene->white = white;
+}
+
+/**
+ * @brief Move one entry within the cache, shifting the entries in between
+ */
+static void move_scene(size_t from_index, size_t to_index)
+{
+    ui_scene_t moving_scene = s_scenes[from_index];
     
-    *out_count = 0;
+    if (from_index < to_index) {
+        // Moving forward: shift items left
+        memmove(&s_scenes[from_index], &s_scenes[from_index + 1],
+                (to_index - from_index) * sizeof(ui_scene_t));
+    } else if (from_index > to_index) {
+        // Moving backward: shift items right
+        memmove(&s_scenes[to_index + 1], &s_scenes[to_index],
+                (from_index - to_index) * sizeof(ui_scene_t));
+    }
     
+    s_scenes[to_index] = moving_scene;
+}
+
+/**
+ * @brief Read scenes.json from the SD card (fallback when there is no flash store)
+ * 
+ * @param[out] json_buf Allocated buffer, free with free()
+ * @param[out] json_size File size
+ */
+static esp_err_t read_scenes_from_sd(char **json_buf, size_t *json_size)
+{
     // Check if file exists (also check for .tmp as fallback from failed rename)
     struct stat st;
-    const char *file_path = SCENE_STORAGE_PATH;
     
     if (stat(SCENE_STORAGE_PATH, &st) != 0) {
-        // Try fallback to .tmp file (from previous failed atomic write)
-        if (stat("/sdcard/scenes.tmp", &st) == 0) {
-            file_path = "/sdcard/scenes.tmp";
-            ESP_LOGW(TAG, "Using fallback scenes.tmp");
-            // Try to fix it by renaming
-            rename("/sdcard/scenes.tmp", SCENE_STORAGE_PATH);
-        } else {
+        // Try fallback to .tmp file (from previous interrupted atomic write)
+        static const char *fallbacks[] = { SCENE_STORAGE_TMP_PATH, "/sdcard/scenes.tmp" };
+        bool recovered = false;
+        for (size_t i = 0; i < sizeof(fallbacks) / sizeof(fallbacks[0]); i++) {
+            if (stat(fallbacks[i], &st) == 0) {
+                ESP_LOGW(TAG, "Using fallback %s", fallbacks[i]);
+                // Try to fix it by renaming
+                recovered = (rename(fallbacks[i], SCENE_STORAGE_PATH) == 0);
+                break;
+            }
+        }
+        if (!recovered) {
             ESP_LOGW(TAG, "scenes.json not found");
             return ESP_ERR_NOT_FOUND;
         }
     }
     
-    // Read file
-    FILE *file = fopen(file_path, "r");
-    if (!file) {
-        ESP_LOGE(TAG, "Failed to open scenes.json");
-        return ESP_FAIL;
+    esp_err_t ret = waveshare_sd_read_file_caps(SCENE_STORAGE_PATH, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT,
+                                                json_buf, json_size);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to read scenes.json: %s", esp_err_to_name(ret));
     }
-    
-    // Allocate buffer for file content
-    char *json_buf = malloc(st.st_size + 1);
-    if (!json_buf) {
-        fclose(file);
-        ESP_LOGE(TAG, "Failed to allocate memory for JSON");
-        return ESP_ERR_NO_MEM;
+    return ret;
+}
+
+/**
+ * @brief Parse scenes.json into the cache (called once from init)
+ * 
+ * With the flash store the JSON is parsed straight from memory-mapped
+ * flash; otherwise it is read from the SD card first.
+ */
+static esp_err_t load_scenes(void)
+{
+    s_scene_count = 0;
+    
+    const char *json = NULL;
+    size_t json_size = 0;
+    char *sd_buf = NULL;
+    esp_err_t ret;
+    
+    if (flash_store_is_available()) {
+        ret = flash_store_get(FLASH_STORE_SCENES, (const void **)&json, &json_size);
+        if (ret != ESP_OK) {
+            ESP_LOGW(TAG, "No scenes in flash store");
+            return ret;
+        }
+    } else {
+        ret = read_scenes_from_sd(&sd_buf, &json_size);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+        json = sd_buf;
     }
     
-    size_t read_size = fread(json_buf, 1, st.st_size, file);
-    fclose(file);
-    json_buf[read_size] = '\0';
-    
     // Parse JSON
-    cJSON *root = cJSON_Parse(json_buf);
-    free(json_buf);
+    cJSON *root = cJSON_ParseWithLength(json, json_size);
+    free(sd_buf);
     
     if (!root) {
         ESP_LOGE(TAG, "Failed to parse scenes.json: %s", cJSON_GetErrorPtr());
@@ -105,8 +213,8 @@ esp_err_t scene_storage_load(ui_scene_t *scenes, size_t max_count, size_t *out_c
     size_t count = 0;
     cJSON *scene_obj = NULL;
     cJSON_ArrayForEach(scene_obj, scenes_array) {
-        if (count >= max_count) {
-            ESP_LOGW(TAG, "Scene limit reached (%d), ignoring remaining scenes", max_count);
+        if (count >= SCENE_STORAGE_MAX_SCENES) {
+            ESP_LOGW(TAG, "Scene limit reached (%d), ignoring remaining scenes", SCENE_STORAGE_MAX_SCENES);
             break;
         }
         
@@ -124,86 +232,29 @@ esp_err_t scene_storage_load(ui_scene_t *scenes, size_t max_count, size_t *out_c
             continue;
         }
         
-        // Copy scene data
-        strncpy(scenes[count].name, name->valuestring, sizeof(scenes[count].name) - 1);
-        scenes[count].name[sizeof(scenes[count].name) - 1] = '\0';
-        scenes[count].brightness = (uint8_t)brightness->valueint;
-        scenes[count].red = (uint8_t)r->valueint;
-        scenes[count].green = (uint8_t)g->valueint;
-        scenes[count].blue = (uint8_t)b->valueint;
-        scenes[count].white = (uint8_t)w->valueint;
+        set_scene(&s_scenes[count], name->valuestring, (uint8_t)brightness->valueint,
+                  (uint8_t)r->valueint, (uint8_t)g->valueint,
+                  (uint8_t)b->valueint, (uint8_t)w->valueint);
         
         ESP_LOGI(TAG, "Loaded scene '%s': B=%d R=%d G=%d B=%d W=%d",
-                 scenes[count].name, scenes[count].brightness,
-                 scenes[count].red, scenes[count].green,
-                 scenes[count].blue, scenes[count].white);
+                 s_scenes[count].name, s_scenes[count].brightness,
+                 s_scenes[count].red, s_scenes[count].green,
+                 s_scenes[count].blue, s_scenes[count].white);
         
         count++;
     }
     
     cJSON_Delete(root);
-    *out_count = count;
-    
-    // Update cache
-    memcpy(s_scenes, scenes, count * sizeof(ui_scene_t));
     s_scene_count = count;
     
     return ESP_OK;
 }
 
 /**
- * @brief Save a new scene to SD card
+ * @brief Serialize the scenes array and write it to the flash store (or SD)
  */
-esp_err_t scene_storage_save(const char *name, uint8_t brightness,
-                             uint8_t red, uint8_t green, uint8_t blue, uint8_t white)
+static esp_err_t write_scenes(const ui_scene_t *scenes, size_t count)
 {
-    if (!name || strlen(name) == 0) {
-        return ESP_ERR_INVALID_ARG;
-    }
-    
-    ESP_LOGI(TAG, "Saving scene '%s': B=%d R=%d G=%d B=%d W=%d",
-             name, brightness, red, green, blue, white);
-    
-    // Load existing scenes
-    ui_scene_t scenes[SCENE_STORAGE_MAX_SCENES];
-    size_t count = 0;
-    scene_storage_load(scenes, SCENE_STORAGE_MAX_SCENES, &count);
-    
-    // Check if scene with same name exists (update) or add new
-    int existing_idx = -1;
-    for (size_t i = 0; i < count; i++) {
-        if (strcmp(scenes[i].name, name) == 0) {
-            existing_idx = i;
-            break;
-        }
-    }
-    
-    if (existing_idx >= 0) {
-        // Update existing scene
-        scenes[existing_idx].brightness = brightness;
-        scenes[existing_idx].red = red;
-        scenes[existing_idx].green = green;
-        scenes[existing_idx].blue = blue;
-        scenes[existing_idx].white = white;
-        ESP_LOGI(TAG, "Updated existing scene at index %d", existing_idx);
-    } else {
-        // Add new scene
-        if (count >= SCENE_STORAGE_MAX_SCENES) {
-            ESP_LOGE(TAG, "Scene limit reached, cannot add new scene");
-            return ESP_ERR_NO_MEM;
-        }
-        strncpy(scenes[count].name, name, sizeof(scenes[count].name) - 1);
-        scenes[count].name[sizeof(scenes[count].name) - 1] = '\0';
-        scenes[count].brightness = brightness;
-        scenes[count].red = red;
-        scenes[count].green = green;
-        scenes[count].blue = blue;
-        scenes[count].white = white;
-        count++;
-        ESP_LOGI(TAG, "Added new scene at index %d", (int)(count - 1));
-    }
-    
-    // Build JSON
     cJSON *root = cJSON_CreateObject();
     cJSON *scenes_array = cJSON_CreateArray();
     
@@ -218,9 +269,9 @@ esp_err_t scene_storage_save(const char *name, uint8_t brightness,
         cJSON_AddItemToArray(scenes_array, scene_obj);
     }
     
+    cJSON_AddNumberToObject(root, "version", 1);
     cJSON_AddItemToObject(root, "scenes", scenes_array);
     
-    // Write directly to scenes.json (FAT doesn't support atomic rename well)
     char *json_str = cJSON_Print(root);
     cJSON_Delete(root);
     
@@ -229,256 +280,242 @@ esp_err_t scene_storage_save(const char *name, uint8_t brightness,
         return ESP_FAIL;
     }
     
-    FILE *file = fopen(SCENE_STORAGE_PATH, "w");
-    if (!file) {
-        ESP_LOGE(TAG, "Failed to open scenes.json for writing");
-        free(json_str);
-        return ESP_FAIL;
-    }
-    
     size_t json_len = strlen(json_str);
-    size_t written = fwrite(json_str, 1, json_len, file);
-    fflush(file);  // Ensure data is written to SD card
-    fclose(file);
-    free(json_str);
-    
-    if (written != json_len) {
-        ESP_LOGE(TAG, "Failed to write complete JSON (wrote %d of %d)", written, json_len);
-        return ESP_FAIL;
+    esp_err_t ret;
+    if (flash_store_is_available()) {
+        ret = flash_store_write(FLASH_STORE_SCENES, json_str, json_len);
+    } else {
+        // Write to scenes.json.tmp, fsync, then rename over scenes.json
+        ret = waveshare_sd_write_file_atomic(SCENE_STORAGE_PATH, json_str, json_len);
     }
+    cJSON_free(json_str);
     
-    ESP_LOGI(TAG, "Wrote %d bytes to %s", json_len, SCENE_STORAGE_PATH);
-    
-    // Update cache
-    memcpy(s_scenes, scenes, count * sizeof(ui_scene_t));
-    s_scene_count = count;
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to write scenes.json: %s", esp_err_to_name(ret));
+        return ret;
+    }
     
-    ESP_LOGI(TAG, "Scene saved successfully, total scenes: %d", count);
+    ESP_LOGI(TAG, "Wrote %d bytes of scenes to %s", (int)json_len,
+             flash_store_is_available() ? "flash" : "SD card");
     return ESP_OK;
 }
 
 /**
- * @brief Delete a scene by name
+ * @brief SD worker job - persist a snapshot of the store
+ * 
+ * Runs on the SD worker task. Coalesced, so a burst of edits produces a
+ * single write of the latest state.
  */
-esp_err_t scene_storage_delete(const char *name)
+static esp_err_t persist_job(void *arg)
 {
-    if (!name || strlen(name) == 0) {
-        return ESP_ERR_INVALID_ARG;
-    }
-    
-    // Load existing scenes
-    ui_scene_t scenes[SCENE_STORAGE_MAX_SCENES];
-    size_t count = 0;
-    scene_storage_load(scenes, SCENE_STORAGE_MAX_SCENES, &count);
-    
-    // Find and remove scene
-    int found_idx = -1;
-    for (size_t i = 0; i < count; i++) {
-        if (strcmp(scenes[i].name, name) == 0) {
-            found_idx = i;
-            break;
-        }
-    }
-    
-    if (found_idx < 0) {
-        ESP_LOGW(TAG, "Scene '%s' not found", name);
-        return ESP_ERR_NOT_FOUND;
-    }
-    
-    // Shift remaining scenes
-    for (size_t i = found_idx; i < count - 1; i++) {
-        scenes[i] = scenes[i + 1];
-    }
-    count--;
-    
-    // Build and save JSON (same as save function)
-    cJSON *root = cJSON_CreateObject();
-    cJSON *scenes_array = cJSON_CreateArray();
-    
-    for (size_t i = 0; i < count; i++) {
-        cJSON *scene_obj = cJSON_CreateObject();
-        cJSON_AddStringToObject(scene_obj, "name", scenes[i].name);
-        cJSON_AddNumberToObject(scene_obj, "brightness", scenes[i].brightness);
-        cJSON_AddNumberToObject(scene_obj, "r", scenes[i].red);
-        cJSON_AddNumberToObject(scene_obj, "g", scenes[i].green);
-        cJSON_AddNumberToObject(scene_obj, "b", scenes[i].blue);
-        cJSON_AddNumberToObject(scene_obj, "w", scenes[i].white);
-        cJSON_AddItemToArray(scenes_array, scene_obj);
-    }
-    
-    cJSON_AddItemToObject(root, "scenes", scenes_array);
-    
-    char *json_str = cJSON_Print(root);
-    cJSON_Delete(root);
-    
-    if (!json_str) {
-        return ESP_FAIL;
-    }
-    
-    FILE *file = fopen(SCENE_STORAGE_PATH, "w");
-    if (!file) {
-        free(json_str);
-        return ESP_FAIL;
-    }
-    
-    fwrite(json_str, 1, strlen(json_str), file);
-    fclose(file);
-    free(json_str);
+    static ui_scene_t snapshot[SCENE_STORAGE_MAX_SCENES];
     
-    // Update cache
-    memcpy(s_scenes, scenes, count * sizeof(ui_scene_t));
-    s_scene_count = count;
+    cache_lock();
+    size_t count = s_scene_count;
+    memcpy(snapshot, s_scenes, count * sizeof(ui_scene_t));
+    cache_unlock();
     
-    ESP_LOGI(TAG, "Scene '%s' deleted, remaining: %d", name, count);
-    return ESP_OK;
+    json_arena_begin();
+    esp_err_t ret = write_scenes(snapshot, count);
+    json_arena_end();
+    return ret;
 }
 
 /**
- * @brief Get the number of stored scenes
+ * @brief Persist completion - runs in LVGL context
  */
-size_t scene_storage_get_count(void)
+static void persist_done_cb(esp_err_t result, void *user_ctx)
 {
-    return s_scene_count;
+    if (result != ESP_OK) {
+        // The store keeps the change; the next mutation rewrites the whole file
+        ESP_LOGE(TAG, "Failed to persist scenes: %s", esp_err_to_name(result));
+    }
 }
 
 /**
- * @brief Get the first scene (for auto-apply on boot)
+ * @brief Queue a background write of the store
  */
-esp_err_t scene_storage_get_first(ui_scene_t *scene)
+static void persist_async(void)
 {
-    if (!scene) {
-        return ESP_ERR_INVALID_ARG;
-    }
-    
-    if (s_scene_count == 0) {
-        return ESP_ERR_NOT_FOUND;
+    esp_err_t ret = sd_worker_submit(persist_job, NULL, true, persist_done_cb, NULL);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to queue scene write: %s", esp_err_to_name(ret));
     }
-    
-    *scene = s_scenes[0];
-    return ESP_OK;
 }
 
 /**
- * @brief Reload scenes and update UI
+ * @brief Initialize scene storage module
  */
-void scene_storage_reload_ui(void)
+esp_err_t scene_storage_init(void)
 {
-    ESP_LOGI(TAG, "scene_storage_reload_ui called");
-    
-    ui_scene_t scenes[SCENE_STORAGE_MAX_SCENES];
-    size_t count = 0;
+    ESP_LOGI(TAG, "Initializing scene storage");
     
-    esp_err_t ret = scene_storage_load(scenes, SCENE_STORAGE_MAX_SCENES, &count);
-    ESP_LOGI(TAG, "scene_storage_load returned %s, count=%d", esp_err_to_name(ret), count);
+    if (!s_cache_mutex) {
+        s_cache_mutex = xSemaphoreCreateMutex();
+        if (!s_cache_mutex) {
+            ESP_LOGE(TAG, "Failed to create cache mutex");
+            return ESP_ERR_NO_MEM;
+        }
+    }
     
-    // Lock LVGL before modifying UI (LVGL is not thread-safe)
-    ui_lock();
+    cache_lock();
+    json_arena_begin();
+    esp_err_t ret = load_scenes();
+    json_arena_end();
+    if (ret != ESP_OK) {
+        s_scene_count = 0;
+    }
+    cache_unlock();
     
     if (ret == ESP_OK) {
-        ESP_LOGI(TAG, "Calling ui_scenes_load_from_sd with %d scenes", count);
-        ui_scenes_load_from_sd(scenes, count);
-        ESP_LOGI(TAG, "UI updated with %d scenes", count);
+        ESP_LOGI(TAG, "Loaded %d scenes from %s", s_scene_count,
+                 flash_store_is_available() ? "flash" : "SD card");
     } else {
-        ESP_LOGW(TAG, "Failed to reload scenes for UI: %s", esp_err_to_name(ret));
-        ui_scenes_load_from_sd(NULL, 0);
+        ESP_LOGW(TAG, "Failed to load scenes: %s", esp_err_to_name(ret));
     }
     
-    ui_unlock();
+    notify_observers(SCENE_CHANGE_RELOADED, 0, 0, NULL);
+    return ESP_OK;
 }
 
-/**
- * @brief Reload scenes and update UI (no mutex - call from LVGL context only)
- * 
- * Use this when already running inside an LVGL callback to avoid deadlock.
- */
-void scene_storage_reload_ui_no_lock(void)
+esp_err_t scene_storage_add_observer(scene_storage_observer_t observer, void *user_ctx)
 {
-    ESP_LOGI(TAG, "scene_storage_reload_ui_no_lock called");
-    
-    ui_scene_t scenes[SCENE_STORAGE_MAX_SCENES];
-    size_t count = 0;
+    if (!observer) {
+        return ESP_ERR_INVALID_ARG;
+    }
     
-    esp_err_t ret = scene_storage_load(scenes, SCENE_STORAGE_MAX_SCENES, &count);
-    ESP_LOGI(TAG, "scene_storage_load returned %s, count=%d", esp_err_to_name(ret), count);
+    for (size_t i = 0; i < SCENE_STORAGE_MAX_OBSERVERS; i++) {
+        if (s_observers[i].cb == NULL) {
+            s_observers[i].cb = observer;
+            s_observers[i].user_ctx = user_ctx;
+            return ESP_OK;
+        }
+    }
     
-    // No lock - caller must already be in LVGL context
-    if (ret == ESP_OK) {
-        ESP_LOGI(TAG, "Calling ui_scenes_load_from_sd with %d scenes", count);
-        ui_scenes_load_from_sd(scenes, count);
-        ESP_LOGI(TAG, "UI updated with %d scenes", count);
-    } else {
-        ESP_LOGW(TAG, "Failed to reload scenes for UI: %s", esp_err_to_name(ret));
-        ui_scenes_load_from_sd(NULL, 0);
+    ESP_LOGE(TAG, "Observer table full");
+    return ESP_ERR_NO_MEM;
+}
+
+void scene_storage_remove_observer(scene_storage_observer_t observer)
+{
+    for (size_t i = 0; i < SCENE_STORAGE_MAX_OBSERVERS; i++) {
+        if (s_observers[i].cb == observer) {
+            s_observers[i].cb = NULL;
+            s_observers[i].user_ctx = NULL;
+        }
     }
 }
 
 /**
- * @brief Get a scene by index
+ * @brief Save a new scene
  */
-esp_err_t scene_storage_get_by_index(size_t index, ui_scene_t *scene)
+esp_err_t scene_storage_save(const char *name, uint8_t brightness,
+                             uint8_t red, uint8_t green, uint8_t blue, uint8_t white)
 {
-    if (!scene) {
+    if (!name || strlen(name) == 0) {
         return ESP_ERR_INVALID_ARG;
     }
     
-    if (index >= s_scene_count) {
-        return ESP_ERR_INVALID_ARG;
+    ESP_LOGI(TAG, "Saving scene '%s': B=%d R=%d G=%d B=%d W=%d",
+             name, brightness, red, green, blue, white);
+    
+    cache_lock();
+    
+    // Check if scene with same name exists (update) or add new
+    int existing_idx = find_scene(name);
+    scene_change_type_t type;
+    size_t index;
+    
+    if (existing_idx >= 0) {
+        // Update existing scene
+        type = SCENE_CHANGE_UPDATED;
+        index = existing_idx;
+        ESP_LOGI(TAG, "Updating existing scene at index %d", existing_idx);
+    } else {
+        // Add new scene
+        if (s_scene_count >= SCENE_STORAGE_MAX_SCENES) {
+            cache_unlock();
+            ESP_LOGE(TAG, "Scene limit reached, cannot add new scene");
+            return ESP_ERR_NO_MEM;
+        }
+        type = SCENE_CHANGE_ADDED;
+        index = s_scene_count++;
+        ESP_LOGI(TAG, "Adding new scene at index %d", (int)index);
     }
     
-    *scene = s_scenes[index];
+    set_scene(&s_scenes[index], name, brightness, red, green, blue, white);
+    ui_scene_t saved = s_scenes[index];
+    cache_unlock();
+    
+    notify_observers(type, index, index, &saved);
+    persist_async();
+    
+    ESP_LOGI(TAG, "Scene saved, total scenes: %d", s_scene_count);
     return ESP_OK;
 }
 
 /**
- * @brief Helper function to write scenes array to JSON file
+ * @brief Delete a scene by name
  */
-static esp_err_t write_scenes_to_file(const ui_scene_t *scenes, size_t count)
+esp_err_t scene_storage_delete(const char *name)
 {
-    cJSON *root = cJSON_CreateObject();
-    cJSON *scenes_array = cJSON_CreateArray();
-    
-    for (size_t i = 0; i < count; i++) {
-        cJSON *scene_obj = cJSON_CreateObject();
-        cJSON_AddStringToObject(scene_obj, "name", scenes[i].name);
-        cJSON_AddNumberToObject(scene_obj, "brightness", scenes[i].brightness);
-        cJSON_AddNumberToObject(scene_obj, "r", scenes[i].red);
-        cJSON_AddNumberToObject(scene_obj, "g", scenes[i].green);
-        cJSON_AddNumberToObject(scene_obj, "b", scenes[i].blue);
-        cJSON_AddNumberToObject(scene_obj, "w", scenes[i].white);
-        cJSON_AddItemToArray(scenes_array, scene_obj);
+    if (!name || strlen(name) == 0) {
+        return ESP_ERR_INVALID_ARG;
     }
     
-    cJSON_AddNumberToObject(root, "version", 1);
-    cJSON_AddItemToObject(root, "scenes", scenes_array);
-    
-    char *json_str = cJSON_Print(root);
-    cJSON_Delete(root);
-    
-    if (!json_str) {
-        ESP_LOGE(TAG, "Failed to serialize JSON");
-        return ESP_FAIL;
+    cache_lock();
+    int found_idx = find_scene(name);
+    if (found_idx < 0) {
+        cache_unlock();
+        ESP_LOGW(TAG, "Scene '%s' not found", name);
+        return ESP_ERR_NOT_FOUND;
     }
     
-    FILE *file = fopen(SCENE_STORAGE_PATH, "w");
-    if (!file) {
-        ESP_LOGE(TAG, "Failed to open scenes.json for writing");
-        free(json_str);
-        return ESP_FAIL;
-    }
+    ui_scene_t removed = s_scenes[found_idx];
+    move_scene(found_idx, s_scene_count - 1);
+    s_scene_count--;
+    cache_unlock();
     
-    size_t json_len = strlen(json_str);
-    size_t written = fwrite(json_str, 1, json_len, file);
-    fflush(file);
-    fclose(file);
-    free(json_str);
+    notify_observers(SCENE_CHANGE_REMOVED, found_idx, found_idx, &removed);
+    persist_async();
     
-    if (written != json_len) {
-        ESP_LOGE(TAG, "Failed to write complete JSON (wrote %d of %d)", (int)written, (int)json_len);
-        return ESP_FAIL;
+    ESP_LOGI(TAG, "Scene '%s' deleted, remaining: %d", name, s_scene_count);
+    return ESP_OK;
+}
+
+/**
+ * @brief Get the number of stored scenes
+ */
+size_t scene_storage_get_count(void)
+{
+    return s_scene_count;
+}
+
+/**
+ * @brief Get the first scene (for auto-apply on boot)
+ */
+esp_err_t scene_storage_get_first(ui_scene_t *scene)
+{
+    return scene_storage_get_by_index(0, scene) == ESP_OK ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+/**
+ * @brief Get a scene by index
+ */
+esp_err_t scene_storage_get_by_index(size_t index, ui_scene_t *scene)
+{
+    if (!scene) {
+        return ESP_ERR_INVALID_ARG;
     }
     
-    ESP_LOGI(TAG, "Wrote %d bytes to %s", (int)json_len, SCENE_STORAGE_PATH);
-    return ESP_OK;
+    esp_err_t ret = ESP_ERR_INVALID_ARG;
+    cache_lock();
+    if (index < s_scene_count) {
+        *scene = s_scenes[index];
+        ret = ESP_OK;
+    }
+    cache_unlock();
+    return ret;
 }
 
 /**
@@ -492,40 +529,31 @@ esp_err_t scene_storage_update(size_t index, const char *new_name,
         return ESP_ERR_INVALID_ARG;
     }
     
+    cache_lock();
+    
     if (index >= s_scene_count) {
+        cache_unlock();
         ESP_LOGE(TAG, "Invalid scene index %d (count=%d)", (int)index, (int)s_scene_count);
         return ESP_ERR_INVALID_ARG;
     }
     
     // Check if new name conflicts with another scene (not this one)
-    for (size_t i = 0; i < s_scene_count; i++) {
-        if (i != index && strcmp(s_scenes[i].name, new_name) == 0) {
-            ESP_LOGE(TAG, "Scene name '%s' already exists at index %d", new_name, (int)i);
-            return ESP_ERR_INVALID_STATE;
-        }
+    int existing_idx = find_scene(new_name);
+    if (existing_idx >= 0 && (size_t)existing_idx != index) {
+        cache_unlock();
+        ESP_LOGE(TAG, "Scene name '%s' already exists at index %d", new_name, existing_idx);
+        return ESP_ERR_INVALID_STATE;
     }
     
     ESP_LOGI(TAG, "Updating scene at index %d: '%s' -> '%s', B=%d R=%d G=%d B=%d W=%d",
              (int)index, s_scenes[index].name, new_name, brightness, red, green, blue, white);
     
-    // Update in cache
-    strncpy(s_scenes[index].name, new_name, sizeof(s_scenes[index].name) - 1);
-    s_scenes[index].name[sizeof(s_scenes[index].name) - 1] = '\0';
-    s_scenes[index].brightness = brightness;
-    s_scenes[index].red = red;
-    s_scenes[index].green = green;
-    s_scenes[index].blue = blue;
-    s_scenes[index].white = white;
-    
-    // Write to file
-    esp_err_t ret = write_scenes_to_file(s_scenes, s_scene_count);
-    if (ret != ESP_OK) {
-        // Reload from file to restore consistent state
-        scene_storage_load(s_scenes, SCENE_STORAGE_MAX_SCENES, &s_scene_count);
-        return ret;
-    }
+    set_scene(&s_scenes[index], new_name, brightness, red, green, blue, white);
+    ui_scene_t updated = s_scenes[index];
+    cache_unlock();
     
-    ESP_LOGI(TAG, "Scene updated successfully");
+    notify_observers(SCENE_CHANGE_UPDATED, index, index, &updated);
+    persist_async();
     return ESP_OK;
 }
 
@@ -534,44 +562,27 @@ esp_err_t scene_storage_update(size_t index, const char *new_name,
  */
 esp_err_t scene_storage_reorder(size_t from_index, size_t to_index)
 {
+    cache_lock();
+    
     if (from_index >= s_scene_count || to_index >= s_scene_count) {
+        cache_unlock();
         ESP_LOGE(TAG, "Invalid reorder indices: from=%d, to=%d (count=%d)",
                  (int)from_index, (int)to_index, (int)s_scene_count);
         return ESP_ERR_INVALID_ARG;
     }
     
     if (from_index == to_index) {
+        cache_unlock();
         return ESP_OK;  // Nothing to do
     }
     
     ESP_LOGI(TAG, "Reordering scene from index %d to %d", (int)from_index, (int)to_index);
     
-    // Save the scene being moved
-    ui_scene_t moving_scene = s_scenes[from_index];
-    
-    if (from_index < to_index) {
-        // Moving forward: shift items left
-        for (size_t i = from_index; i < to_index; i++) {
-            s_scenes[i] = s_scenes[i + 1];
-        }
-    } else {
-        // Moving backward: shift items right
-        for (size_t i = from_index; i > to_index; i--) {
-            s_scenes[i] = s_scenes[i - 1];
-        }
-    }
-    
-    // Place the scene at new position
-    s_scenes[to_index] = moving_scene;
-    
-    // Write to file
-    esp_err_t ret = write_scenes_to_file(s_scenes, s_scene_count);
-    if (ret != ESP_OK) {
-        // Reload from file to restore consistent state
-        scene_storage_load(s_scenes, SCENE_STORAGE_MAX_SCENES, &s_scene_count);
-        return ret;
-    }
+    move_scene(from_index, to_index);
+    ui_scene_t moved = s_scenes[to_index];
+    cache_unlock();
     
-    ESP_LOGI(TAG, "Scene reordered successfully");
+    notify_observers(SCENE_CHANGE_MOVED, to_index, from_index, &moved);
+    persist_async();
     return ESP_OK;
 }
@@ -1,6 +1,13 @@
 /**
  * @file scene_storage.h
- * @brief Scene storage module - load/save scenes from/to SD card
+ * @brief Scene storage module - in-memory scene store persisted to flash
+ * 
+ * The in-memory cache is the single source of truth for scenes. The stored
+ * copy (flash store, or the SD card without a store partition) is read once
+ * by scene_storage_init() and afterwards only written, in the background by
+ * the SD worker task (see sd_worker.h and flash_store.h). Every mutation
+ * notifies registered observers with a fine-grained change description so
+ * the UI can update only the affected cards.
  */
 
 #pragma once
@@ -15,30 +22,73 @@ extern "C" {
 #endif
 
 #define SCENE_STORAGE_MAX_SCENES    32
+#define SCENE_STORAGE_MAX_OBSERVERS 4
 #define SCENE_STORAGE_PATH          "/sdcard/scenes.json"
+#define SCENE_STORAGE_TMP_PATH      SCENE_STORAGE_PATH ".tmp"
+
+/**
+ * @brief Kind of change made to the scene store
+ */
+typedef enum {
+    SCENE_CHANGE_ADDED,     ///< Scene inserted at index
+    SCENE_CHANGE_REMOVED,   ///< Scene removed from index
+    SCENE_CHANGE_MOVED,     ///< Scene moved from from_index to index
+    SCENE_CHANGE_UPDATED,   ///< Scene at index changed (name and/or values)
+    SCENE_CHANGE_RELOADED,  ///< Whole store replaced (initial load)
+} scene_change_type_t;
+
+/**
+ * @brief Change notification passed to observers
+ */
+typedef struct {
+    scene_change_type_t type;   ///< Kind of change
+    size_t index;               ///< Affected index (after the change; before it for REMOVED)
+    size_t from_index;          ///< Previous index (MOVED only)
+    size_t count;               ///< Scene count after the change
+    ui_scene_t scene;           ///< Scene data (ADDED, UPDATED, MOVED, REMOVED)
+} scene_change_t;
+
+/**
+ * @brief Observer callback
+ * 
+ * Called synchronously from the task that made the change, after the
+ * in-memory store has been updated. Scene mutations are made from LVGL
+ * context, so observers may touch LVGL objects directly.
+ */
+typedef void (*scene_storage_observer_t)(const scene_change_t *change, void *user_ctx);
 
 /**
  * @brief Initialize scene storage module
  * 
- * @return esp_err_t ESP_OK on success
+ * Reads scenes.json once into the in-memory store. This is the only time
+ * the file is read.
+ * 
+ * @return esp_err_t ESP_OK on success (an empty store if the file is missing)
  */
 esp_err_t scene_storage_init(void);
 
 /**
- * @brief Load scenes from SD card
+ * @brief Register a change observer
  * 
- * @param scenes Output array to store loaded scenes
- * @param max_count Maximum number of scenes to load
- * @param out_count Output: actual number of scenes loaded
- * @return esp_err_t ESP_OK on success
+ * @param observer Callback to invoke on every change
+ * @param user_ctx Opaque pointer passed back to the callback
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NO_MEM if the table is full
  */
-esp_err_t scene_storage_load(ui_scene_t *scenes, size_t max_count, size_t *out_count);
+esp_err_t scene_storage_add_observer(scene_storage_observer_t observer, void *user_ctx);
 
 /**
- * @brief Save a new scene to SD card
+ * @brief Unregister a change observer
  * 
- * Appends the scene to the existing scenes.json file.
- * If a scene with the same name exists, it will be updated.
+ * @param observer Callback previously passed to scene_storage_add_observer()
+ */
+void scene_storage_remove_observer(scene_storage_observer_t observer);
+
+/**
+ * @brief Save a new scene
+ * 
+ * Appends the scene to the store. If a scene with the same name exists,
+ * it will be updated in place. The store is updated immediately; the
+ * persistent write is queued on the SD worker and coalesced with other edits.
  * 
  * @param name Scene name
  * @param brightness Brightness value (0-255)
@@ -48,7 +98,7 @@ esp_err_t scene_storage_load(ui_scene_t *scenes, size_t max_count, size_t *out_c
  * @param white White value (0-255)
  * @return esp_err_t ESP_OK on success
  */
-esp_err_t scene_storage_save(const char *name, uint8_t brightness, 
+esp_err_t scene_storage_save(const char *name, uint8_t brightness,
                              uint8_t red, uint8_t green, uint8_t blue, uint8_t white);
 
 /**
@@ -74,20 +124,6 @@ size_t scene_storage_get_count(void);
  */
 esp_err_t scene_storage_get_first(ui_scene_t *scene);
 
-/**
- * @brief Reload scenes and update UI
- * 
- * Convenience function to reload scenes from SD and update the scene list UI
- */
-void scene_storage_reload_ui(void);
-
-/**
- * @brief Reload scenes and update UI (no mutex - call from LVGL context only)
- * 
- * Use this when already running inside an LVGL callback to avoid deadlock.
- */
-void scene_storage_reload_ui_no_lock(void);
-
 /**
  * @brief Update an existing scene's properties
  * 
@@ -5,26 +5,26 @@
  * Implements automatic screen timeout with touch-to-wake functionality
  * for power saving when the device is idle. Features a smooth 1-second
  * fade-to-black transition before turning off the backlight.
+ * 
+ * The fade dims the framebuffer itself (ui_dim_to()) instead of blending
+ * a black overlay over the UI, so LVGL does not redraw during it. While the
+ * backlight is off the power_save module pauses LVGL and lowers the CPU
+ * frequency; a touch posts the fade-in straight to the LVGL task.
  */
 
 #include "screen_timeout.h"
+#include "power_save.h"
 #include "esp_log.h"
 #include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
-#include "lvgl.h"
 #include "ui/ui_common.h"
 
 static const char *TAG = "screen_timeout";
 
-/// Fade animation duration in milliseconds
+/// Fade duration in milliseconds
 #define FADE_DURATION_MS    1000
 
-/// Number of discrete opacity steps for fade animation
-/// Using fewer steps that align with frame boundaries reduces banding
-/// At 60fps, 1000ms = 60 frames. 20 steps = opacity change every 3 frames
-#define FADE_OPACITY_STEPS  20
-
 /// Screen state machine
 typedef enum {
     SCREEN_STATE_ACTIVE,        ///< Screen is on and active
@@ -33,9 +33,9 @@ typedef enum {
     SCREEN_STATE_FADING_IN,     ///< Fading in after wake
 } screen_state_t;
 
-// Forward declarations for animation callbacks
-static void fade_out_complete_cb(lv_anim_t *anim);
-static void fade_in_complete_cb(lv_anim_t *anim);
+// Forward declarations for dimming callbacks
+static void fade_out_complete_cb(void);
+static void fade_in_complete_cb(void);
 
 /// Module state
 static struct {
@@ -45,9 +45,8 @@ static struct {
     screen_state_t state;           ///< Current screen state
     bool initialized;               ///< Module initialized flag
     SemaphoreHandle_t mutex;        ///< Thread safety mutex
-    lv_obj_t *fade_overlay;         ///< Black overlay for fade effect
-    lv_anim_t fade_anim;            ///< Fade animation
     bool pending_wake;              ///< Touch occurred during fade-out or when off
+    int64_t wake_request_us;        ///< Touch that woke the screen from off (0 = none)
 } s_state = {
     .ch422g = NULL,
     .timeout_sec = SCREEN_TIMEOUT_DEFAULT_SEC,
@@ -55,8 +54,8 @@ static struct {
     .state = SCREEN_STATE_ACTIVE,
     .initialized = false,
     .mutex = NULL,
-    .fade_overlay = NULL,
     .pending_wake = false,
+    .wake_request_us = 0,
 };
 
 /**
@@ -81,149 +80,113 @@ static esp_err_t backlight_off(void)
     return ch422g_backlight_off(s_state.ch422g);
 }
 
-/**
- * @brief Animation callback - sets overlay opacity using stepped values
- * Uses discrete steps to reduce banding artifacts caused by mid-frame opacity changes.
- * The stepped approach ensures opacity only changes at specific intervals,
- * giving the display time to complete full frames at each opacity level.
- */
-static void fade_anim_cb(void *obj, int32_t value)
-{
-    if (s_state.fade_overlay != NULL) {
-        // Quantize to discrete steps to reduce banding
-        // This ensures opacity changes happen less frequently, allowing
-        // complete frames to render at each opacity level
-        int step = (value * FADE_OPACITY_STEPS) / LV_OPA_COVER;
-        lv_opa_t stepped_opa = (step * LV_OPA_COVER) / FADE_OPACITY_STEPS;
-        lv_obj_set_style_bg_opa(s_state.fade_overlay, stepped_opa, 0);
-    }
-}
-
 /**
  * @brief Fade-out complete callback
- * Called from LVGL context when fade-out animation finishes
+ * Called from LVGL context when the screen has dimmed to black
  */
-static void fade_out_complete_cb(lv_anim_t *anim)
+static void fade_out_complete_cb(void)
 {
-    ESP_LOGI(TAG, "Fade-out complete, turning off backlight");
-    
     // Check if a wake was requested during the fade
     if (s_state.pending_wake) {
         s_state.pending_wake = false;
         ESP_LOGI(TAG, "Wake requested during fade-out, waking immediately");
-        // Start fade-in instead
         s_state.state = SCREEN_STATE_FADING_IN;
-        
-        lv_anim_init(&s_state.fade_anim);
-        lv_anim_set_var(&s_state.fade_anim, s_state.fade_overlay);
-        lv_anim_set_exec_cb(&s_state.fade_anim, fade_anim_cb);
-        lv_anim_set_values(&s_state.fade_anim, LV_OPA_COVER, LV_OPA_TRANSP);
-        lv_anim_set_time(&s_state.fade_anim, FADE_DURATION_MS);
-        lv_anim_set_ready_cb(&s_state.fade_anim, fade_in_complete_cb);
-        lv_anim_start(&s_state.fade_anim);
+        // Cannot fail here: the snapshot was allocated for the fade-out
+        ui_dim_to(UI_DIM_LEVEL_MAX, FADE_DURATION_MS, fade_in_complete_cb);
         return;
     }
     
-    // Turn off backlight
+    ESP_LOGI(TAG, "Fade-out complete, turning off backlight");
     backlight_off();
     s_state.state = SCREEN_STATE_OFF;
-    
-    // Hide overlay (it's fully opaque now, but hidden saves resources)
-    if (s_state.fade_overlay != NULL) {
-        lv_obj_add_flag(s_state.fade_overlay, LV_OBJ_FLAG_HIDDEN);
-    }
+    power_save_enter();
 }
 
 /**
  * @brief Fade-in complete callback
- * Called from LVGL context when fade-in animation finishes
+ * Called from LVGL context when the UI is back at full level
  */
-static void fade_in_complete_cb(lv_anim_t *anim)
+static void fade_in_complete_cb(void)
 {
     ESP_LOGI(TAG, "Fade-in complete");
     s_state.state = SCREEN_STATE_ACTIVE;
     
-    // Hide the fully transparent overlay
-    if (s_state.fade_overlay != NULL) {
-        lv_obj_add_flag(s_state.fade_overlay, LV_OBJ_FLAG_HIDDEN);
+    if (s_state.wake_request_us != 0) {
+        power_save_record_wake(ui_dim_get_first_frame_us() - s_state.wake_request_us);
+        s_state.wake_request_us = 0;
     }
 }
 
 /**
- * @brief Create the fade overlay object (must be called from LVGL context)
+ * @brief Start fade-out (must be called from LVGL context)
  */
-static void create_fade_overlay(void)
+static void start_fade_out(void)
 {
-    if (s_state.fade_overlay != NULL) {
-        return;  // Already created
-    }
-    
-    // Create full-screen black overlay on the top layer
-    lv_obj_t *layer = lv_layer_top();
-    s_state.fade_overlay = lv_obj_create(layer);
-    lv_obj_remove_style_all(s_state.fade_overlay);
-    lv_obj_set_size(s_state.fade_overlay, LV_PCT(100), LV_PCT(100));
-    lv_obj_set_pos(s_state.fade_overlay, 0, 0);
-    lv_obj_set_style_bg_color(s_state.fade_overlay, lv_color_black(), 0);
-    lv_obj_set_style_bg_opa(s_state.fade_overlay, LV_OPA_TRANSP, 0);
-    lv_obj_clear_flag(s_state.fade_overlay, LV_OBJ_FLAG_CLICKABLE);
-    lv_obj_add_flag(s_state.fade_overlay, LV_OBJ_FLAG_HIDDEN);
+    ESP_LOGI(TAG, "Starting fade-out");
+    s_state.state = SCREEN_STATE_FADING_OUT;
+    s_state.pending_wake = false;
     
-    ESP_LOGI(TAG, "Fade overlay created");
+    if (ui_dim_to(0, FADE_DURATION_MS, fade_out_complete_cb) != ESP_OK) {
+        // No memory for the snapshot: switch off without the fade
+        fade_out_complete_cb();
+    }
 }
 
 /**
- * @brief Start fade-out animation (must be called from LVGL context)
+ * @brief Start fade-in (must be called from LVGL context)
  */
-static void start_fade_out(void)
+static void start_fade_in(void)
 {
-    if (s_state.fade_overlay == NULL) {
-        create_fade_overlay();
-    }
-    
-    ESP_LOGI(TAG, "Starting fade-out animation");
-    s_state.state = SCREEN_STATE_FADING_OUT;
+    ESP_LOGI(TAG, "Starting fade-in");
+    s_state.state = SCREEN_STATE_FADING_IN;
     s_state.pending_wake = false;
+    power_save_exit();
     
-    // Show overlay and start animation
-    lv_obj_clear_flag(s_state.fade_overlay, LV_OBJ_FLAG_HIDDEN);
-    lv_obj_set_style_bg_opa(s_state.fade_overlay, LV_OPA_TRANSP, 0);
-    
-    lv_anim_init(&s_state.fade_anim);
-    lv_anim_set_var(&s_state.fade_anim, s_state.fade_overlay);
-    lv_anim_set_exec_cb(&s_state.fade_anim, fade_anim_cb);
-    lv_anim_set_values(&s_state.fade_anim, LV_OPA_TRANSP, LV_OPA_COVER);
-    lv_anim_set_time(&s_state.fade_anim, FADE_DURATION_MS);
-    lv_anim_set_ready_cb(&s_state.fade_anim, fade_out_complete_cb);
-    lv_anim_start(&s_state.fade_anim);
+    // The panel is still holding the black frame from the fade-out
+    backlight_on();
+    ui_dim_to(UI_DIM_LEVEL_MAX, FADE_DURATION_MS, fade_in_complete_cb);
 }
 
 /**
- * @brief Start fade-in animation (must be called from LVGL context)
+ * @brief ui_post() commands; the state is re-checked in LVGL context so a
+ * command posted twice before it runs only acts once
  */
-static void start_fade_in(void)
+static void fade_out_cmd(void *arg)
 {
-    if (s_state.fade_overlay == NULL) {
-        create_fade_overlay();
+    if (s_state.state == SCREEN_STATE_ACTIVE) {
+        start_fade_out();
+    }
+}
+
+static void fade_in_cmd(void *arg)
+{
+    if (s_state.state == SCREEN_STATE_OFF) {
+        start_fade_in();
+    }
+}
+
+static void restore_cmd(void *arg)
+{
+    power_save_exit();
+    ui_dim_to(UI_DIM_LEVEL_MAX, 0, NULL);
+}
+
+/**
+ * @brief Wake the screen (mutex held)
+ * 
+ * From off, the fade-in is posted to the LVGL task right away instead of
+ * on the next tick; the tick still posts it too, in case the queue was
+ * full. During a fade-out the flag turns its completion into a fade-in.
+ */
+static void request_wake(void)
+{
+    s_state.pending_wake = true;
+    if (s_state.state == SCREEN_STATE_OFF) {
+        if (s_state.wake_request_us == 0) {
+            s_state.wake_request_us = esp_timer_get_time();
+        }
+        ui_post(fade_in_cmd, NULL);
     }
-    
-    ESP_LOGI(TAG, "Starting fade-in animation");
-    s_state.state = SCREEN_STATE_FADING_IN;
-    
-    // Ensure backlight is on
-    backlight_on();
-    
-    // Show overlay at full opacity and fade out
-    lv_obj_clear_flag(s_state.fade_overlay, LV_OBJ_FLAG_HIDDEN);
-    lv_obj_set_style_bg_opa(s_state.fade_overlay, LV_OPA_COVER, 0);
-    
-    lv_anim_init(&s_state.fade_anim);
-    lv_anim_set_var(&s_state.fade_anim, s_state.fade_overlay);
-    lv_anim_set_exec_cb(&s_state.fade_anim, fade_anim_cb);
-    lv_anim_set_values(&s_state.fade_anim, LV_OPA_COVER, LV_OPA_TRANSP);
-    lv_anim_set_time(&s_state.fade_anim, FADE_DURATION_MS);
-    lv_anim_set_ready_cb(&s_state.fade_anim, fade_in_complete_cb);
-    lv_anim_start(&s_state.fade_anim);
 }
 
 esp_err_t screen_timeout_init(const screen_timeout_config_t *config)
@@ -248,15 +211,8 @@ esp_err_t screen_timeout_init(const screen_timeout_config_t *config)
     s_state.last_activity_us = esp_timer_get_time();
     s_state.state = SCREEN_STATE_ACTIVE;
     s_state.initialized = true;
-    s_state.fade_overlay = NULL;
     s_state.pending_wake = false;
     
-    // Create overlay in LVGL context
-    if (ui_lock()) {
-        create_fade_overlay();
-        ui_unlock();
-    }
-    
     ESP_LOGI(TAG, "Initialized with timeout=%u sec (0=disabled), fade=%dms", 
              s_state.timeout_sec, FADE_DURATION_MS);
     
@@ -269,15 +225,8 @@ void screen_timeout_deinit(void)
         return;
     }
     
-    // Delete overlay in LVGL context
-    if (ui_lock()) {
-        if (s_state.fade_overlay != NULL) {
-            lv_anim_del(s_state.fade_overlay, NULL);
-            lv_obj_del(s_state.fade_overlay);
-            s_state.fade_overlay = NULL;
-        }
-        ui_unlock();
-    }
+    // Leave the UI undimmed (in LVGL context)
+    ui_post(restore_cmd, NULL);
     
     if (s_state.mutex != NULL) {
         vSemaphoreDelete(s_state.mutex);
@@ -299,15 +248,15 @@ void screen_timeout_notify_activity(void)
         
         switch (s_state.state) {
             case SCREEN_STATE_OFF:
-                // Wake screen with fade-in - set flag for tick() to handle
+                // Wake screen with fade-in
                 ESP_LOGI(TAG, "Touch detected - waking screen");
-                s_state.pending_wake = true;
+                request_wake();
                 break;
                 
             case SCREEN_STATE_FADING_OUT:
                 // Abort fade-out, will transition to fade-in
                 ESP_LOGI(TAG, "Touch during fade-out - will wake");
-                s_state.pending_wake = true;
+                request_wake();
                 break;
                 
             case SCREEN_STATE_FADING_IN:
@@ -401,7 +350,7 @@ void screen_timeout_wake(void)
         if (s_state.state == SCREEN_STATE_OFF || 
             s_state.state == SCREEN_STATE_FADING_OUT) {
             ESP_LOGI(TAG, "Manual wake");
-            s_state.pending_wake = true;
+            request_wake();
         }
         
         xSemaphoreGive(s_state.mutex);
@@ -438,10 +387,7 @@ void screen_timeout_tick(void)
             xSemaphoreGive(s_state.mutex);
             
             // Start fade-in in LVGL context
-            if (ui_lock()) {
-                start_fade_in();
-                ui_unlock();
-            }
+            ui_post(fade_in_cmd, NULL);
             return;
         }
         
@@ -468,10 +414,7 @@ void screen_timeout_tick(void)
             xSemaphoreGive(s_state.mutex);
             
             // Start fade-out in LVGL context
-            if (ui_lock()) {
-                start_fade_out();
-                ui_unlock();
-            }
+            ui_post(fade_out_cmd, NULL);
             return;
         }
         
@@ -10,6 +10,7 @@
  * - Touch-to-wake restores backlight immediately
  * - Timeout can be disabled (set to 0)
  * - Thread-safe activity notification
+ * - CPU frequency scaling and a paused UI while off (power_save.h)
  * 
  * @see docs/SPEC.md for power saving requirements
  * @see lcc_config.hxx for CDI configuration
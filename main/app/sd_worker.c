@@ -0,0 +1,265 @@
+/**
+ * @file sd_worker.c
+ * @brief Background SD card worker task implementation
+ */
+
+#include "sd_worker.h"
+#include "../ui/ui_common.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+
+static const char *TAG = "sd_worker";
+
+#define SD_WORKER_QUEUE_LEN     16
+#define SD_WORKER_STACK_SIZE    4096
+
+// A full UI command ring is retried for up to 500 ms before a completion is dropped
+#define SD_WORKER_POST_RETRIES  50
+#define SD_WORKER_POST_RETRY_MS 10
+
+/**
+ * @brief Queued job request
+ */
+typedef struct {
+    sd_worker_job_fn_t job;
+    void *arg;
+    bool coalesce;
+    sd_worker_done_cb_t done;
+    void *user_ctx;
+} sd_request_t;
+
+/**
+ * @brief Completion handed to ui_post()
+ */
+typedef struct {
+    sd_worker_done_cb_t done;
+    void *user_ctx;
+    esp_err_t result;
+} sd_completion_t;
+
+static QueueHandle_t s_queue = NULL;
+static TaskHandle_t s_task = NULL;
+
+// Current batch (only touched by the worker task)
+static sd_request_t s_batch[SD_WORKER_QUEUE_LEN];
+static esp_err_t s_batch_result[SD_WORKER_QUEUE_LEN];
+
+/**
+ * @brief Runs in LVGL context via ui_post()
+ */
+static void completion_async_cb(void *param)
+{
+    sd_completion_t *completion = (sd_completion_t *)param;
+    completion->done(completion->result, completion->user_ctx);
+    free(completion);
+}
+
+/**
+ * @brief Hand a completion callback to LVGL context
+ * 
+ * Before ui_start() the callback may run on this task if it cannot be
+ * posted. Once the UI is up it only ever runs in LVGL context: a full
+ * command ring is retried while the LVGL task drains it, and a completion
+ * that still cannot be posted is dropped.
+ */
+static void dispatch_completion(const sd_request_t *req, esp_err_t result)
+{
+    if (!req->done) {
+        return;
+    }
+    
+    sd_completion_t *completion = malloc(sizeof(sd_completion_t));
+    const char *reason = "out of memory";
+    if (completion) {
+        completion->done = req->done;
+        completion->user_ctx = req->user_ctx;
+        completion->result = result;
+        for (int attempt = 0; attempt <= SD_WORKER_POST_RETRIES; attempt++) {
+            if (ui_post(completion_async_cb, completion)) {
+                return;
+            }
+            if (!ui_is_started()) {
+                break;
+            }
+            vTaskDelay(pdMS_TO_TICKS(SD_WORKER_POST_RETRY_MS));
+        }
+        free(completion);
+        reason = "UI queue full";
+    }
+    
+    if (!ui_is_started()) {
+        // No widgets are drawn yet, so this task may complete it instead
+        req->done(result, req->user_ctx);
+        return;
+    }
+    
+    ESP_LOGE(TAG, "Dropping completion for result %s (%s)", esp_err_to_name(result), reason);
+}
+
+/**
+ * @brief Run every job in the batch, coalescing duplicates
+ * 
+ * A coalescable job runs once, at the position of its first request. It
+ * reads current state when it runs, so it covers every request in the
+ * batch; later duplicates reuse its result.
+ */
+static void run_batch(size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        const sd_request_t *req = &s_batch[i];
+        bool merged = false;
+        
+        if (req->coalesce) {
+            for (size_t j = 0; j < i; j++) {
+                if (s_batch[j].coalesce && s_batch[j].job == req->job && s_batch[j].arg == req->arg) {
+                    s_batch_result[i] = s_batch_result[j];
+                    merged = true;
+                    break;
+                }
+            }
+        }
+        
+        if (!merged) {
+            int64_t start_us = esp_timer_get_time();
+            s_batch_result[i] = req->job(req->arg);
+            ESP_LOGD(TAG, "Job %p took %lld us", req->job, esp_timer_get_time() - start_us);
+            if (s_batch_result[i] != ESP_OK) {
+                ESP_LOGW(TAG, "Job %p failed: %s", req->job, esp_err_to_name(s_batch_result[i]));
+            }
+        }
+        
+        dispatch_completion(req, s_batch_result[i]);
+    }
+    
+    if (count > 1) {
+        ESP_LOGD(TAG, "Processed batch of %d requests", (int)count);
+    }
+}
+
+/**
+ * @brief SD worker task
+ */
+static void sd_worker_task(void *arg)
+{
+    ESP_LOGI(TAG, "SD worker task started");
+    
+    while (1) {
+        size_t count = 0;
+        if (xQueueReceive(s_queue, &s_batch[count], portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        count++;
+        
+        // Collect a burst: keep draining while coalescable requests keep
+        // arriving within the window
+        bool coalescing = s_batch[0].coalesce;
+        while (count < SD_WORKER_QUEUE_LEN) {
+            TickType_t wait = coalescing ? pdMS_TO_TICKS(CONFIG_SD_WORKER_COALESCE_MS) : 0;
+            if (xQueueReceive(s_queue, &s_batch[count], wait) != pdTRUE) {
+                break;
+            }
+            coalescing |= s_batch[count].coalesce;
+            count++;
+        }
+        
+        run_batch(count);
+    }
+}
+
+/**
+ * @brief Flush barrier job - signals the waiting task
+ */
+static esp_err_t barrier_job(void *arg)
+{
+    xSemaphoreGive((SemaphoreHandle_t)arg);
+    return ESP_OK;
+}
+
+esp_err_t sd_worker_init(void)
+{
+    if (s_task) {
+        return ESP_OK;
+    }
+    
+    s_queue = xQueueCreate(SD_WORKER_QUEUE_LEN, sizeof(sd_request_t));
+    ESP_RETURN_ON_FALSE(s_queue != NULL, ESP_ERR_NO_MEM, TAG, "Failed to create queue");
+    
+    BaseType_t ret = xTaskCreatePinnedToCore(
+        sd_worker_task,
+        "sd_worker",
+        SD_WORKER_STACK_SIZE,
+        NULL,
+        CONFIG_SD_WORKER_TASK_PRIORITY,
+        &s_task,
+        tskNO_AFFINITY
+    );
+    if (ret != pdPASS) {
+        vQueueDelete(s_queue);
+        s_queue = NULL;
+        ESP_LOGE(TAG, "Failed to create SD worker task");
+        return ESP_ERR_NO_MEM;
+    }
+    
+    return ESP_OK;
+}
+
+esp_err_t sd_worker_submit(sd_worker_job_fn_t job, void *arg, bool coalesce,
+                           sd_worker_done_cb_t done, void *user_ctx)
+{
+    ESP_RETURN_ON_FALSE(job != NULL, ESP_ERR_INVALID_ARG, TAG, "job is NULL");
+    ESP_RETURN_ON_FALSE(s_queue != NULL, ESP_ERR_INVALID_STATE, TAG, "SD worker not initialized");
+    
+    sd_request_t req = {
+        .job = job,
+        .arg = arg,
+        .coalesce = coalesce,
+        .done = done,
+        .user_ctx = user_ctx,
+    };
+    
+    if (xQueueSend(s_queue, &req, 0) != pdTRUE) {
+        ESP_LOGW(TAG, "Queue full, dropping job %p", job);
+        return ESP_ERR_TIMEOUT;
+    }
+    
+    return ESP_OK;
+}
+
+esp_err_t sd_worker_flush(uint32_t timeout_ms)
+{
+    if (!s_queue) {
+        return ESP_OK;
+    }
+    
+    SemaphoreHandle_t done = xSemaphoreCreateBinary();
+    ESP_RETURN_ON_FALSE(done != NULL, ESP_ERR_NO_MEM, TAG, "Failed to create semaphore");
+    
+    TickType_t timeout = pdMS_TO_TICKS(timeout_ms);
+    sd_request_t req = {
+        .job = barrier_job,
+        .arg = done,
+    };
+    
+    esp_err_t ret = ESP_ERR_TIMEOUT;
+    if (xQueueSend(s_queue, &req, timeout) == pdTRUE &&
+        xSemaphoreTake(done, timeout) == pdTRUE) {
+        ret = ESP_OK;
+    }
+    
+    if (ret == ESP_OK) {
+        vSemaphoreDelete(done);
+    } else {
+        // The barrier may still run later and give the semaphore, so leak
+        // it rather than risk a use-after-free
+        ESP_LOGW(TAG, "Flush timed out after %lu ms", (unsigned long)timeout_ms);
+    }
+    return ret;
+}
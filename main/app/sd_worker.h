@@ -0,0 +1,88 @@
+/**
+ * @file sd_worker.h
+ * @brief Background SD card worker task
+ * 
+ * All storage writes made on behalf of the UI (SD card and flash store) run
+ * on this task so that LVGL event callbacks never block on SPI transfers or
+ * flash erases. Jobs are queued with
+ * sd_worker_submit() and their completion callbacks are dispatched back into
+ * LVGL context with ui_post().
+ * 
+ * Coalescable jobs submitted in a burst (e.g. repeated reorder taps) are
+ * collected for CONFIG_SD_WORKER_COALESCE_MS and run once; every caller's
+ * completion callback still fires with the shared result.
+ * 
+ * @see docs/ARCHITECTURE.md §3 Inter-Task Communication
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Job function, runs on the SD worker task
+ * 
+ * @param arg Argument passed to sd_worker_submit()
+ * @return esp_err_t Result passed to the completion callback
+ */
+typedef esp_err_t (*sd_worker_job_fn_t)(void *arg);
+
+/**
+ * @brief Completion callback, runs in LVGL context
+ * 
+ * Called from the LVGL task with the LVGL mutex held, so it may update
+ * widgets directly. Before ui_start(), if it cannot be posted to the LVGL
+ * task, it is called on the worker task instead. After ui_start() it never
+ * runs on the worker: if the UI command queue stays full or memory runs
+ * out, the completion is logged and dropped.
+ * 
+ * @param result Value returned by the job
+ * @param user_ctx Opaque pointer passed to sd_worker_submit()
+ */
+typedef void (*sd_worker_done_cb_t)(esp_err_t result, void *user_ctx);
+
+/**
+ * @brief Start the SD worker task
+ * 
+ * @return esp_err_t ESP_OK on success
+ */
+esp_err_t sd_worker_init(void);
+
+/**
+ * @brief Queue a job for the SD worker
+ * 
+ * Never blocks: returns ESP_ERR_TIMEOUT if the queue is full.
+ * 
+ * @param job Job function to run on the worker task
+ * @param arg Argument for the job (must stay valid until it runs)
+ * @param coalesce If true, identical pending jobs (same job and arg) are
+ *                 merged and run once
+ * @param done Optional completion callback (may be NULL)
+ * @param user_ctx Opaque pointer passed to the completion callback
+ * @return esp_err_t ESP_OK if queued
+ */
+esp_err_t sd_worker_submit(sd_worker_job_fn_t job, void *arg, bool coalesce,
+                           sd_worker_done_cb_t done, void *user_ctx);
+
+/**
+ * @brief Wait until all jobs queued so far have run
+ * 
+ * Intended for shutdown paths (reboot, factory reset). Must not be called
+ * from a job or completion running on the worker task. Completions are
+ * posted to the LVGL task, so those still queued there run after this
+ * returns.
+ * 
+ * @param timeout_ms Maximum time to wait
+ * @return esp_err_t ESP_OK if drained, ESP_ERR_TIMEOUT otherwise
+ */
+esp_err_t sd_worker_flush(uint32_t timeout_ms);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,336 @@
+/**
+ * @file splash.c
+ * @brief Boot splash image implementation
+ * 
+ * Decoding uses the TJpgDec decoder in the ESP32-S3 ROM (the one esp_jpeg
+ * wraps on this target) through its streaming interface: the input
+ * callback reads from the buffered SD file, and the output callback
+ * converts each RGB888 block to the framebuffer's RGB565 byte order and
+ * writes it at the image's screen position. TJpgDec parses the headers
+ * first and rejects progressive frames (SOF2) there, without a scan of the
+ * whole file.
+ * 
+ * The cache partition holds a header in its first sector and the whole
+ * framebuffer from the second sector on. The pixels are written first and
+ * the header last, so an interrupted write leaves no valid cache. The
+ * write works from a PSRAM copy of the frame taken by splash_cache_capture(),
+ * so it can run after LVGL has started drawing into the framebuffer.
+ */
+
+#include "splash.h"
+#include "waveshare_sd.h"
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_lcd_panel_rgb.h"
+#include "esp_partition.h"
+#include "esp_rom_crc.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "esp_check.h"
+#include "rom/tjpgd.h"
+#include "lvgl.h"
+
+static const char *TAG = "splash";
+
+#define SPLASH_CACHE_MAGIC          0x50534C4CUL    // "LLSP"
+#define SPLASH_CACHE_DATA_OFFSET    0x1000
+#define SPLASH_FB_BYTES             (CONFIG_LCD_H_RES * CONFIG_LCD_V_RES * sizeof(lv_color_t))
+/// Pause between cache sectors so other tasks run between flash stalls
+#define SPLASH_CACHE_CHUNK_DELAY_MS 10
+
+/// TJpgDec work area for JD_SZBUF 512 without the fast decoder
+#define SPLASH_JPEG_WORK_SIZE       3100
+
+/**
+ * @brief Header in the first sector of the cache partition
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t width;         ///< Framebuffer size the image was composed for
+    uint16_t height;
+    uint32_t swapped;       ///< LV_COLOR_16_SWAP of the stored pixels
+    uint32_t jpeg_size;     ///< Source file size and modification time
+    uint32_t jpeg_mtime;
+    uint32_t crc;           ///< CRC32 of the fields above
+} splash_cache_header_t;
+
+/**
+ * @brief Decoder state passed to the TJpgDec callbacks
+ */
+typedef struct {
+    FILE *file;
+    lv_color_t *fb;
+    int offset_x;           ///< Screen position of the image's top left pixel
+    int offset_y;
+} decode_ctx_t;
+
+/// Framebuffer and source of the last splash_show() that decoded
+static struct {
+    lv_color_t *fb;
+    lv_color_t *copy;       ///< Frame captured for the cache write
+    splash_cache_header_t header;
+    bool cache_pending;
+} s_splash;
+
+static void cache_header_init(splash_cache_header_t *hdr, const struct stat *st)
+{
+    memset(hdr, 0, sizeof(*hdr));
+    hdr->magic = SPLASH_CACHE_MAGIC;
+    hdr->width = CONFIG_LCD_H_RES;
+    hdr->height = CONFIG_LCD_V_RES;
+    hdr->swapped = LV_COLOR_16_SWAP;
+    hdr->jpeg_size = (uint32_t)st->st_size;
+    hdr->jpeg_mtime = (uint32_t)st->st_mtime;
+    hdr->crc = esp_rom_crc32_le(0, (const uint8_t *)hdr, offsetof(splash_cache_header_t, crc));
+}
+
+#if CONFIG_SPLASH_CACHE
+static const esp_partition_t *cache_partition(void)
+{
+    const esp_partition_t *part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY,
+                                                           SPLASH_CACHE_PARTITION_LABEL);
+    if (part && part->size < SPLASH_CACHE_DATA_OFFSET + SPLASH_FB_BYTES) {
+        ESP_LOGW(TAG, "'%s' partition too small for a %dx%d image", SPLASH_CACHE_PARTITION_LABEL,
+                 CONFIG_LCD_H_RES, CONFIG_LCD_V_RES);
+        return NULL;
+    }
+    return part;
+}
+
+/**
+ * @brief Copy the cached image into the framebuffer if it matches @p want
+ */
+static esp_err_t cache_load(const splash_cache_header_t *want, lv_color_t *fb)
+{
+    const esp_partition_t *part = cache_partition();
+    if (!part) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    
+    splash_cache_header_t hdr;
+    ESP_RETURN_ON_ERROR(esp_partition_read(part, 0, &hdr, sizeof(hdr)), TAG, "Header read failed");
+    if (memcmp(&hdr, want, sizeof(hdr)) != 0) {
+        ESP_LOGI(TAG, "Cache does not match the splash file");
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    const void *pixels;
+    esp_partition_mmap_handle_t handle;
+    ESP_RETURN_ON_ERROR(esp_partition_mmap(part, SPLASH_CACHE_DATA_OFFSET, SPLASH_FB_BYTES,
+                                           ESP_PARTITION_MMAP_DATA, &pixels, &handle),
+                        TAG, "Failed to map cache");
+    memcpy(fb, pixels, SPLASH_FB_BYTES);
+    esp_partition_munmap(handle);
+    return ESP_OK;
+}
+#endif
+
+/**
+ * @brief TJpgDec input callback: read @p len bytes, or skip them if @p buf is NULL
+ */
+static UINT jpeg_input(JDEC *jd, BYTE *buf, UINT len)
+{
+    decode_ctx_t *ctx = jd->device;
+    if (buf == NULL) {
+        return fseek(ctx->file, len, SEEK_CUR) == 0 ? len : 0;
+    }
+    return fread(buf, 1, len, ctx->file);
+}
+
+/**
+ * @brief TJpgDec output callback: write one RGB888 block to the framebuffer
+ */
+static UINT jpeg_output(JDEC *jd, void *bitmap, JRECT *rect)
+{
+    const decode_ctx_t *ctx = jd->device;
+    const BYTE *rgb = bitmap;
+    int w = rect->right - rect->left + 1;
+    int x0 = rect->left + ctx->offset_x;
+    
+    // Blocks past the right edge of the screen are cropped
+    int skip = (x0 + w > CONFIG_LCD_H_RES) ? x0 + w - CONFIG_LCD_H_RES : 0;
+    int copy_w = w - skip;
+    if (copy_w <= 0) {
+        return 1;
+    }
+    
+    for (int y = rect->top; y <= rect->bottom; y++) {
+        int fb_y = y + ctx->offset_y;
+        if (fb_y >= CONFIG_LCD_V_RES) {
+            break;
+        }
+        lv_color_t *dst = ctx->fb + fb_y * CONFIG_LCD_H_RES + x0;
+        for (int x = 0; x < copy_w; x++) {
+            dst[x] = lv_color_make(rgb[0], rgb[1], rgb[2]);
+            rgb += 3;
+        }
+        rgb += skip * 3;
+    }
+    return 1;
+}
+
+/**
+ * @brief Decode a JPEG file into the framebuffer, centred on black
+ */
+static esp_err_t decode_to_fb(const char *path, lv_color_t *fb)
+{
+    decode_ctx_t ctx = { .fb = fb };
+    ctx.file = waveshare_sd_fopen(path, "rb");
+    if (!ctx.file) {
+        ESP_LOGE(TAG, "Failed to open %s", path);
+        return ESP_FAIL;
+    }
+    
+    void *work = heap_caps_malloc(SPLASH_JPEG_WORK_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (!work) {
+        waveshare_sd_fclose(ctx.file);
+        return ESP_ERR_NO_MEM;
+    }
+    
+    esp_err_t ret = ESP_OK;
+    JDEC jd;
+    JRESULT res = jd_prepare(&jd, jpeg_input, work, SPLASH_JPEG_WORK_SIZE, &ctx);
+    if (res == JDR_FMT3) {
+        ESP_LOGE(TAG, "Progressive or unsupported JPEG - save %s as baseline JPEG", path);
+        ret = ESP_ERR_NOT_SUPPORTED;
+        goto out;
+    } else if (res != JDR_OK) {
+        ESP_LOGE(TAG, "Invalid JPEG %s (error %d)", path, res);
+        ret = ESP_ERR_INVALID_RESPONSE;
+        goto out;
+    }
+    
+    ESP_LOGI(TAG, "Decoding %ux%u JPEG", jd.width, jd.height);
+    
+    // Centre if smaller, crop at the right and bottom if larger
+    ctx.offset_x = (CONFIG_LCD_H_RES > jd.width) ? (CONFIG_LCD_H_RES - jd.width) / 2 : 0;
+    ctx.offset_y = (CONFIG_LCD_V_RES > jd.height) ? (CONFIG_LCD_V_RES - jd.height) / 2 : 0;
+    if (jd.width < CONFIG_LCD_H_RES || jd.height < CONFIG_LCD_V_RES) {
+        memset(fb, 0, SPLASH_FB_BYTES);
+    }
+    
+    res = jd_decomp(&jd, jpeg_output, 0);
+    if (res != JDR_OK) {
+        ESP_LOGE(TAG, "JPEG decode failed (error %d)", res);
+        ret = ESP_FAIL;
+    }
+
+out:
+    free(work);
+    waveshare_sd_fclose(ctx.file);
+    return ret;
+}
+
+esp_err_t splash_show(esp_lcd_panel_handle_t panel, const char *path)
+{
+    s_splash.cache_pending = false;
+    
+    struct stat st;
+    if (stat(path, &st) != 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    
+    void *fb = NULL;
+    esp_err_t ret = esp_lcd_rgb_panel_get_frame_buffer(panel, 1, &fb);
+    ESP_RETURN_ON_FALSE(ret == ESP_OK && fb != NULL, ESP_FAIL, TAG, "Failed to get framebuffer");
+    
+    splash_cache_header_t want;
+    cache_header_init(&want, &st);
+    int64_t start_us = esp_timer_get_time();
+
+#if CONFIG_SPLASH_CACHE
+    if (cache_load(&want, fb) == ESP_OK) {
+        ESP_LOGI(TAG, "Splash loaded from cache in %lld ms", (esp_timer_get_time() - start_us) / 1000);
+        return ESP_OK;
+    }
+#endif
+
+    ESP_LOGI(TAG, "Decoding %s (%ld bytes)", path, (long)st.st_size);
+    ret = decode_to_fb(path, fb);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    ESP_LOGI(TAG, "Splash decoded in %lld ms", (esp_timer_get_time() - start_us) / 1000);
+    
+    s_splash.fb = fb;
+    s_splash.header = want;
+    s_splash.cache_pending = true;
+    return ESP_OK;
+}
+
+bool splash_cache_capture(void)
+{
+#if CONFIG_SPLASH_CACHE
+    if (!s_splash.cache_pending) {
+        return false;
+    }
+    
+    s_splash.copy = heap_caps_malloc(SPLASH_FB_BYTES, MALLOC_CAP_SPIRAM);
+    if (!s_splash.copy) {
+        ESP_LOGW(TAG, "No PSRAM for a copy of the splash - not caching it");
+        s_splash.cache_pending = false;
+        return false;
+    }
+    memcpy(s_splash.copy, s_splash.fb, SPLASH_FB_BYTES);
+    return true;
+#else
+    return false;
+#endif
+}
+
+esp_err_t splash_cache_update(void)
+{
+#if CONFIG_SPLASH_CACHE
+    if (!s_splash.cache_pending || !s_splash.copy) {
+        return ESP_OK;
+    }
+    s_splash.cache_pending = false;
+    
+    esp_err_t ret = ESP_OK;
+    const esp_partition_t *part = cache_partition();
+    if (!part) {
+        ESP_LOGW(TAG, "No '%s' partition - flash the current partition table to cache the splash",
+                 SPLASH_CACHE_PARTITION_LABEL);
+        ret = ESP_ERR_NOT_FOUND;
+        goto out;
+    }
+    
+    int64_t start_us = esp_timer_get_time();
+    size_t sector = part->erase_size;
+    
+    // Erasing the header sector invalidates the old cache before anything else
+    ESP_GOTO_ON_ERROR(esp_partition_erase_range(part, 0, SPLASH_CACHE_DATA_OFFSET), out, TAG,
+                      "Header erase failed");
+    
+    // One sector at a time, yielding in between, so each flash stall of the
+    // other core is a single sector erase rather than the whole image
+    for (size_t done = 0; done < SPLASH_FB_BYTES; done += sector) {
+        size_t len = SPLASH_FB_BYTES - done < sector ? SPLASH_FB_BYTES - done : sector;
+        ESP_GOTO_ON_ERROR(esp_partition_erase_range(part, SPLASH_CACHE_DATA_OFFSET + done, sector),
+                          out, TAG, "Erase failed at %u", (unsigned)done);
+        ESP_GOTO_ON_ERROR(esp_partition_write(part, SPLASH_CACHE_DATA_OFFSET + done,
+                                              (const uint8_t *)s_splash.copy + done, len),
+                          out, TAG, "Pixel write failed at %u", (unsigned)done);
+        vTaskDelay(pdMS_TO_TICKS(SPLASH_CACHE_CHUNK_DELAY_MS));
+    }
+    
+    ESP_GOTO_ON_ERROR(esp_partition_write(part, 0, &s_splash.header, sizeof(s_splash.header)),
+                      out, TAG, "Header write failed");
+    
+    ESP_LOGI(TAG, "Splash cached in %lld ms", (esp_timer_get_time() - start_us) / 1000);
+
+out:
+    free(s_splash.copy);
+    s_splash.copy = NULL;
+    return ret;
+#else
+    return ESP_OK;
+#endif
+}
@@ -0,0 +1,70 @@
+/**
+ * @file splash.h
+ * @brief Boot splash image
+ * 
+ * Shows the splash JPEG from the SD card in the first panel framebuffer.
+ * The JPEG is decoded as it is read from the file, and each decoded block
+ * is written straight to its centred position in the framebuffer, so there
+ * is no copy of the file or of the decoded image in PSRAM.
+ * 
+ * After the first decode, splash_cache_capture() copies the finished frame
+ * and splash_cache_update() later saves the copy to the "splash" flash
+ * partition, keyed by the size and modification time of the JPEG. Later
+ * boots copy that image into the framebuffer in one pass from
+ * memory-mapped flash instead of decoding.
+ * 
+ * @see docs/ARCHITECTURE.md Boot Splash
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include "esp_err.h"
+#include "esp_lcd_panel_ops.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SPLASH_CACHE_PARTITION_LABEL "splash"
+
+/**
+ * @brief Show a JPEG splash image, from the cache if it is current
+ * 
+ * Images smaller than the screen are centred on black; larger ones are
+ * cropped at the right and bottom. Baseline JPEGs only.
+ * 
+ * @param panel RGB panel whose first framebuffer is drawn into
+ * @param path JPEG file (e.g. "/sdcard/SPLASH.JPG")
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND if the file is
+ *                   missing, ESP_ERR_NOT_SUPPORTED for progressive JPEGs
+ */
+esp_err_t splash_show(esp_lcd_panel_handle_t panel, const char *path);
+
+/**
+ * @brief Copy the splash just decoded to PSRAM for splash_cache_update()
+ * 
+ * Call after splash_show() and before anything else draws into the
+ * framebuffer. Does nothing if splash_show() loaded the cache or failed.
+ * 
+ * @return true if a copy was taken and splash_cache_update() has work to do
+ */
+bool splash_cache_capture(void);
+
+/**
+ * @brief Save the captured splash to the cache partition and free the copy
+ * 
+ * Erases and writes one 4 KB sector at a time with a short delay after
+ * each, so the other core is only ever stalled for a single sector erase
+ * and other tasks run in between. The whole image takes several seconds,
+ * so run it from a low-priority task once start-up is done. The
+ * framebuffer itself may be drawn over by then.
+ * 
+ * @return esp_err_t ESP_OK if the cache is current or was not needed,
+ *                   ESP_ERR_NOT_FOUND if there is no splash partition
+ */
+esp_err_t splash_cache_update(void);
+
+#ifdef __cplusplus
+}
+#endif
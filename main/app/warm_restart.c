@@ -0,0 +1,184 @@
+/**
+ * @file warm_restart.c
+ * @brief Lighting and UI state kept across resets implementation
+ * 
+ * The record lives in RTC_NOINIT memory, which keeps its contents through
+ * every reset but power-on. Updates come from the lighting task and the
+ * LVGL task, so each one rewrites its fields and the CRC under a spinlock.
+ * A magic number, the record size and the CRC reject power-on garbage and
+ * records from firmware with a different layout.
+ * 
+ * Fade start times are system time (gettimeofday), not esp_timer: the RTC
+ * timer behind the system time keeps counting through software and
+ * watchdog resets, so the time spent restarting is counted as fade time.
+ */
+
+#include "warm_restart.h"
+
+#include <string.h>
+#include <stddef.h>
+#include <sys/time.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_attr.h"
+#include "esp_system.h"
+#include "esp_rom_crc.h"
+#include "esp_log.h"
+
+static const char *TAG = "warm";
+
+#define WARM_RESTART_MAGIC  0x4D52574CUL    // "LWRM"
+
+/**
+ * @brief Record in RTC memory
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t size;              ///< sizeof(warm_restart_record_t)
+    lighting_state_t current;
+    uint8_t fade_active;
+    uint8_t tab;
+    int16_t scene_index;
+    fade_plan_t plan;
+    int64_t fade_start_us;      ///< System time the fade started
+    uint32_t crc;               ///< CRC32 of the fields above
+} warm_restart_record_t;
+
+/// Record taken at start-up, before this run updates it
+static struct {
+    bool warm;
+    warm_restart_state_t saved;
+    int64_t fade_start_us;
+} s_resume;
+
+#if CONFIG_WARM_RESTART
+static RTC_NOINIT_ATTR warm_restart_record_t s_record;
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/**
+ * @brief System time in microseconds (kept across all but power-on resets)
+ */
+static int64_t system_time_us(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (int64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+static uint32_t record_crc(void)
+{
+    return esp_rom_crc32_le(0, (const uint8_t *)&s_record, offsetof(warm_restart_record_t, crc));
+}
+
+/**
+ * @brief Resets that leave RTC memory and the lights as they were
+ */
+static bool is_warm_reset(esp_reset_reason_t reason)
+{
+    switch (reason) {
+        case ESP_RST_SW:
+        case ESP_RST_PANIC:
+        case ESP_RST_INT_WDT:
+        case ESP_RST_TASK_WDT:
+        case ESP_RST_WDT:
+            return true;
+        default:
+            return false;
+    }
+}
+#endif
+
+esp_err_t warm_restart_init(void)
+{
+#if CONFIG_WARM_RESTART
+    esp_reset_reason_t reason = esp_reset_reason();
+    bool valid = s_record.magic == WARM_RESTART_MAGIC &&
+                 s_record.size == sizeof(s_record) &&
+                 s_record.crc == record_crc();
+    
+    if (is_warm_reset(reason) && valid) {
+        s_resume.warm = true;
+        s_resume.saved.current = s_record.current;
+        s_resume.saved.fade_active = s_record.fade_active;
+        s_resume.saved.plan = s_record.plan;
+        s_resume.saved.tab = s_record.tab;
+        s_resume.saved.scene_index = s_record.scene_index;
+        s_resume.fade_start_us = s_record.fade_start_us;
+        
+        ESP_LOGI(TAG, "Warm restart (reset reason %d): tab %u, scene %d, %s", reason,
+                 s_record.tab, s_record.scene_index, s_record.fade_active ? "fade running" : "no fade");
+        return ESP_OK;
+    }
+    
+    if (is_warm_reset(reason)) {
+        ESP_LOGW(TAG, "No valid state record (reset reason %d) - starting cold", reason);
+    }
+    
+    memset(&s_record, 0, sizeof(s_record));
+    s_record.magic = WARM_RESTART_MAGIC;
+    s_record.size = sizeof(s_record);
+    s_record.crc = record_crc();
+#endif
+    return ESP_ERR_NOT_FOUND;
+}
+
+bool warm_restart_get(warm_restart_state_t *state)
+{
+    if (!s_resume.warm) {
+        return false;
+    }
+    
+    if (state) {
+        *state = s_resume.saved;
+        state->fade_elapsed_ms = 0;
+#if CONFIG_WARM_RESTART
+        if (state->fade_active) {
+            // A clock that went backwards means the RTC timer was reset too
+            int64_t elapsed_ms = (system_time_us() - s_resume.fade_start_us) / 1000;
+            if (elapsed_ms < 0 || elapsed_ms > UINT32_MAX) {
+                state->fade_elapsed_ms = UINT32_MAX;
+            } else {
+                state->fade_elapsed_ms = (uint32_t)elapsed_ms;
+            }
+        }
+#endif
+    }
+    return true;
+}
+
+void warm_restart_save_lighting(const lighting_state_t *current, const fade_plan_t *plan,
+                                uint32_t elapsed_ms)
+{
+#if CONFIG_WARM_RESTART
+    int64_t start_us = system_time_us() - (int64_t)elapsed_ms * 1000;
+    
+    portENTER_CRITICAL(&s_lock);
+    s_record.current = *current;
+    s_record.fade_active = (plan != NULL);
+    if (plan) {
+        s_record.plan = *plan;
+        s_record.fade_start_us = start_us;
+    }
+    s_record.crc = record_crc();
+    portEXIT_CRITICAL(&s_lock);
+#endif
+}
+
+void warm_restart_save_tab(uint8_t tab)
+{
+#if CONFIG_WARM_RESTART
+    portENTER_CRITICAL(&s_lock);
+    s_record.tab = tab;
+    s_record.crc = record_crc();
+    portEXIT_CRITICAL(&s_lock);
+#endif
+}
+
+void warm_restart_save_scene(int scene_index)
+{
+#if CONFIG_WARM_RESTART
+    portENTER_CRITICAL(&s_lock);
+    s_record.scene_index = (int16_t)scene_index;
+    s_record.crc = record_crc();
+    portEXIT_CRITICAL(&s_lock);
+#endif
+}
@@ -0,0 +1,86 @@
+/**
+ * @file warm_restart.h
+ * @brief Lighting and UI state kept across software and watchdog resets
+ * 
+ * A small record in RTC memory holds the lighting values the receivers
+ * were last sent, the active fade plan with its start time, and the
+ * selected tab and scene. fade_controller and the UI update it as they
+ * change, so it is current whenever a reset hits.
+ * 
+ * After a software reset (LCC reboot command, firmware update), a panic
+ * or a watchdog reset the record is still valid, and app_main() skips the
+ * splash and auto-apply: the UI comes back on the same tab and scene, and
+ * an interrupted fade continues from where the lights are now. Power-on
+ * and brownout resets start cold.
+ * 
+ * @see docs/ARCHITECTURE.md Warm Restart
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "fade_controller.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief State saved before the last reset
+ */
+typedef struct {
+    lighting_state_t current;   ///< Values last sent to the receivers
+    bool fade_active;           ///< A fade was running
+    fade_plan_t plan;           ///< The running fade (if fade_active)
+    uint32_t fade_elapsed_ms;   ///< Time since that fade started, reset included
+                                ///< (UINT32_MAX if the clock was reset too)
+    uint8_t tab;                ///< Main screen tab index
+    int scene_index;            ///< Selected scene on the Scene Selector tab
+} warm_restart_state_t;
+
+/**
+ * @brief Check the reset reason and take the saved record
+ * 
+ * Call early in app_main(), before fade_controller or the UI can update
+ * the record. On a cold boot, or if the record does not check out, the
+ * record is cleared for this run.
+ * 
+ * @return esp_err_t ESP_OK on a warm restart, ESP_ERR_NOT_FOUND on a cold boot
+ */
+esp_err_t warm_restart_init(void);
+
+/**
+ * @brief Get the state saved before the reset
+ * 
+ * The fade elapsed time is measured when this is called.
+ * 
+ * @param[out] state Saved state (may be NULL to just check)
+ * @return true on a warm restart, false on a cold boot
+ */
+bool warm_restart_get(warm_restart_state_t *state);
+
+/**
+ * @brief Save the lighting state
+ * 
+ * @param current Values last sent to the receivers
+ * @param plan Running fade, or NULL if none
+ * @param elapsed_ms Time since the fade started
+ */
+void warm_restart_save_lighting(const lighting_state_t *current, const fade_plan_t *plan,
+                                uint32_t elapsed_ms);
+
+/**
+ * @brief Save the main screen tab index
+ */
+void warm_restart_save_tab(uint8_t tab);
+
+/**
+ * @brief Save the selected scene index
+ */
+void warm_restart_save_scene(int scene_index);
+
+#ifdef __cplusplus
+}
+#endif
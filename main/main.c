@@ -19,8 +19,9 @@
 #include "nvs_flash.h"
 #include "driver/i2c.h"
 #include "esp_heap_caps.h"
-#include "jpeg_decoder.h"
+#include "esp_timer.h"
 #include <sys/stat.h>
+#include <unistd.h>
 
 // Board drivers
 #include "ch422g.h"
@@ -33,10 +34,18 @@
 
 // App modules
 #include "app/scene_storage.h"
+#include "app/sd_worker.h"
+#include "app/json_arena.h"
+#include "app/flash_store.h"
 #include "app/lcc_node.h"
 #include "app/fade_controller.h"
 #include "app/screen_timeout.h"
+#include "app/power_save.h"
+#include "app/splash.h"
+#include "app/boot_timeline.h"
+#include "app/warm_restart.h"
 #include "app/bootloader_hal.h"
+#include "app/diag_console.h"
 
 // For reset reason detection (FR-060)
 #if defined(CONFIG_IDF_TARGET_ESP32S3)
@@ -122,6 +131,11 @@ static esp_err_t init_hardware(void)
         .ch422g_handle = s_ch422g,
         .max_files = 5,
         .format_if_mount_failed = false,
+        .max_freq_khz = CONFIG_SD_MAX_FREQ_KHZ,
+        .io_buffer_size = CONFIG_SD_IO_BUFFER_SIZE,
+#if CONFIG_SD_IO_BUFFER_IN_PSRAM
+        .io_buffer_in_psram = true,
+#endif
     };
     ret = waveshare_sd_init(&sd_config, &s_sd_card);
     if (ret != ESP_OK) {
@@ -131,6 +145,13 @@ static esp_err_t init_hardware(void)
     } else {
         ESP_LOGI(TAG, "SD Card initialized successfully");
         s_sd_card_ok = true;
+#if CONFIG_SD_BENCHMARK_ON_BOOT
+        waveshare_sd_bench_result_t bench;
+        if (waveshare_sd_benchmark(CONFIG_SD_MOUNT_POINT "/bench.bin",
+                                   CONFIG_SD_BENCHMARK_SIZE_KB * 1024, &bench) == ESP_OK) {
+            waveshare_sd_benchmark_log(&bench);
+        }
+#endif
     }
 
     ESP_LOGI(TAG, "Step 4: Initializing LCD Panel...");
@@ -139,7 +160,7 @@ static esp_err_t init_hardware(void)
         .h_res = CONFIG_LCD_H_RES,
         .v_res = CONFIG_LCD_V_RES,
         .pixel_clock_hz = CONFIG_LCD_PIXEL_CLOCK_HZ,
-        .num_fb = 2,  // Double buffering
+        .num_fb = 2,  // Double buffering (LVGL direct mode draws into both)
         .bounce_buffer_size_px = CONFIG_LCD_H_RES * CONFIG_LCD_RGB_BOUNCE_BUFFER_HEIGHT,
         .ch422g_handle = s_ch422g,
     };
@@ -157,6 +178,9 @@ static esp_err_t init_hardware(void)
         .h_res = CONFIG_LCD_H_RES,
         .v_res = CONFIG_LCD_V_RES,
         .ch422g_handle = s_ch422g,
+#if CONFIG_TOUCH_INTERRUPT
+        .use_interrupt = true,
+#endif
     };
     ret = waveshare_touch_init(&touch_config, &s_touch);
     if (ret != ESP_OK) {
@@ -170,15 +194,59 @@ static esp_err_t init_hardware(void)
 }
 
 /**
- * @brief Check for scenes.json and create if it doesn't exist
+ * @brief Import/export the flash store according to SD card marker files
+ * 
+ * - IMPORT on the card: copy every file from the card into flash
+ * - EXPORT on the card: copy every flash record onto the card
+ * - Otherwise: import only records that are still empty in flash, which
+ *   migrates an existing SD card setup on first boot
+ * 
+ * Marker files are deleted once handled.
+ */
+static void sync_flash_store_with_sd(void)
+{
+    static const char *import_marker = CONFIG_SD_MOUNT_POINT "/IMPORT";
+    static const char *export_marker = CONFIG_SD_MOUNT_POINT "/EXPORT";
+    struct stat st;
+    
+    if (stat(import_marker, &st) == 0) {
+        ESP_LOGI(TAG, "IMPORT marker found - importing SD card files into flash");
+        flash_store_import(CONFIG_SD_MOUNT_POINT, true);
+        unlink(import_marker);
+    } else {
+        flash_store_import(CONFIG_SD_MOUNT_POINT, false);
+    }
+    
+    if (stat(export_marker, &st) == 0) {
+        ESP_LOGI(TAG, "EXPORT marker found - exporting flash store to SD card");
+        flash_store_export(CONFIG_SD_MOUNT_POINT);
+        unlink(export_marker);
+    }
+    
+#if CONFIG_FLASH_STORE_BENCHMARK_ON_BOOT
+    flash_store_benchmark_log(CONFIG_SD_MOUNT_POINT);
+#endif
+}
+
+/**
+ * @brief Check for stored scenes and create defaults if there are none
  */
-static void ensure_scenes_json_exists(void)
+static void ensure_scenes_exist(void)
 {
-    const char *scenes_path = "/sdcard/scenes.json";
+    const char *scenes_path = CONFIG_SD_MOUNT_POINT "/scenes.json";
     
-    // Check if file exists
+    // Check if scenes exist in the flash store, or on the SD card without one
+    const void *data;
+    size_t len;
     struct stat st;
-    if (stat(scenes_path, &st) == 0) {
+    if (flash_store_is_available()) {
+        if (flash_store_get(FLASH_STORE_SCENES, &data, &len) == ESP_OK) {
+            ESP_LOGI(TAG, "scenes.json found in flash (%u bytes)", (unsigned)len);
+            return;
+        }
+    } else if (!s_sd_card_ok) {
+        return;
+    } else if (stat(scenes_path, &st) == 0) {
         ESP_LOGI(TAG, "scenes.json found (%ld bytes)", st.st_size);
         return;
     }
@@ -208,184 +276,17 @@ static void ensure_scenes_json_exists(void)
         "  ]\n"
         "}\n";
     
-    FILE *file = fopen(scenes_path, "w");
-    if (!file) {
-        ESP_LOGE(TAG, "Failed to create scenes.json");
-        return;
-    }
-    
-    size_t written = fwrite(default_scenes, 1, strlen(default_scenes), file);
-    fclose(file);
-    
-    if (written == strlen(default_scenes)) {
-        ESP_LOGI(TAG, "Created scenes.json with %d bytes", written);
+    esp_err_t ret;
+    if (flash_store_is_available()) {
+        ret = flash_store_write(FLASH_STORE_SCENES, default_scenes, strlen(default_scenes));
     } else {
-        ESP_LOGE(TAG, "Failed to write complete scenes.json");
-    }
-}
-
-/**
- * @brief Load and display a JPEG image from SD card
- * @param panel LCD panel handle
- * @param filepath Path to JPEG file (e.g., "/sdcard/image.jpg")
- */
-static esp_err_t load_and_display_image(esp_lcd_panel_handle_t panel, const char *filepath)
-{
-    ESP_LOGI(TAG, "Loading image: %s", filepath);
-    
-    // Open the file
-    FILE *file = fopen(filepath, "rb");
-    if (!file) {
-        ESP_LOGE(TAG, "Failed to open file: %s", filepath);
-        return ESP_ERR_NOT_FOUND;
-    }
-    
-    // Get file size
-    fseek(file, 0, SEEK_END);
-    size_t file_size = ftell(file);
-    fseek(file, 0, SEEK_SET);
-    
-    ESP_LOGI(TAG, "Image file size: %d bytes", file_size);
-    
-    // Allocate buffer for JPEG data
-    uint8_t *jpeg_buf = heap_caps_malloc(file_size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
-    if (!jpeg_buf) {
-        ESP_LOGE(TAG, "Failed to allocate %d bytes for JPEG buffer", file_size);
-        fclose(file);
-        return ESP_ERR_NO_MEM;
-    }
-    
-    // Read JPEG file
-    size_t read_size = fread(jpeg_buf, 1, file_size, file);
-    fclose(file);
-    
-    if (read_size != file_size) {
-        ESP_LOGE(TAG, "Failed to read file completely");
-        free(jpeg_buf);
-        return ESP_FAIL;
-    }
-    
-    // Check JPEG header
-    if (jpeg_buf[0] != 0xFF || jpeg_buf[1] != 0xD8) {
-        ESP_LOGE(TAG, "Invalid JPEG file - missing SOI marker");
-        free(jpeg_buf);
-        return ESP_FAIL;
-    }
-    
-    // Check for progressive JPEG (SOF2 marker 0xFFC2)
-    bool is_progressive = false;
-    for (size_t i = 0; i < file_size - 1; i++) {
-        if (jpeg_buf[i] == 0xFF && jpeg_buf[i+1] == 0xC2) {
-            is_progressive = true;
-            break;
-        }
-    }
-    
-    if (is_progressive) {
-        ESP_LOGE(TAG, "Progressive JPEG not supported by TinyJPEG decoder!");
-        ESP_LOGE(TAG, "Please convert your image to baseline JPEG format");
-        free(jpeg_buf);
-        return ESP_ERR_NOT_SUPPORTED;
-    }
-    
-    ESP_LOGI(TAG, "JPEG file loaded, decoding...");
-    
-    // Allocate output buffer (worst case: RGB565 = 2 bytes per pixel)
-    // We'll allocate for max LCD size
-    size_t out_buf_size = CONFIG_LCD_H_RES * CONFIG_LCD_V_RES * 2;
-    uint8_t *out_buf = heap_caps_malloc(out_buf_size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
-    if (!out_buf) {
-        ESP_LOGE(TAG, "Failed to allocate output buffer");
-        free(jpeg_buf);
-        return ESP_ERR_NO_MEM;
-    }
-    
-    // Allocate working buffer for JPEG decoder (required by TinyJPEG)
-    size_t work_buf_size = 3100;  // Default size for JD_FASTDECODE=0
-    uint8_t *work_buf = heap_caps_malloc(work_buf_size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
-    if (!work_buf) {
-        ESP_LOGE(TAG, "Failed to allocate working buffer");
-        free(out_buf);
-        free(jpeg_buf);
-        return ESP_ERR_NO_MEM;
-    }
-    
-    // Decode JPEG
-    esp_jpeg_image_cfg_t jpeg_cfg = {
-        .indata = jpeg_buf,
-        .indata_size = file_size,
-        .outbuf = out_buf,
-        .outbuf_size = out_buf_size,
-        .out_format = JPEG_IMAGE_FORMAT_RGB565,
-        .out_scale = JPEG_IMAGE_SCALE_0,
-        .flags = {
-            .swap_color_bytes = 0,
-        },
-        .advanced = {
-            .working_buffer = work_buf,
-            .working_buffer_size = work_buf_size,
-        }
-    };
-    
-    esp_jpeg_image_output_t outimg;
-    esp_err_t ret = esp_jpeg_decode(&jpeg_cfg, &outimg);
-    
-    free(work_buf);  // Free working buffer immediately after decode
-    
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "JPEG decode failed: %s", esp_err_to_name(ret));
-        free(out_buf);
-        free(jpeg_buf);
-        return ret;
-    }
-    
-    ESP_LOGI(TAG, "JPEG decoded: %dx%d", outimg.width, outimg.height);
-    
-    // Get framebuffer
-    void *fb0 = NULL;
-    ret = esp_lcd_rgb_panel_get_frame_buffer(panel, 1, &fb0);
-    if (ret != ESP_OK || fb0 == NULL) {
-        ESP_LOGE(TAG, "Failed to get framebuffer");
-        free(out_buf);
-        free(jpeg_buf);
-        return ret;
+        ret = waveshare_sd_write_file_atomic(scenes_path, default_scenes, strlen(default_scenes));
     }
-    
-    uint16_t *framebuffer = (uint16_t *)fb0;
-    uint16_t *img_data = (uint16_t *)out_buf;
-    
-    // Copy image to framebuffer (center if smaller, crop if larger)
-    int lcd_w = CONFIG_LCD_H_RES;
-    int lcd_h = CONFIG_LCD_V_RES;
-    int img_w = outimg.width;
-    int img_h = outimg.height;
-    
-    // Clear screen to black first
-    memset(framebuffer, 0, lcd_w * lcd_h * 2);
-    
-    // Calculate offset to center image
-    int offset_x = (lcd_w > img_w) ? (lcd_w - img_w) / 2 : 0;
-    int offset_y = (lcd_h > img_h) ? (lcd_h - img_h) / 2 : 0;
-    
-    // Copy image data
-    int copy_w = (img_w < lcd_w) ? img_w : lcd_w;
-    int copy_h = (img_h < lcd_h) ? img_h : lcd_h;
-    
-    for (int y = 0; y < copy_h; y++) {
-        for (int x = 0; x < copy_w; x++) {
-            int fb_x = x + offset_x;
-            int fb_y = y + offset_y;
-            framebuffer[fb_y * lcd_w + fb_x] = img_data[y * img_w + x];
-        }
+    if (ret == ESP_OK) {
+        ESP_LOGI(TAG, "Created scenes.json with %d bytes", strlen(default_scenes));
+    } else {
+        ESP_LOGE(TAG, "Failed to create scenes.json: %s", esp_err_to_name(ret));
     }
-    
-    ESP_LOGI(TAG, "Image displayed successfully");
-    
-    // Cleanup
-    free(out_buf);
-    free(jpeg_buf);
-    
-    return ESP_OK;
 }
 
 // ============================================================================
@@ -398,13 +299,17 @@ static TaskHandle_t s_lighting_task = NULL;
 /// Lighting task tick interval (ms) - 10ms for smooth fade interpolation
 #define LIGHTING_TASK_INTERVAL_MS  10
 
+/// Longest lighting task sleep while the screen is off
+#define LIGHTING_TASK_IDLE_MAX_MS  1000
+
 /**
  * @brief Lighting control task
  * 
  * Runs the fade controller state machine and handles LCC event transmission.
  * Tick interval of 10ms combined with burst transmission of all 5 parameters
  * provides smooth fades (100 steps per second, ~2.5 value change per step
- * for a 10-second 0→255 fade).
+ * for a 10-second 0→255 fade). While the screen is off no slider can queue
+ * live updates, so the task sleeps until the next fade segment is due.
  */
 static void lighting_task(void *arg)
 {
@@ -416,80 +321,156 @@ static void lighting_task(void *arg)
         // Process fade controller
         fade_controller_tick();
         
+        uint32_t due_ms = fade_controller_get_next_due_ms();
+        if (due_ms < LIGHTING_TASK_INTERVAL_MS) {
+            due_ms = LIGHTING_TASK_INTERVAL_MS;
+        } else if (due_ms > LIGHTING_TASK_IDLE_MAX_MS) {
+            due_ms = LIGHTING_TASK_IDLE_MAX_MS;
+        }
+        if (power_save_wait(pdMS_TO_TICKS(due_ms))) {
+            last_wake = xTaskGetTickCount();
+            continue;
+        }
+        
         // Fixed delay for consistent timing
         vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(LIGHTING_TASK_INTERVAL_MS));
     }
 }
 
+// ============================================================================
+// Boot Tasks
+// ============================================================================
+
+/// Tasks that run boot phases beside the splash (and the splash cache write
+/// after boot), on the LVGL core at app_main's priority so they do not
+/// preempt the splash decode
+#define BOOT_TASK_STACK_SIZE    6144
+#define BOOT_TASK_PRIORITY      1
+#define BOOT_TASK_CORE          1
+
 /**
- * @brief Show SD card missing error screen
- * 
- * Displays a user-friendly error message when SD card is not detected.
- * Loops forever checking for SD card insertion.
+ * @brief LCC node, then power management and screen timeout (which need it)
  */
-static void show_sd_card_error_screen(void)
+static void boot_lcc(void)
 {
-    ESP_LOGI(TAG, "Showing SD card error screen");
-    
-    // Initialize LVGL first so we can display the error
+    // Initialize LCC/OpenMRN (FR-002)
+    // This reads node ID from the flash store and initializes TWAI
+    boot_phase_begin(BOOT_PHASE_LCC);
+    ESP_LOGI(TAG, "Initializing LCC/OpenMRN...");
+    lcc_config_t lcc_cfg = LCC_CONFIG_DEFAULT();
+    if (!flash_store_is_available()) {
+        lcc_cfg.nodeid_path = CONFIG_SD_MOUNT_POINT "/nodeid.txt";
+        lcc_cfg.config_path = CONFIG_SD_MOUNT_POINT "/openmrn_config";
+    }
+    esp_err_t ret = lcc_node_init(&lcc_cfg);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "LCC initialization failed: %s - continuing without LCC", 
+                 esp_err_to_name(ret));
+        // Continue without LCC - device can still function as standalone UI
+    } else {
+        ESP_LOGI(TAG, "LCC node initialized - Node ID: %012llX, Base Event: %016llX",
+                 (unsigned long long)lcc_node_get_node_id(),
+                 (unsigned long long)lcc_node_get_base_event_id());
+    }
+    boot_phase_end(BOOT_PHASE_LCC, ret);
+
+    // Frequency scaling while the screen is off (after LCC, whose TWAI it keeps clocked)
+    boot_phase_begin(BOOT_PHASE_POWER);
+    ESP_LOGI(TAG, "Initializing power management...");
+    ret = power_save_init();
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Power management init failed: %s - CPUs stay at full speed",
+                 esp_err_to_name(ret));
+    }
+
+    // Initialize screen timeout module (power saving)
+    ESP_LOGI(TAG, "Initializing screen timeout...");
+    screen_timeout_config_t screen_timeout_cfg = {
+        .ch422g_handle = s_ch422g,
+        .timeout_sec = lcc_node_get_screen_timeout_sec(),
+    };
+    ret = screen_timeout_init(&screen_timeout_cfg);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Screen timeout init failed: %s - power saving disabled", 
+                 esp_err_to_name(ret));
+    } else {
+        ESP_LOGI(TAG, "Screen timeout initialized: %u sec (0=disabled)",
+                 screen_timeout_cfg.timeout_sec);
+    }
+    boot_phase_end(BOOT_PHASE_POWER, ret);
+}
+
+static void boot_lcc_task(void *arg)
+{
+    boot_lcc();
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief LVGL, the scene store and the main screen, built before LVGL draws
+ */
+static void boot_ui(void)
+{
+    // Initialize LVGL
+    boot_phase_begin(BOOT_PHASE_LVGL);
+    ESP_LOGI(TAG, "Initializing LVGL...");
     lv_disp_t *disp = NULL;
     lv_indev_t *touch_indev = NULL;
     esp_err_t ret = ui_init(&disp, &touch_indev);
     if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to initialize LVGL for error screen");
-        // Fall back to just logging
-        while (1) {
-            ESP_LOGE(TAG, "SD Card not detected! Please insert SD card and reboot.");
-            vTaskDelay(pdMS_TO_TICKS(5000));
-        }
+        ESP_LOGE(TAG, "Failed to initialize LVGL: %s", esp_err_to_name(ret));
+        boot_phase_end(BOOT_PHASE_LVGL, ret);
+        return;
     }
-    
-    // Create error screen with LVGL
-    ui_lock();
-    
-    lv_obj_t *scr = lv_scr_act();
-    lv_obj_set_style_bg_color(scr, lv_color_hex(0x1E1E1E), LV_PART_MAIN);  // Dark background
-    lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, LV_PART_MAIN);  // Ensure background is fully opaque
-    lv_obj_clear_flag(scr, LV_OBJ_FLAG_SCROLLABLE);  // Disable scrolling
-    
-    // SD card icon (using warning symbol)
-    lv_obj_t *icon = lv_label_create(scr);
-    lv_label_set_text(icon, LV_SYMBOL_WARNING);
-    lv_obj_set_style_text_font(icon, &lv_font_montserrat_28, LV_PART_MAIN);
-    lv_obj_set_style_text_color(icon, lv_color_hex(0xFF9800), LV_PART_MAIN);  // Orange warning
-    lv_obj_align(icon, LV_ALIGN_CENTER, 0, -80);
-    
-    // Main error message
-    lv_obj_t *title = lv_label_create(scr);
-    lv_label_set_text(title, "SD Card Not Detected");
-    lv_obj_set_style_text_font(title, &lv_font_montserrat_28, LV_PART_MAIN);
-    lv_obj_set_style_text_color(title, lv_color_hex(0xFFFFFF), LV_PART_MAIN);  // White
-    lv_obj_align(title, LV_ALIGN_CENTER, 0, -20);
-    
-    // Instructions
-    lv_obj_t *instructions = lv_label_create(scr);
-    lv_label_set_text(instructions, 
-        "Please insert an SD card with the required\n"
-        "configuration files and restart the device.\n\n"
-        "Required files:\n"
-        "  - nodeid.txt (LCC node ID)\n"
-        "  - scenes.json (lighting scenes)");
-    lv_obj_set_style_text_font(instructions, &lv_font_montserrat_16, LV_PART_MAIN);
-    lv_obj_set_style_text_color(instructions, lv_color_hex(0xB0B0B0), LV_PART_MAIN);  // Light gray
-    lv_obj_set_style_text_align(instructions, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
-    lv_obj_align(instructions, LV_ALIGN_CENTER, 0, 70);
-    
-    ui_unlock();
-    
-    ESP_LOGE(TAG, "SD Card not detected - waiting for card insertion");
-    
-    // Loop forever - user must insert card and restart
-    // Note: We don't retry SD card init here because it interferes with the display
-    // (CH422G and SPI bus reinitialization can affect LCD operation)
-    while (1) {
-        vTaskDelay(pdMS_TO_TICKS(5000));
-        ESP_LOGW(TAG, "SD Card missing - please insert card and restart device");
+    ESP_LOGI(TAG, "LVGL initialized successfully");
+
+    // PSRAM arena for cJSON parse/serialize (keeps internal heap unfragmented)
+    json_arena_init(CONFIG_JSON_ARENA_SIZE_KB * 1024);
+
+    // Start SD worker (background scene writes, keeps SD I/O out of LVGL callbacks)
+    esp_err_t worker_ret = sd_worker_init();
+    if (worker_ret != ESP_OK) {
+        ESP_LOGE(TAG, "SD worker init failed: %s", esp_err_to_name(worker_ret));
+    }
+    boot_phase_end(BOOT_PHASE_LVGL, ESP_OK);
+
+    // Load scenes from storage once; the in-memory store is authoritative after this
+    boot_phase_begin(BOOT_PHASE_SCENES);
+    ESP_LOGI(TAG, "Loading scenes...");
+    ret = scene_storage_init();
+    ESP_LOGI(TAG, "Scenes loaded: %d", (int)scene_storage_get_count());
+    boot_phase_end(BOOT_PHASE_SCENES, ret);
+
+    // Build main UI (FR-010) - Scene Selector tab populates from the scene store
+    boot_phase_begin(BOOT_PHASE_UI);
+    ESP_LOGI(TAG, "Building main UI...");
+    ui_show_main();
+    warm_restart_state_t warm;
+    if (warm_restart_get(&warm)) {
+        ui_restore_selection(warm.tab, warm.scene_index);
     }
+    boot_phase_end(BOOT_PHASE_UI, ESP_OK);
+}
+
+static void boot_ui_task(void *arg)
+{
+    boot_ui();
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Splash cache write, from the copy taken while the splash was shown
+ */
+static void boot_splash_cache(void)
+{
+    boot_phase_begin(BOOT_PHASE_SPLASH_CACHE);
+    boot_phase_end(BOOT_PHASE_SPLASH_CACHE, splash_cache_update());
+}
+
+static void boot_splash_cache_task(void *arg)
+{
+    boot_splash_cache();
+    vTaskDelete(NULL);
 }
 
 /**
@@ -519,8 +500,7 @@ void app_main(void)
     if (bootloader_hal_should_enter()) {
         ESP_LOGI(TAG, "Entering bootloader mode for firmware update...");
         
-        // Read node ID from SD card first (need to init I2C and SD for this)
-        // For now, use a fallback approach: init minimal hardware
+        // Init minimal hardware (I2C and CH422G) for the SD card fallback below
         esp_err_t ret = init_i2c();
         if (ret == ESP_OK) {
             ch422g_config_t ch422g_config = {
@@ -530,9 +510,11 @@ void app_main(void)
             ret = ch422g_init(&ch422g_config, &s_ch422g);
         }
         
-        // Try to read node ID from SD, fall back to default if not available
+        // Read node ID from the flash store, then SD, then fall back to default
         uint64_t bootloader_node_id = LCC_DEFAULT_NODE_ID;
-        if (ret == ESP_OK) {
+        bool have_node_id = (flash_store_init() == ESP_OK &&
+                             lcc_node_read_node_id(FLASH_STORE_NODE_ID_PATH, &bootloader_node_id));
+        if (!have_node_id && ret == ESP_OK) {
             waveshare_sd_config_t sd_config = {
                 .mosi_gpio = CONFIG_SD_MOSI_GPIO,
                 .miso_gpio = CONFIG_SD_MISO_GPIO,
@@ -543,11 +525,7 @@ void app_main(void)
                 .format_if_mount_failed = false,
             };
             if (waveshare_sd_init(&sd_config, &s_sd_card) == ESP_OK) {
-                // Try to read node ID
-                bootloader_node_id = lcc_node_get_node_id();
-                if (bootloader_node_id == 0) {
-                    bootloader_node_id = LCC_DEFAULT_NODE_ID;
-                }
+                lcc_node_read_node_id(CONFIG_SD_MOUNT_POINT "/nodeid.txt", &bootloader_node_id);
             }
         }
         
@@ -561,8 +539,13 @@ void app_main(void)
     }
     // ========================================================================
 
+    // Take the warm restart record before anything updates it
+    warm_restart_init();
+
+    boot_timeline_init();
 
     // Initialize NVS (required for some ESP-IDF components)
+    boot_phase_begin(BOOT_PHASE_STORAGE);
     ESP_LOGI(TAG, "Initializing NVS...");
     esp_err_t ret = nvs_flash_init();
     if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
@@ -573,9 +556,18 @@ void app_main(void)
     ESP_ERROR_CHECK(ret);
     ESP_LOGI(TAG, "NVS initialized successfully");
 
+    // Map the flash store (node ID, LCC config, scenes)
+    ret = flash_store_init();
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Flash store unavailable (%s) - falling back to SD card", esp_err_to_name(ret));
+    }
+    boot_phase_end(BOOT_PHASE_STORAGE, ret);
+
     // Initialize hardware
+    boot_phase_begin(BOOT_PHASE_HARDWARE);
     ESP_LOGI(TAG, "Starting hardware initialization...");
     ret = init_hardware();
+    boot_phase_end(BOOT_PHASE_HARDWARE, ret);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Hardware initialization failed: %s", esp_err_to_name(ret));
         // TODO: Show error on display or blink LED
@@ -587,53 +579,18 @@ void app_main(void)
         }
     }
 
-    // Check if SD card is present - show error screen if not
+    // The SD card is optional: it only supplies the splash image and
+    // on-demand import/export of the flash store
+    boot_phase_begin(BOOT_PHASE_SD_SYNC);
     if (!s_sd_card_ok) {
-        show_sd_card_error_screen();
-        // This function never returns
-    }
-
-    // Ensure scenes.json exists (create default if not)
-    ensure_scenes_json_exists();
-    
-    // Display splash image from SD card (FAT uses 8.3 filenames)
-    ret = load_and_display_image(s_lcd_panel, "/sdcard/SPLASH.JPG");
-    if (ret != ESP_OK) {
-        ESP_LOGW(TAG, "No splash image found, continuing without splash");
-    }
-
-    // Show splash for specified duration (FR-001: within 1500ms)
-    vTaskDelay(pdMS_TO_TICKS(3000));
-
-    // Initialize LCC/OpenMRN (FR-002)
-    // This reads node ID from /sdcard/nodeid.txt and initializes TWAI
-    ESP_LOGI(TAG, "Initializing LCC/OpenMRN...");
-    lcc_config_t lcc_cfg = LCC_CONFIG_DEFAULT();
-    ret = lcc_node_init(&lcc_cfg);
-    if (ret != ESP_OK) {
-        ESP_LOGW(TAG, "LCC initialization failed: %s - continuing without LCC", 
-                 esp_err_to_name(ret));
-        // Continue without LCC - device can still function as standalone UI
-    } else {
-        ESP_LOGI(TAG, "LCC node initialized - Node ID: %012llX, Base Event: %016llX",
-                 (unsigned long long)lcc_node_get_node_id(),
-                 (unsigned long long)lcc_node_get_base_event_id());
+        ESP_LOGW(TAG, "No SD card - running from internal flash");
+    } else if (flash_store_is_available()) {
+        sync_flash_store_with_sd();
     }
 
-    // Initialize screen timeout module (power saving)
-    ESP_LOGI(TAG, "Initializing screen timeout...");
-    screen_timeout_config_t screen_timeout_cfg = {
-        .ch422g_handle = s_ch422g,
-        .timeout_sec = lcc_node_get_screen_timeout_sec(),
-    };
-    ret = screen_timeout_init(&screen_timeout_cfg);
-    if (ret != ESP_OK) {
-        ESP_LOGW(TAG, "Screen timeout init failed: %s - power saving disabled", 
-                 esp_err_to_name(ret));
-    } else {
-        ESP_LOGI(TAG, "Screen timeout initialized: %u sec (0=disabled)",
-                 screen_timeout_cfg.timeout_sec);
-    }
+    // Ensure scenes exist (create defaults if not)
+    ensure_scenes_exist();
+    boot_phase_end(BOOT_PHASE_SD_SYNC, ESP_OK);
 
     // Initialize fade controller
     ESP_LOGI(TAG, "Initializing fade controller...");
@@ -644,6 +601,37 @@ void app_main(void)
         ESP_LOGI(TAG, "Fade controller initialized");
     }
 
+    // LCC and the UI start in parallel with the splash: the node ID and
+    // scenes are in place, and LVGL draws nothing until ui_start()
+    if (xTaskCreatePinnedToCore(boot_lcc_task, "boot_lcc", BOOT_TASK_STACK_SIZE, NULL,
+                                BOOT_TASK_PRIORITY, NULL, BOOT_TASK_CORE) != pdPASS) {
+        ESP_LOGW(TAG, "No LCC boot task - initializing LCC in sequence");
+        boot_lcc();
+    }
+    if (xTaskCreatePinnedToCore(boot_ui_task, "boot_ui", BOOT_TASK_STACK_SIZE, NULL,
+                                BOOT_TASK_PRIORITY, NULL, BOOT_TASK_CORE) != pdPASS) {
+        ESP_LOGW(TAG, "No UI boot task - building the UI in sequence");
+        boot_ui();
+    }
+
+    // Display splash image from SD card (FAT uses 8.3 filenames). After a
+    // warm restart the lights are still on, so go straight back to the UI
+    bool splash_cache_pending = false;
+    if (warm_restart_get(NULL)) {
+        ESP_LOGI(TAG, "Warm restart - skipping splash");
+    } else {
+        boot_phase_begin(BOOT_PHASE_SPLASH);
+        ret = splash_show(s_lcd_panel, CONFIG_SD_MOUNT_POINT "/SPLASH.JPG");
+        boot_phase_end(BOOT_PHASE_SPLASH, ret);
+        if (ret != ESP_OK) {
+            ESP_LOGW(TAG, "No splash image found, continuing without splash");
+        } else {
+            // First boot with this image: copy the decoded frame before
+            // LVGL draws over it; the cache is written once boot is done
+            splash_cache_pending = splash_cache_capture();
+        }
+    }
+
     // Create lighting task to run fade controller
     ESP_LOGI(TAG, "Starting lighting task...");
     BaseType_t task_ret = xTaskCreatePinnedToCore(
@@ -661,32 +649,44 @@ void app_main(void)
         ESP_LOGI(TAG, "Lighting task started");
     }
 
-    // Initialize LVGL
-    ESP_LOGI(TAG, "Initializing LVGL...");
-    lv_disp_t *disp = NULL;
-    lv_indev_t *touch_indev = NULL;
-    ret = ui_init(&disp, &touch_indev);
+    // The splash stays up until the main screen is built
+    ret = boot_phase_wait(BOOT_PHASE_LVGL);
+    if (ret == ESP_OK) {
+        ret = boot_phase_wait(BOOT_PHASE_UI);
+    }
     if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to initialize LVGL: %s", esp_err_to_name(ret));
+        ESP_LOGE(TAG, "Failed to build the UI: %s", esp_err_to_name(ret));
         while (1) {
             vTaskDelay(pdMS_TO_TICKS(5000));
             ESP_LOGE(TAG, "LVGL init failed - system halted");
         }
     }
-    ESP_LOGI(TAG, "LVGL initialized successfully");
-
-    // Show main UI (FR-010)
-    ESP_LOGI(TAG, "Showing main UI...");
-    ui_show_main();
-    ESP_LOGI(TAG, "Main UI displayed");
-
-    // Load scenes from SD card and populate Scene Selector tab
-    ESP_LOGI(TAG, "Loading scenes from SD card...");
-    scene_storage_reload_ui();
-    ESP_LOGI(TAG, "Scenes loaded");
+    ui_start();
+    boot_timeline_mark_interactive();
+    ESP_LOGI(TAG, "Main UI displayed %lld ms after boot", esp_timer_get_time() / 1000);
+#if CONFIG_RENDER_BENCHMARK_ON_BOOT
+    ui_benchmark_run();
+#endif
+#if CONFIG_DIAG_CONSOLE
+    diag_console_start();
+#endif
 
-    // Auto-apply first scene on boot if enabled
-    if (lcc_node_get_auto_apply_enabled()) {
+    // Auto-apply and resume send LCC events; the main loop ticks the screen timeout
+    boot_phase_wait(BOOT_PHASE_POWER);
+
+    // Auto-apply first scene on boot if enabled. After a warm restart the
+    // receivers kept their values, so carry on from there instead of
+    // fading up from zero
+    warm_restart_state_t warm;
+    if (warm_restart_get(&warm)) {
+        ret = fade_controller_resume(&warm.current, warm.fade_active ? &warm.plan : NULL,
+                                     warm.fade_elapsed_ms);
+        if (ret != ESP_OK) {
+            ESP_LOGW(TAG, "Failed to resume lighting state: %s", esp_err_to_name(ret));
+        } else if (fade_controller_is_active()) {
+            ui_scenes_start_progress_tracking();
+        }
+    } else if (lcc_node_get_auto_apply_enabled()) {
         ui_scene_t first_scene;
         if (scene_storage_get_first(&first_scene) == ESP_OK) {
             uint16_t duration_sec = lcc_node_get_auto_apply_duration_sec();
@@ -721,9 +721,7 @@ void app_main(void)
             } else {
                 // Start progress bar tracking (only if duration > 0)
                 if (duration_sec > 0) {
-                    ui_lock();
                     ui_scenes_start_progress_tracking();
-                    ui_unlock();
                 }
             }
         } else {
@@ -733,14 +731,27 @@ void app_main(void)
         ESP_LOGI(TAG, "Auto-apply first scene is disabled");
     }
 
+    // Written a sector at a time in the background once the UI is up and LCC
+    // has started
+    if (splash_cache_pending &&
+        xTaskCreatePinnedToCore(boot_splash_cache_task, "splash_cache", BOOT_TASK_STACK_SIZE, NULL,
+                                BOOT_TASK_PRIORITY, NULL, BOOT_TASK_CORE) != pdPASS) {
+        ESP_LOGW(TAG, "No splash cache task - writing the cache in sequence");
+        boot_splash_cache();
+    }
+
+    boot_timeline_report();
     ESP_LOGI(TAG, "Initialization complete - entering main loop");
 
     // Main loop: Run screen timeout tick and report status periodically
     TickType_t last_status_tick = xTaskGetTickCount();
     while (1) {
-        // Tick screen timeout every 500ms
+        // Tick screen timeout every 500ms. With the screen off a touch wakes
+        // it directly, so only wake for the status report.
         screen_timeout_tick();
-        vTaskDelay(pdMS_TO_TICKS(500));
+        if (!power_save_wait(pdMS_TO_TICKS(10000))) {
+            vTaskDelay(pdMS_TO_TICKS(500));
+        }
         
         // Report status every 10 seconds
         if ((xTaskGetTickCount() - last_status_tick) >= pdMS_TO_TICKS(10000)) {
@@ -749,6 +760,14 @@ void app_main(void)
                      esp_get_free_heap_size(),
                      lcc_node_get_status() == LCC_STATUS_RUNNING ? "running" : "not running",
                      screen_timeout_is_screen_on() ? "on" : "off");
+            
+            json_arena_stats_t arena;
+            json_arena_get_stats(&arena);
+            ESP_LOGI(TAG, "Memory - Internal frag: %u%%, JSON arena peak: %u/%u bytes (%lu sessions, %lu overflows)",
+                     json_arena_fragmentation_pct(heap_caps_get_free_size(MALLOC_CAP_INTERNAL),
+                                                  heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL)),
+                     (unsigned)arena.peak_used, (unsigned)arena.capacity,
+                     (unsigned long)arena.sessions, (unsigned long)arena.overflow_allocs);
         }
     }
 }
@@ -0,0 +1,410 @@
+/**
+ * @file ui_benchmark.c
+ * @brief Render benchmark across LVGL draw buffer placements and sizes
+ * 
+ * Plays the same scripted scene (carousel scroll, slider drag, modal open
+ * and close) once per draw buffer configuration and logs frame rate,
+ * frame-time percentiles and buffer memory cost for each, so the buffer
+ * location and height can be chosen from measurements.
+ * 
+ * With the PIE fill kernels built, the application's configuration is
+ * also measured with them turned off.
+ * 
+ * Each configuration temporarily replaces the display driver's draw
+ * buffers and flush callback with a plain partial-buffer setup; the
+ * application's configuration is measured first as the baseline and
+ * restored at the end.
+ */
+
+#include "ui_common.h"
+#include "esp_log.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "esp_lcd_panel_ops.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+static const char *TAG = "ui_bench";
+
+/// Frame intervals kept per configuration for percentiles
+#define BENCH_MAX_FRAMES        1024
+
+/// Scripted scene timing
+#define BENCH_SCROLL_MS         1200
+#define BENCH_SLIDER_MS         1000
+#define BENCH_MODAL_CYCLES      5
+#define BENCH_MODAL_MS          300
+#define BENCH_SETTLE_MS         300
+
+/// Scene layout (mirrors the scene selector's cards)
+#define BENCH_CARD_COUNT        12
+#define BENCH_CARD_WIDTH        240
+#define BENCH_CARD_HEIGHT       260
+#define BENCH_CARD_GAP          20
+
+/**
+ * @brief Draw buffer configuration under test
+ */
+typedef struct {
+    const char *location;   ///< Name for the log
+    uint32_t caps;          ///< heap_caps flags for the buffers
+    uint16_t lines;         ///< Buffer height in display lines
+} bench_config_t;
+
+static const bench_config_t s_configs[] = {
+    { "PSRAM",        MALLOC_CAP_SPIRAM,                      40 },
+    { "PSRAM",        MALLOC_CAP_SPIRAM,                      80 },
+    { "PSRAM",        MALLOC_CAP_SPIRAM,                      160 },
+    { "PSRAM",        MALLOC_CAP_SPIRAM,                      480 },
+    { "internal DMA", MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA,   10 },
+    { "internal DMA", MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA,   20 },
+    { "internal DMA", MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA,   40 },
+};
+
+// Frame timing collected from the display monitor callback
+static struct {
+    uint32_t intervals_us[BENCH_MAX_FRAMES];
+    uint32_t frames;
+    uint64_t render_ms;     ///< Sum of LVGL's reported render times
+    int64_t last_us;
+} s_timing;
+
+// Scripted scene objects
+static lv_obj_t *s_screen = NULL;
+static lv_obj_t *s_carousel = NULL;
+static lv_obj_t *s_slider = NULL;
+static lv_obj_t *s_slider_label = NULL;
+
+/**
+ * @brief Display monitor callback - records the interval between frames
+ */
+static void bench_monitor_cb(lv_disp_drv_t *drv, uint32_t time_ms, uint32_t px)
+{
+    int64_t now = esp_timer_get_time();
+    if (s_timing.last_us != 0 && s_timing.frames < BENCH_MAX_FRAMES) {
+        s_timing.intervals_us[s_timing.frames++] = (uint32_t)(now - s_timing.last_us);
+    }
+    s_timing.last_us = now;
+    s_timing.render_ms += time_ms;
+}
+
+/**
+ * @brief Flush callback for benchmark buffers - CPU copy into the framebuffer
+ */
+static void bench_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
+{
+    esp_lcd_panel_handle_t panel = (esp_lcd_panel_handle_t)drv->user_data;
+    esp_lcd_panel_draw_bitmap(panel, area->x1, area->y1, area->x2 + 1, area->y2 + 1, color_map);
+    lv_disp_flush_ready(drv);
+}
+
+static void slider_anim_cb(void *obj, int32_t value)
+{
+    lv_slider_set_value(obj, value, LV_ANIM_OFF);
+    lv_label_set_text_fmt(s_slider_label, "Brightness: %d", (int)value);
+}
+
+/**
+ * @brief Build the scripted scene: a card carousel, a slider and its label
+ */
+static void create_bench_screen(void)
+{
+    s_screen = lv_obj_create(NULL);
+    lv_obj_set_style_bg_color(s_screen, lv_color_make(245, 245, 245), LV_PART_MAIN);
+    
+    s_carousel = lv_obj_create(s_screen);
+    lv_obj_set_size(s_carousel, 760, BENCH_CARD_HEIGHT + 20);
+    lv_obj_align(s_carousel, LV_ALIGN_TOP_MID, 0, 10);
+    lv_obj_set_style_bg_opa(s_carousel, LV_OPA_TRANSP, LV_PART_MAIN);
+    lv_obj_set_style_border_width(s_carousel, 0, LV_PART_MAIN);
+    lv_obj_set_scroll_dir(s_carousel, LV_DIR_HOR);
+    lv_obj_set_scrollbar_mode(s_carousel, LV_SCROLLBAR_MODE_OFF);
+    lv_obj_set_flex_flow(s_carousel, LV_FLEX_FLOW_ROW);
+    lv_obj_set_style_pad_column(s_carousel, BENCH_CARD_GAP, LV_PART_MAIN);
+    
+    for (int i = 0; i < BENCH_CARD_COUNT; i++) {
+        lv_obj_t *card = lv_obj_create(s_carousel);
+        lv_obj_set_size(card, BENCH_CARD_WIDTH, BENCH_CARD_HEIGHT);
+        lv_obj_set_style_radius(card, 16, LV_PART_MAIN);
+        lv_obj_set_style_border_width(card, 2, LV_PART_MAIN);
+        lv_obj_set_style_border_color(card, lv_color_make(224, 224, 224), LV_PART_MAIN);
+        lv_obj_clear_flag(card, LV_OBJ_FLAG_SCROLLABLE);
+        
+        lv_obj_t *circle = lv_obj_create(card);
+        lv_obj_set_size(circle, 80, 80);
+        lv_obj_set_style_radius(circle, LV_RADIUS_CIRCLE, LV_PART_MAIN);
+        lv_obj_set_style_bg_color(circle, lv_color_hsv_to_rgb(i * 30, 80, 90), LV_PART_MAIN);
+        lv_obj_align(circle, LV_ALIGN_TOP_MID, 0, 30);
+        
+        lv_obj_t *name = lv_label_create(card);
+        lv_label_set_text_fmt(name, "Scene %d", i + 1);
+        lv_obj_set_style_text_font(name, &lv_font_montserrat_24, LV_PART_MAIN);
+        lv_obj_align(name, LV_ALIGN_TOP_MID, 0, 130);
+        
+        lv_obj_t *values = lv_label_create(card);
+        lv_label_set_text(values, "Brightness:200\nR:255 G:180 B:90 W:40");
+        lv_obj_set_style_text_font(values, &lv_font_montserrat_16, LV_PART_MAIN);
+        lv_obj_set_style_text_align(values, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
+        lv_obj_align(values, LV_ALIGN_BOTTOM_MID, 0, -5);
+    }
+    
+    s_slider_label = lv_label_create(s_screen);
+    lv_obj_set_style_text_font(s_slider_label, &lv_font_montserrat_20, LV_PART_MAIN);
+    lv_obj_align(s_slider_label, LV_ALIGN_BOTTOM_LEFT, 20, -70);
+    
+    s_slider = lv_slider_create(s_screen);
+    lv_slider_set_range(s_slider, 0, 255);
+    lv_obj_set_size(s_slider, 700, 20);
+    lv_obj_align(s_slider, LV_ALIGN_BOTTOM_MID, 0, -30);
+    slider_anim_cb(s_slider, 0);
+}
+
+/**
+ * @brief Open a modal like the scene edit/delete dialogs
+ */
+static lv_obj_t *open_modal(void)
+{
+    lv_obj_t *bg = lv_obj_create(s_screen);
+    lv_obj_set_size(bg, LV_PCT(100), LV_PCT(100));
+    lv_obj_set_style_bg_color(bg, lv_color_black(), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(bg, LV_OPA_50, LV_PART_MAIN);
+    lv_obj_set_style_radius(bg, 0, LV_PART_MAIN);
+    lv_obj_set_style_border_width(bg, 0, LV_PART_MAIN);
+    
+    lv_obj_t *dialog = lv_obj_create(bg);
+    lv_obj_set_size(dialog, 500, 250);
+    lv_obj_center(dialog);
+    lv_obj_set_style_radius(dialog, 16, LV_PART_MAIN);
+    
+    lv_obj_t *title = lv_label_create(dialog);
+    lv_label_set_text(title, "Delete Scene?");
+    lv_obj_set_style_text_font(title, &lv_font_montserrat_28, LV_PART_MAIN);
+    lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 10);
+    
+    lv_obj_t *btn = lv_btn_create(dialog);
+    lv_obj_set_size(btn, 180, 60);
+    lv_obj_align(btn, LV_ALIGN_BOTTOM_MID, 0, -10);
+    lv_obj_t *label = lv_label_create(btn);
+    lv_label_set_text(label, "Cancel");
+    lv_obj_center(label);
+    
+    return bg;
+}
+
+/**
+ * @brief Start an animation on the slider value under the LVGL lock
+ */
+static void start_slider_anim(int32_t from, int32_t to)
+{
+    lv_anim_t anim;
+    lv_anim_init(&anim);
+    lv_anim_set_var(&anim, s_slider);
+    lv_anim_set_exec_cb(&anim, slider_anim_cb);
+    lv_anim_set_values(&anim, from, to);
+    lv_anim_set_time(&anim, BENCH_SLIDER_MS);
+    lv_anim_start(&anim);
+}
+
+/**
+ * @brief Play the scripted scene once
+ */
+static void run_script(void)
+{
+    lv_coord_t scroll_end = (BENCH_CARD_COUNT - 3) * (BENCH_CARD_WIDTH + BENCH_CARD_GAP);
+    
+    // Carousel scroll out and back
+    ui_lock();
+    lv_obj_scroll_to_x(s_carousel, scroll_end, LV_ANIM_ON);
+    ui_unlock();
+    vTaskDelay(pdMS_TO_TICKS(BENCH_SCROLL_MS));
+    ui_lock();
+    lv_obj_scroll_to_x(s_carousel, 0, LV_ANIM_ON);
+    ui_unlock();
+    vTaskDelay(pdMS_TO_TICKS(BENCH_SCROLL_MS));
+    
+    // Slider drag up and down
+    ui_lock();
+    start_slider_anim(0, 255);
+    ui_unlock();
+    vTaskDelay(pdMS_TO_TICKS(BENCH_SLIDER_MS));
+    ui_lock();
+    start_slider_anim(255, 0);
+    ui_unlock();
+    vTaskDelay(pdMS_TO_TICKS(BENCH_SLIDER_MS));
+    
+    // Modal open and close
+    for (int i = 0; i < BENCH_MODAL_CYCLES; i++) {
+        ui_lock();
+        lv_obj_t *modal = open_modal();
+        ui_unlock();
+        vTaskDelay(pdMS_TO_TICKS(BENCH_MODAL_MS));
+        ui_lock();
+        lv_obj_del(modal);
+        ui_unlock();
+        vTaskDelay(pdMS_TO_TICKS(BENCH_MODAL_MS));
+    }
+}
+
+static int compare_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Play the script with the current buffers and log the results
+ */
+static void measure(const char *location, uint16_t lines, size_t bytes)
+{
+    ui_lock();
+    s_timing.frames = 0;
+    s_timing.render_ms = 0;
+    s_timing.last_us = 0;
+    lv_obj_invalidate(s_screen);
+    ui_unlock();
+    
+    int64_t start = esp_timer_get_time();
+    run_script();
+    int64_t elapsed_us = esp_timer_get_time() - start;
+    
+    ui_lock();
+    uint32_t frames = s_timing.frames;
+    uint64_t render_ms = s_timing.render_ms;
+    qsort(s_timing.intervals_us, frames, sizeof(uint32_t), compare_u32);
+    ui_unlock();
+    
+    if (frames == 0) {
+        ESP_LOGW(TAG, "%-12s %3u lines: no frames rendered", location, lines);
+        return;
+    }
+    
+    uint32_t p50 = s_timing.intervals_us[frames * 50 / 100];
+    uint32_t p95 = s_timing.intervals_us[frames * 95 / 100];
+    uint32_t p99 = s_timing.intervals_us[frames * 99 / 100];
+    uint32_t max = s_timing.intervals_us[frames - 1];
+    uint32_t fps_x10 = (uint32_t)((uint64_t)frames * 10000000 / elapsed_us);
+    
+    ESP_LOGI(TAG, "%-12s %3u lines %4u KB: %2lu.%lu fps, frame p50 %4.1f p95 %4.1f p99 %4.1f max %4.1f ms, "
+             "render avg %.1f ms",
+             location, lines, (unsigned)(bytes / 1024),
+             (unsigned long)(fps_x10 / 10), (unsigned long)(fps_x10 % 10),
+             p50 / 1000.0f, p95 / 1000.0f, p99 / 1000.0f, max / 1000.0f,
+             (float)render_ms / frames);
+}
+
+/**
+ * @brief Wait until LVGL has no flush in flight (call with the lock held)
+ */
+static void wait_flush_idle(lv_disp_t *disp)
+{
+    while (disp->driver->draw_buf->flushing) {
+        ui_unlock();
+        vTaskDelay(1);
+        ui_lock();
+    }
+}
+
+/**
+ * @brief Put back the application's draw buffers and flush callbacks
+ */
+static void restore_app_driver(lv_disp_drv_t *drv, const lv_disp_drv_t *saved)
+{
+    drv->draw_buf = saved->draw_buf;
+    drv->direct_mode = saved->direct_mode;
+    drv->flush_cb = saved->flush_cb;
+    drv->rounder_cb = saved->rounder_cb;
+    drv->wait_cb = saved->wait_cb;
+    lv_obj_invalidate(lv_scr_act());
+}
+
+esp_err_t ui_benchmark_run(void)
+{
+    lv_disp_t *disp = lv_disp_get_default();
+    ESP_RETURN_ON_FALSE(disp != NULL, ESP_ERR_INVALID_STATE, TAG, "LVGL not initialized");
+    
+    ESP_LOGI(TAG, "Render benchmark: %u configurations, ~%u s each",
+             (unsigned)(sizeof(s_configs) / sizeof(s_configs[0]) + (ui_draw_pie_enabled() ? 2 : 1)),
+             (unsigned)((2 * BENCH_SCROLL_MS + 2 * BENCH_SLIDER_MS +
+                         2 * BENCH_MODAL_CYCLES * BENCH_MODAL_MS + BENCH_SETTLE_MS) / 1000));
+    
+    ui_lock();
+    lv_disp_drv_t *drv = disp->driver;
+    lv_disp_drv_t saved = *drv;
+    lv_obj_t *prev_screen = lv_scr_act();
+    create_bench_screen();
+    lv_scr_load(s_screen);
+    drv->monitor_cb = bench_monitor_cb;
+    ui_unlock();
+    vTaskDelay(pdMS_TO_TICKS(BENCH_SETTLE_MS));
+    
+    // Baseline: the application's own configuration
+    lv_disp_draw_buf_t *app_buf = saved.draw_buf;
+    measure(saved.direct_mode ? "app (direct)" : "app", (uint16_t)(app_buf->size / drv->hor_res),
+            app_buf->size * sizeof(lv_color_t) * (app_buf->buf2 ? 2 : 1));
+    
+    // The same with LVGL drawing every fill, for the PIE kernels' gain
+    if (ui_draw_pie_enabled()) {
+        ui_lock();
+        ui_draw_set_pie_enabled(false);
+        ui_unlock();
+        measure("app, no PIE", (uint16_t)(app_buf->size / drv->hor_res),
+                app_buf->size * sizeof(lv_color_t) * (app_buf->buf2 ? 2 : 1));
+        ui_lock();
+        ui_draw_set_pie_enabled(true);
+        ui_unlock();
+    }
+    
+    static lv_disp_draw_buf_t bench_buf;
+    for (size_t i = 0; i < sizeof(s_configs) / sizeof(s_configs[0]); i++) {
+        const bench_config_t *cfg = &s_configs[i];
+        size_t px = (size_t)drv->hor_res * cfg->lines;
+        size_t bytes = px * sizeof(lv_color_t);
+        
+        lv_color_t *buf1 = heap_caps_aligned_alloc(64, bytes, cfg->caps);
+        lv_color_t *buf2 = heap_caps_aligned_alloc(64, bytes, cfg->caps);
+        if (!buf1 || !buf2) {
+            ESP_LOGW(TAG, "%-12s %3u lines %4u KB: skipped (not enough memory)",
+                     cfg->location, cfg->lines, (unsigned)(2 * bytes / 1024));
+            heap_caps_free(buf1);
+            heap_caps_free(buf2);
+            continue;
+        }
+        
+        ui_lock();
+        wait_flush_idle(disp);
+        lv_disp_draw_buf_init(&bench_buf, buf1, buf2, px);
+        drv->draw_buf = &bench_buf;
+        drv->direct_mode = 0;
+        drv->flush_cb = bench_flush_cb;
+        drv->rounder_cb = NULL;
+        drv->wait_cb = NULL;
+        ui_unlock();
+        
+        measure(cfg->location, cfg->lines, 2 * bytes);
+        
+        ui_lock();
+        wait_flush_idle(disp);
+        restore_app_driver(drv, &saved);
+        ui_unlock();
+        heap_caps_free(buf1);
+        heap_caps_free(buf2);
+    }
+    
+    // Restore the application's driver setup and screen
+    ui_lock();
+    wait_flush_idle(disp);
+    restore_app_driver(drv, &saved);
+    drv->monitor_cb = saved.monitor_cb;
+    lv_scr_load(prev_screen);
+    lv_obj_del(s_screen);
+    s_screen = NULL;
+    lv_obj_invalidate(prev_screen);
+    ui_unlock();
+    
+    ESP_LOGI(TAG, "Render benchmark complete");
+    return ESP_OK;
+}
@@ -9,9 +9,16 @@
 #include "esp_timer.h"
 #include "esp_lcd_panel_ops.h"
 #include "esp_lcd_touch.h"
+#include "esp_heap_caps.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/semphr.h"
+#include <string.h>
+#include <stdatomic.h>
+#if CONFIG_LVGL_FLUSH_ASYNC_DMA
+#include "esp_async_memcpy.h"
+#include "esp32s3/rom/cache.h"
+#endif
 
 // Board drivers
 #include "waveshare_lcd.h"
@@ -26,17 +33,326 @@ static const char *TAG = "ui_common";
 static lv_disp_t *s_disp = NULL;
 static lv_indev_t *s_touch_indev = NULL;
 static SemaphoreHandle_t s_lvgl_mutex = NULL;
+static TaskHandle_t s_lvgl_task = NULL;
+static SemaphoreHandle_t s_vsync_sem = NULL;
+/// LVGL paused while the screen is off (LVGL task only, see ui_set_suspended())
+static bool s_suspended = false;
+/// Nothing is drawn until ui_start(), so the boot splash stays on screen
+static volatile bool s_started = false;
+
+/// Longest wait for a vsync before releasing the buffer anyway (longer than
+/// one frame at the idle pixel clock)
+#define VSYNC_TIMEOUT_MS    100
+
+#if CONFIG_LCD_OFF_PIXEL_CLOCK_HZ > 0
+/// One frame at the screen-off pixel clock, with the same margin
+#define VSYNC_OFF_TIMEOUT_MS    (1000ULL * (CONFIG_LCD_H_RES + LCD_H_BLANK_PX) * \
+                                 (CONFIG_LCD_V_RES + LCD_V_BLANK_LINES) / CONFIG_LCD_OFF_PIXEL_CLOCK_HZ + 50)
+#endif
+
+#if CONFIG_LVGL_FLUSH_ASYNC_DMA
+/// PSRAM DMA alignment; one data cache line so invalidation never touches a neighbour
+#define FLUSH_DMA_ALIGN         64
+#define FLUSH_DMA_ALIGN_PX      (FLUSH_DMA_ALIGN / sizeof(lv_color_t))
+/// Queued transfers; rows beyond this are copied by the CPU
+#define FLUSH_DMA_BACKLOG       128
+/// Longest wait for a flush before LVGL re-checks (guards a lost interrupt)
+#define FLUSH_DMA_TIMEOUT_MS    100
+
+static struct {
+    async_memcpy_t handle;
+    void *framebuffer;
+    lv_disp_drv_t *drv;
+    size_t xfer_bytes;          ///< Bytes per transfer of the current flush
+    uint32_t pending;           ///< Transfers of the current flush not yet complete
+    portMUX_TYPE lock;
+    SemaphoreHandle_t done;     ///< Given when the current flush completes
+} s_flush_dma = {
+    .lock = portMUX_INITIALIZER_UNLOCKED,
+};
+#endif
+
+// LVGL task CPU time (excluding time blocked waiting for a flush)
+static int64_t s_lvgl_busy_us = 0;
+static int64_t s_lvgl_wait_us = 0;
 
 // Hardware handles (from main)
 extern esp_lcd_panel_handle_t s_lcd_panel;
 extern esp_lcd_touch_handle_t s_touch;
 
+#if CONFIG_TOUCH_INTERRUPT
+#define TOUCH_TASK_STACK_SIZE   3072
+/// Above the LVGL task so a report is published before the next frame
+#define TOUCH_TASK_PRIORITY     (UI_LVGL_TASK_PRIORITY + 1)
+/// Re-read interval while pressed if no interrupt arrives
+#define TOUCH_RELEASE_POLL_MS   50
+
+// Latest touch as one aligned word (written by the touch task, read by LVGL):
+// bits 0-11 x, bits 12-23 y, bit 31 pressed
+#define TOUCH_STATE_X_MASK      0xFFF
+#define TOUCH_STATE_Y_SHIFT     12
+#define TOUCH_STATE_PRESSED     BIT31
+
+static volatile uint32_t s_touch_state = 0;
+static TaskHandle_t s_touch_task = NULL;
+#endif
+
+/// Command queue slots (power of two)
+#define UI_CMD_QUEUE_LEN        32
+
+/**
+ * @brief Command queue slot
+ * 
+ * Bounded MPSC ring: a slot at position pos is free for a producer when
+ * seq == pos and holds a command for the LVGL task when seq == pos + 1.
+ */
+typedef struct {
+    atomic_uint seq;
+    ui_cmd_fn_t fn;
+    void *arg;
+} ui_cmd_slot_t;
+
+static struct {
+    ui_cmd_slot_t slots[UI_CMD_QUEUE_LEN];
+    atomic_uint enqueue_pos;    ///< Claimed by producers with CAS
+    unsigned dequeue_pos;       ///< Owned by the LVGL task
+    atomic_bool ready;
+    atomic_uint dropped;        ///< Posts refused because the queue was full
+} s_cmd_queue;
+
+#if CONFIG_LVGL_RENDER_ON_DEMAND
+// Idle tracking: the panel drops to the idle pixel clock once nothing has
+// been redrawn or touched for LCD_IDLE_AFTER_MS
+static struct {
+    bool idle;
+    int64_t last_active_us;     ///< Last render, touch or pending refresh
+    int64_t idle_start_us;
+    int64_t idle_busy_start_us; ///< s_lvgl_busy_us when idle began
+    uint32_t idle_wakeups;      ///< LVGL task wake-ups while idle
+} s_on_demand;
+#endif
+
+/// Dimming snapshot: one full screen, aligned for the PIE kernel and GDMA
+#define DIM_SNAPSHOT_PX     (CONFIG_LCD_H_RES * CONFIG_LCD_V_RES)
+#define DIM_SNAPSHOT_ALIGN  64
+
+// Screen dimming pass (LVGL task only, see ui_dim_to())
+static struct {
+    uint16_t *snapshot;         ///< UI at full level, source of every dimmed frame
+    uint16_t level;             ///< Level on screen (UI_DIM_LEVEL_MAX = LVGL draws normally)
+    uint16_t from_level;
+    uint16_t to_level;
+    uint32_t duration_ms;
+    int64_t start_us;
+    uint32_t frames;            ///< Frames presented in the current fade
+    int64_t first_frame_us;     ///< When the current fade presented its first frame
+    bool fading;
+    bool capturing;             ///< Flushes go to the snapshot instead of the panel
+    ui_dim_done_cb_t done_cb;
+#if CONFIG_LVGL_DIRECT_MODE
+    lv_color_t *front;          ///< Framebuffer being scanned out while dimmed
+#else
+    void *framebuffer;          ///< Panel framebuffer LVGL flushes into
+#endif
+} s_dim = {
+    .level = UI_DIM_LEVEL_MAX,
+};
+
 // Forward declarations
 static void lvgl_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map);
 static void lvgl_touch_cb(lv_indev_drv_t *drv, lv_indev_data_t *data);
+#if !CONFIG_LV_TICK_CUSTOM
 static void lvgl_tick_timer_cb(void *arg);
+#endif
 static void lvgl_task(void *arg);
 
+/**
+ * @brief VSYNC callback (ISR context) - signals that a frame has been scanned out
+ */
+static bool IRAM_ATTR lvgl_vsync_cb(esp_lcd_panel_handle_t panel,
+                                    const esp_lcd_rgb_panel_event_data_t *edata, void *user_ctx)
+{
+    BaseType_t high_task_awoken = pdFALSE;
+    xSemaphoreGiveFromISR(s_vsync_sem, &high_task_awoken);
+    return high_task_awoken == pdTRUE;
+}
+
+#if !CONFIG_LVGL_DIRECT_MODE
+/**
+ * @brief Copy a flushed area into the dimming snapshot instead of the panel
+ */
+static void dim_capture_area(const lv_area_t *area, const lv_color_t *color_map)
+{
+    size_t row_px = lv_area_get_width(area);
+    for (lv_coord_t y = area->y1; y <= area->y2; y++) {
+        memcpy(&s_dim.snapshot[y * CONFIG_LCD_H_RES + area->x1], color_map, row_px * sizeof(lv_color_t));
+        color_map += row_px;
+    }
+}
+#endif
+
+#if CONFIG_LVGL_DIRECT_MODE
+/**
+ * @brief LVGL flush callback - presents a finished framebuffer
+ * 
+ * In direct mode LVGL renders straight into the panel's two framebuffers,
+ * so there is nothing to copy. Once the last dirty area of a frame is
+ * drawn, the buffer is handed to the panel (a pointer switch that takes
+ * effect at the next frame start) and LVGL is released only after the
+ * following vsync, when the previous buffer is no longer being scanned
+ * out. LVGL then copies this frame's dirty areas into the other buffer
+ * before drawing the next frame (refr_sync_areas), keeping both in sync.
+ */
+static void lvgl_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
+{
+    esp_lcd_panel_handle_t panel = (esp_lcd_panel_handle_t)drv->user_data;
+    int64_t start = esp_timer_get_time();
+    
+    // Dimming snapshot: leave the frame in the hidden buffer for ui_dim_to()
+    if (s_dim.capturing) {
+        lv_disp_flush_ready(drv);
+        return;
+    }
+    
+    if (lv_disp_flush_is_last(drv)) {
+        // Drop a vsync that arrived while rendering, then wait for the swap
+        xSemaphoreTake(s_vsync_sem, 0);
+        esp_lcd_panel_draw_bitmap(panel, 0, 0, drv->hor_res, drv->ver_res, color_map);
+        xSemaphoreTake(s_vsync_sem, pdMS_TO_TICKS(VSYNC_TIMEOUT_MS));
+    }
+    
+    ui_perf_record_flush((uint32_t)(esp_timer_get_time() - start));
+    lv_disp_flush_ready(drv);
+}
+#elif CONFIG_LVGL_FLUSH_ASYNC_DMA
+/**
+ * @brief Round flushed areas out to whole cache lines per row
+ * 
+ * Lets every row be DMA'd into the PSRAM framebuffer and its cache lines
+ * invalidated without touching pixels outside the area.
+ */
+static void lvgl_rounder_cb(lv_disp_drv_t *drv, lv_area_t *area)
+{
+    area->x1 &= ~(lv_coord_t)(FLUSH_DMA_ALIGN_PX - 1);
+    area->x2 |= (lv_coord_t)(FLUSH_DMA_ALIGN_PX - 1);
+}
+
+/**
+ * @brief Finish one transfer of the current flush
+ * 
+ * Safe from ISR and task context. The last transfer releases LVGL's draw
+ * buffer and wakes the LVGL task if it is waiting for it.
+ * 
+ * @return true if a higher-priority task was woken
+ */
+static bool IRAM_ATTR flush_dma_complete(uint32_t transfers, bool from_isr)
+{
+    BaseType_t high_task_awoken = pdFALSE;
+    bool last;
+    
+    if (from_isr) {
+        portENTER_CRITICAL_ISR(&s_flush_dma.lock);
+    } else {
+        portENTER_CRITICAL(&s_flush_dma.lock);
+    }
+    s_flush_dma.pending -= transfers;
+    last = (s_flush_dma.pending == 0);
+    if (from_isr) {
+        portEXIT_CRITICAL_ISR(&s_flush_dma.lock);
+    } else {
+        portEXIT_CRITICAL(&s_flush_dma.lock);
+    }
+    
+    if (last) {
+        lv_disp_flush_ready(s_flush_dma.drv);
+        if (from_isr) {
+            xSemaphoreGiveFromISR(s_flush_dma.done, &high_task_awoken);
+        } else {
+            xSemaphoreGive(s_flush_dma.done);
+        }
+    }
+    return high_task_awoken == pdTRUE;
+}
+
+/**
+ * @brief GDMA completion callback (ISR context) for one flush transfer
+ */
+static bool IRAM_ATTR flush_dma_done_cb(async_memcpy_t mcp, async_memcpy_event_t *event, void *cb_args)
+{
+    // The bounce buffer ISR reads the framebuffer through the cache
+    Cache_Invalidate_Addr((uint32_t)cb_args, s_flush_dma.xfer_bytes);
+    return flush_dma_complete(1, true);
+}
+
+/**
+ * @brief LVGL wait callback - block until the in-flight flush completes
+ * 
+ * Without this LVGL spins on CPU1 while the DMA runs.
+ */
+static void lvgl_flush_wait_cb(lv_disp_drv_t *drv)
+{
+    int64_t start = esp_timer_get_time();
+    xSemaphoreTake(s_flush_dma.done, pdMS_TO_TICKS(FLUSH_DMA_TIMEOUT_MS));
+    int64_t waited = esp_timer_get_time() - start;
+    s_lvgl_wait_us += waited;
+    ui_perf_record_flush((uint32_t)waited);
+}
+
+/**
+ * @brief LVGL flush callback - queues a GDMA copy into the framebuffer
+ * 
+ * Returns as soon as the copy is queued; flush-ready is signalled from the
+ * DMA completion ISR, so LVGL renders the next chunk into the other draw
+ * buffer while this one is copied. Full-width areas are one contiguous
+ * transfer, narrower areas one transfer per row.
+ */
+static void lvgl_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
+{
+    if (s_dim.capturing) {
+        dim_capture_area(area, color_map);
+        lv_disp_flush_ready(drv);
+        return;
+    }
+    
+    size_t stride = drv->hor_res * sizeof(lv_color_t);
+    size_t row_bytes = lv_area_get_width(area) * sizeof(lv_color_t);
+    uint32_t rows = lv_area_get_height(area);
+    uint8_t *dst = (uint8_t *)s_flush_dma.framebuffer + area->y1 * stride + area->x1 * sizeof(lv_color_t);
+    uint8_t *src = (uint8_t *)color_map;
+    
+    bool contiguous = (row_bytes == stride);
+    uint32_t transfers = contiguous ? 1 : rows;
+    
+    // DMA reads PSRAM directly: write the rendered pixels back from the
+    // cache, and any dirty framebuffer lines so they can't be evicted over
+    // the DMA'd data later
+    Cache_WriteBack_Addr((uint32_t)src, row_bytes * rows);
+    Cache_WriteBack_Addr((uint32_t)dst, (rows - 1) * stride + row_bytes);
+    
+    s_flush_dma.drv = drv;
+    s_flush_dma.xfer_bytes = contiguous ? row_bytes * rows : row_bytes;
+    s_flush_dma.pending = transfers;
+    xSemaphoreTake(s_flush_dma.done, 0);
+    
+    uint32_t queued = 0;
+    for (; queued < transfers; queued++) {
+        size_t offset_dst = queued * stride;
+        size_t offset_src = queued * row_bytes;
+        if (esp_async_memcpy(s_flush_dma.handle, dst + offset_dst, src + offset_src,
+                             s_flush_dma.xfer_bytes, flush_dma_done_cb, dst + offset_dst) != ESP_OK) {
+            break;
+        }
+    }
+    
+    if (queued < transfers) {
+        // Out of DMA descriptors: copy the remaining rows on the CPU
+        for (uint32_t row = queued; row < transfers; row++) {
+            memcpy(dst + row * stride, src + row * row_bytes, row_bytes);
+        }
+        flush_dma_complete(transfers - queued, false);
+    }
+}
+#else
 /**
  * @brief LVGL flush callback - copies framebuffer to LCD
  */
@@ -47,13 +363,93 @@ static void lvgl_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t
     int offsety1 = area->y1;
     int offsetx2 = area->x2;
     int offsety2 = area->y2;
+    int64_t start = esp_timer_get_time();
+    
+    if (s_dim.capturing) {
+        dim_capture_area(area, color_map);
+        lv_disp_flush_ready(drv);
+        return;
+    }
     
     // Draw bitmap to LCD
     esp_lcd_panel_draw_bitmap(panel, offsetx1, offsety1, offsetx2 + 1, offsety2 + 1, color_map);
     
+    ui_perf_record_flush((uint32_t)(esp_timer_get_time() - start));
     lv_disp_flush_ready(drv);
 }
+#endif
 
+#if CONFIG_TOUCH_INTERRUPT
+/**
+ * @brief GT911 INT handler - wakes the touch task
+ */
+static void IRAM_ATTR touch_isr_cb(esp_lcd_touch_handle_t tp)
+{
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(s_touch_task, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief Touch task - reads the GT911 only when it raises INT
+ * 
+ * The controller pulses INT for every report while a finger is down and
+ * once more on release, so the I2C bus is idle while nobody touches the
+ * screen. The result is published as one word for the LVGL read callback.
+ */
+static void touch_task(void *arg)
+{
+    esp_lcd_touch_handle_t touch = (esp_lcd_touch_handle_t)arg;
+    bool pressed = false;
+
+    ESP_LOGI(TAG, "Touch task started");
+
+    while (1) {
+        // While pressed, time out and re-read in case the release edge is missed
+        ulTaskNotifyTake(pdTRUE, pressed ? pdMS_TO_TICKS(TOUCH_RELEASE_POLL_MS) : portMAX_DELAY);
+
+        esp_lcd_touch_read_data(touch);
+
+        esp_lcd_touch_point_data_t point_data;
+        uint8_t point_cnt = 0;
+        esp_err_t ret = esp_lcd_touch_get_data(touch, &point_data, &point_cnt, 1);
+        pressed = (ret == ESP_OK && point_cnt > 0);
+
+        // Released keeps the last point so LVGL sees the release where it happened
+        uint32_t state = s_touch_state & ~TOUCH_STATE_PRESSED;
+        if (pressed) {
+            // Always notify screen timeout so the wake-up is triggered
+            screen_timeout_notify_activity();
+
+            // Only forward the touch to LVGL when the screen is fully on, so
+            // the waking touch doesn't trigger UI actions
+            if (screen_timeout_is_interactive()) {
+                state = TOUCH_STATE_PRESSED |
+                        ((uint32_t)point_data.y << TOUCH_STATE_Y_SHIFT) |
+                        (point_data.x & TOUCH_STATE_X_MASK);
+            }
+        }
+        s_touch_state = state;
+#if CONFIG_LVGL_RENDER_ON_DEMAND
+        if (s_lvgl_task != NULL) {
+            xTaskNotifyGive(s_lvgl_task);
+        }
+#endif
+    }
+}
+
+/**
+ * @brief LVGL touch read callback - latest point from the touch task
+ */
+static void lvgl_touch_cb(lv_indev_drv_t *drv, lv_indev_data_t *data)
+{
+    uint32_t state = s_touch_state;
+
+    data->point.x = state & TOUCH_STATE_X_MASK;
+    data->point.y = (state >> TOUCH_STATE_Y_SHIFT) & TOUCH_STATE_X_MASK;
+    data->state = (state & TOUCH_STATE_PRESSED) ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+#else
 /**
  * @brief LVGL touch read callback
  */
@@ -88,7 +484,9 @@ static void lvgl_touch_cb(lv_indev_drv_t *drv, lv_indev_data_t *data)
         data->state = LV_INDEV_STATE_RELEASED;
     }
 }
+#endif
 
+#if !CONFIG_LV_TICK_CUSTOM
 /**
  * @brief LVGL tick timer callback
  */
@@ -96,6 +494,307 @@ static void lvgl_tick_timer_cb(void *arg)
 {
     lv_tick_inc(UI_LVGL_TICK_PERIOD_MS);
 }
+#endif
+
+#if CONFIG_LVGL_RENDER_ON_DEMAND
+/**
+ * @brief Panel scan-out bandwidth from PSRAM at a pixel clock (bytes/s)
+ */
+static uint32_t scanout_bytes_per_sec(uint32_t pclk_hz)
+{
+    uint64_t frame_clocks = (uint64_t)(CONFIG_LCD_H_RES + LCD_H_BLANK_PX) *
+                            (CONFIG_LCD_V_RES + LCD_V_BLANK_LINES);
+    uint64_t frame_bytes = (uint64_t)CONFIG_LCD_H_RES * CONFIG_LCD_V_RES * sizeof(lv_color_t);
+    return (uint32_t)(frame_bytes * pclk_hz / frame_clocks);
+}
+
+/**
+ * @brief Restore the full pixel clock and log what the idle period cost
+ */
+static void leave_idle(int64_t now)
+{
+    s_on_demand.idle = false;
+#if CONFIG_LCD_IDLE_PIXEL_CLOCK_HZ > 0
+    waveshare_lcd_set_pixel_clock(s_lcd_panel, CONFIG_LCD_PIXEL_CLOCK_HZ);
+#endif
+
+    int64_t idle_us = now - s_on_demand.idle_start_us;
+    if (idle_us <= 0) {
+        return;
+    }
+    int64_t busy_us = s_lvgl_busy_us - s_on_demand.idle_busy_start_us;
+#if CONFIG_LCD_IDLE_PIXEL_CLOCK_HZ > 0
+    uint32_t idle_pclk = CONFIG_LCD_IDLE_PIXEL_CLOCK_HZ;
+#else
+    uint32_t idle_pclk = CONFIG_LCD_PIXEL_CLOCK_HZ;
+#endif
+    ESP_LOGI(TAG, "Idle %.1f s: %.1f wakeups/s, LVGL CPU1 %.2f%%, "
+             "PSRAM scan-out %.1f MB/s (%.1f MB/s active)",
+             idle_us / 1e6, s_on_demand.idle_wakeups * 1e6 / idle_us,
+             busy_us * 100.0 / idle_us, scanout_bytes_per_sec(idle_pclk) / 1e6,
+             scanout_bytes_per_sec(CONFIG_LCD_PIXEL_CLOCK_HZ) / 1e6);
+}
+
+/**
+ * @brief Prepare a pass of lv_timer_handler() (called with the mutex held)
+ * 
+ * Restarts input reads if the touch task reported a press, and brings the
+ * panel out of idle if this pass will touch or redraw anything.
+ */
+static void render_on_demand_begin(void)
+{
+    int64_t now = esp_timer_get_time();
+    bool touched = (s_touch_state & TOUCH_STATE_PRESSED) != 0;
+
+    if (touched) {
+        lv_timer_t *read_timer = lv_indev_get_read_timer(s_touch_indev);
+        lv_timer_resume(read_timer);
+        lv_timer_ready(read_timer);
+    }
+
+    if (s_on_demand.idle) {
+        s_on_demand.idle_wakeups++;
+    }
+    if (touched || !s_disp->refr_timer->paused || s_dim.fading) {
+        s_on_demand.last_active_us = now;
+        if (s_on_demand.idle) {
+            leave_idle(now);
+        }
+    }
+}
+
+/**
+ * @brief Finish a pass of lv_timer_handler() (called with the mutex held)
+ * 
+ * Stops input reads once the finger is up and LVGL has finished the
+ * release and any scroll throw, and idles the panel after a quiet spell.
+ */
+static void render_on_demand_end(void)
+{
+    int64_t now = esp_timer_get_time();
+    lv_timer_t *read_timer = lv_indev_get_read_timer(s_touch_indev);
+
+    if (!(s_touch_state & TOUCH_STATE_PRESSED) &&
+        s_touch_indev->proc.state == LV_INDEV_STATE_RELEASED &&
+        lv_indev_get_scroll_obj(s_touch_indev) == NULL) {
+        lv_timer_pause(read_timer);
+    }
+
+    if (!read_timer->paused || !s_disp->refr_timer->paused || s_dim.fading) {
+        s_on_demand.last_active_us = now;
+    } else if (!s_on_demand.idle &&
+               now - s_on_demand.last_active_us >= CONFIG_LCD_IDLE_AFTER_MS * 1000LL) {
+        s_on_demand.idle = true;
+        s_on_demand.idle_start_us = now;
+        s_on_demand.idle_busy_start_us = s_lvgl_busy_us;
+        s_on_demand.idle_wakeups = 0;
+#if CONFIG_LCD_IDLE_PIXEL_CLOCK_HZ > 0
+        waveshare_lcd_set_pixel_clock(s_lcd_panel, CONFIG_LCD_IDLE_PIXEL_CLOCK_HZ);
+#endif
+    }
+}
+#endif
+
+/**
+ * @brief Run the commands posted with ui_post() (LVGL task, mutex held)
+ * 
+ * Runs at most one queue's worth per cycle so a command that posts
+ * another cannot keep the task from rendering.
+ */
+static void ui_cmd_drain(void)
+{
+    for (int i = 0; i < UI_CMD_QUEUE_LEN; i++) {
+        ui_cmd_slot_t *slot = &s_cmd_queue.slots[s_cmd_queue.dequeue_pos & (UI_CMD_QUEUE_LEN - 1)];
+        unsigned seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        if ((int)(seq - (s_cmd_queue.dequeue_pos + 1)) < 0) {
+            break;  // Empty, or a producer has claimed the slot but not filled it yet
+        }
+        
+        ui_cmd_fn_t fn = slot->fn;
+        void *arg = slot->arg;
+        atomic_store_explicit(&slot->seq, s_cmd_queue.dequeue_pos + UI_CMD_QUEUE_LEN, memory_order_release);
+        s_cmd_queue.dequeue_pos++;
+        
+        fn(arg);
+    }
+    
+    unsigned dropped = atomic_exchange_explicit(&s_cmd_queue.dropped, 0, memory_order_relaxed);
+    if (dropped) {
+        ESP_LOGW(TAG, "UI command queue full, dropped %u command(s)", dropped);
+    }
+}
+
+#if CONFIG_LVGL_DIRECT_MODE
+/**
+ * @brief The panel framebuffer that is not @p buf
+ */
+static lv_color_t *dim_other_buffer(const lv_color_t *buf)
+{
+    lv_disp_draw_buf_t *draw_buf = lv_disp_get_draw_buf(s_disp);
+    return (buf == draw_buf->buf1) ? draw_buf->buf2 : draw_buf->buf1;
+}
+#endif
+
+/**
+ * @brief Render the whole UI into the dimming snapshot without showing it
+ * 
+ * LVGL draws with invalidation briefly re-enabled; the flush callbacks
+ * divert the frame (direct mode leaves it in the hidden framebuffer).
+ */
+static void dim_capture(void)
+{
+#if CONFIG_LVGL_DIRECT_MODE
+    lv_disp_draw_buf_t *draw_buf = lv_disp_get_draw_buf(s_disp);
+    if (s_dim.level == UI_DIM_LEVEL_MAX) {
+        // LVGL's last frame is on screen; it draws the next into the other buffer
+        s_dim.front = dim_other_buffer(draw_buf->buf_act);
+    }
+    lv_color_t *hidden = dim_other_buffer(s_dim.front);
+    draw_buf->buf_act = hidden;
+#endif
+    
+    lv_disp_enable_invalidation(s_disp, true);
+    lv_obj_invalidate(lv_scr_act());
+    s_dim.capturing = true;
+    lv_refr_now(s_disp);
+    s_dim.capturing = false;
+    lv_disp_enable_invalidation(s_disp, false);
+    
+#if CONFIG_LVGL_DIRECT_MODE
+    memcpy(s_dim.snapshot, hidden, DIM_SNAPSHOT_PX * sizeof(lv_color_t));
+#endif
+}
+
+/**
+ * @brief Show the snapshot scaled to a level, synchronised to vsync
+ */
+static void dim_present(uint16_t level)
+{
+#if CONFIG_LVGL_DIRECT_MODE
+    // Dim into the hidden buffer and switch to it at the next frame start
+    lv_color_t *back = dim_other_buffer(s_dim.front);
+    ui_dim_rgb565((uint16_t *)back, s_dim.snapshot, DIM_SNAPSHOT_PX, level);
+    xSemaphoreTake(s_vsync_sem, 0);
+    esp_lcd_panel_draw_bitmap(s_lcd_panel, 0, 0, CONFIG_LCD_H_RES, CONFIG_LCD_V_RES, back);
+    xSemaphoreTake(s_vsync_sem, pdMS_TO_TICKS(VSYNC_TIMEOUT_MS));
+    s_dim.front = back;
+#else
+    // One framebuffer: rewrite it in place from the top of a frame, so a
+    // tear, if the scan overtakes the write, is a single level step
+    xSemaphoreTake(s_vsync_sem, 0);
+    xSemaphoreTake(s_vsync_sem, pdMS_TO_TICKS(VSYNC_TIMEOUT_MS));
+    ui_dim_rgb565((uint16_t *)s_dim.framebuffer, s_dim.snapshot, DIM_SNAPSHOT_PX, level);
+#endif
+}
+
+/**
+ * @brief Hand the screen back to LVGL after fading up to full level
+ */
+static void dim_release(void)
+{
+#if CONFIG_LVGL_DIRECT_MODE
+    // LVGL draws its next frame into the buffer that is not on screen
+    lv_disp_get_draw_buf(s_disp)->buf_act = dim_other_buffer(s_dim.front);
+#endif
+    // Redraw everything: the framebuffers hold dimmed frames, and changes
+    // made while dimmed were not invalidated
+    lv_disp_enable_invalidation(s_disp, true);
+    lv_obj_invalidate(lv_scr_act());
+}
+
+/**
+ * @brief Present the next frame of a fade (LVGL task, mutex held)
+ */
+static void dim_frame(void)
+{
+    uint32_t elapsed_ms = (uint32_t)((esp_timer_get_time() - s_dim.start_us) / 1000);
+    uint16_t level = s_dim.to_level;
+    if (elapsed_ms < s_dim.duration_ms) {
+        int32_t span = (int32_t)s_dim.to_level - (int32_t)s_dim.from_level;
+        level = (uint16_t)(s_dim.from_level + span * (int32_t)elapsed_ms / (int32_t)s_dim.duration_ms);
+    }
+    
+    dim_present(level);
+    s_dim.level = level;
+    if (s_dim.frames++ == 0) {
+        s_dim.first_frame_us = esp_timer_get_time();
+    }
+    
+    if (level != s_dim.to_level) {
+        return;
+    }
+    
+    ESP_LOGD(TAG, "Dimmed %u -> %u in %lu frames", s_dim.from_level, level,
+             (unsigned long)s_dim.frames);
+    s_dim.fading = false;
+    if (level == UI_DIM_LEVEL_MAX) {
+        dim_release();
+    }
+    
+    ui_dim_done_cb_t done_cb = s_dim.done_cb;
+    s_dim.done_cb = NULL;
+    if (done_cb) {
+        done_cb();
+    }
+}
+
+esp_err_t ui_dim_to(uint16_t level, uint32_t duration_ms, ui_dim_done_cb_t done_cb)
+{
+    ESP_RETURN_ON_FALSE(level <= UI_DIM_LEVEL_MAX, ESP_ERR_INVALID_ARG, TAG, "Invalid dim level %u", level);
+    
+    if (!s_dim.fading && s_dim.level == level) {
+        if (done_cb) {
+            done_cb();
+        }
+        return ESP_OK;
+    }
+    
+    if (s_dim.snapshot == NULL) {
+        // Kept once allocated, so a wake never fails for want of a contiguous block
+        s_dim.snapshot = heap_caps_aligned_alloc(DIM_SNAPSHOT_ALIGN, DIM_SNAPSHOT_PX * sizeof(lv_color_t),
+                                                 MALLOC_CAP_SPIRAM);
+        ESP_RETURN_ON_FALSE(s_dim.snapshot != NULL, ESP_ERR_NO_MEM, TAG, "No memory for the dimming snapshot");
+    }
+    
+    // From a held or undimmed screen, fade from the UI as it is now
+    if (!s_dim.fading) {
+        dim_capture();
+    }
+    
+    s_dim.from_level = s_dim.level;
+    s_dim.to_level = level;
+    s_dim.duration_ms = duration_ms;
+    s_dim.start_us = esp_timer_get_time();
+    s_dim.frames = 0;
+    s_dim.done_cb = done_cb;
+    s_dim.fading = true;
+    return ESP_OK;
+}
+
+int64_t ui_dim_get_first_frame_us(void)
+{
+    return s_dim.first_frame_us;
+}
+
+void ui_set_suspended(bool suspended)
+{
+    if (suspended == s_suspended) {
+        return;
+    }
+    
+    s_suspended = suspended;
+#if CONFIG_LCD_OFF_PIXEL_CLOCK_HZ > 0
+    // Takes effect at the next frame boundary. On resume, wait for it so
+    // the fade-in starts on the normal clock and its vsync waits hold.
+    waveshare_lcd_set_pixel_clock(s_lcd_panel,
+                                  suspended ? CONFIG_LCD_OFF_PIXEL_CLOCK_HZ : CONFIG_LCD_PIXEL_CLOCK_HZ);
+    if (!suspended) {
+        xSemaphoreTake(s_vsync_sem, 0);
+        xSemaphoreTake(s_vsync_sem, pdMS_TO_TICKS(VSYNC_OFF_TIMEOUT_MS));
+    }
+#endif
+    ESP_LOGI(TAG, "LVGL %s", suspended ? "suspended" : "resumed");
+}
 
 /**
  * @brief LVGL task - handles rendering and input
@@ -104,12 +803,49 @@ static void lvgl_task(void *arg)
 {
     ESP_LOGI(TAG, "LVGL task started");
 
+    int64_t wait_start = esp_timer_get_time();
     while (1) {
         // Lock mutex
         if (xSemaphoreTake(s_lvgl_mutex, pdMS_TO_TICKS(10)) == pdTRUE) {
+            int64_t start = esp_timer_get_time();
+            ui_cmd_drain();
+            if (s_suspended || !s_started) {
+                // Screen off or splash still up: only commands run until
+                // LVGL is resumed or started
+                xSemaphoreGive(s_lvgl_mutex);
+                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+                wait_start = esp_timer_get_time();
+                continue;
+            }
+#if CONFIG_LVGL_RENDER_ON_DEMAND
+            render_on_demand_begin();
+#endif
             uint32_t task_delay_ms = lv_timer_handler();
+            if (s_dim.fading) {
+                // Paced by the vsync wait in dim_present()
+                dim_frame();
+                task_delay_ms = 0;
+            }
+#if CONFIG_LVGL_RENDER_ON_DEMAND
+            render_on_demand_end();
+#endif
+            int64_t end = esp_timer_get_time();
+            s_lvgl_busy_us += end - start;
+            ui_perf_record_loop((uint32_t)(start - wait_start), (uint32_t)(end - start));
             xSemaphoreGive(s_lvgl_mutex);
             
+#if CONFIG_LVGL_RENDER_ON_DEMAND
+            // Sleep until the next LVGL timer is due; touches, ui_post() and
+            // ui_unlock() from other tasks wake the task early
+            TickType_t wait_ticks = portMAX_DELAY;
+            if (task_delay_ms != LV_NO_TIMER_READY) {
+                if (task_delay_ms < UI_LVGL_TASK_MIN_DELAY_MS) {
+                    task_delay_ms = UI_LVGL_TASK_MIN_DELAY_MS;
+                }
+                wait_ticks = pdMS_TO_TICKS(task_delay_ms);
+            }
+            ulTaskNotifyTake(pdTRUE, wait_ticks);
+#else
             // Clamp delay
             if (task_delay_ms > UI_LVGL_TASK_MAX_DELAY_MS) {
                 task_delay_ms = UI_LVGL_TASK_MAX_DELAY_MS;
@@ -117,7 +853,10 @@ static void lvgl_task(void *arg)
                 task_delay_ms = UI_LVGL_TASK_MIN_DELAY_MS;
             }
             
-            vTaskDelay(pdMS_TO_TICKS(task_delay_ms));
+            // ui_post() wakes the task early
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(task_delay_ms));
+#endif
+            wait_start = esp_timer_get_time();
         } else {
             vTaskDelay(pdMS_TO_TICKS(UI_LVGL_TASK_MIN_DELAY_MS));
         }
@@ -137,16 +876,78 @@ esp_err_t ui_init(lv_disp_t **disp, lv_indev_t **touch_indev)
     // Create mutex
     s_lvgl_mutex = xSemaphoreCreateMutex();
     ESP_RETURN_ON_FALSE(s_lvgl_mutex != NULL, ESP_ERR_NO_MEM, TAG, "Failed to create mutex");
+    
+    // Every command queue slot starts free for the first pass of the ring
+    for (unsigned i = 0; i < UI_CMD_QUEUE_LEN; i++) {
+        atomic_init(&s_cmd_queue.slots[i].seq, i);
+    }
 
     // Initialize LVGL
     lv_init();
 
+#if CONFIG_LVGL_DIRECT_MODE
+    // Render directly into the panel's two framebuffers. Start with the one
+    // not being scanned out (fb0 holds the splash image).
+    size_t buffer_size = CONFIG_LCD_H_RES * CONFIG_LCD_V_RES;
+    void *fb0 = NULL;
+    void *fb1 = NULL;
+    ESP_RETURN_ON_ERROR(
+        waveshare_lcd_get_frame_buffer(s_lcd_panel, 2, &fb0, &fb1),
+        TAG, "Failed to get panel framebuffers (num_fb must be 2)"
+    );
+    lv_color_t *buf1 = fb1;
+    lv_color_t *buf2 = fb0;
+#elif CONFIG_LVGL_FLUSH_ASYNC_DMA
+    // Draw buffers aligned for GDMA; flushes are DMA'd into the framebuffer
+    size_t buffer_size = CONFIG_LCD_H_RES * CONFIG_LCD_RGB_BOUNCE_BUFFER_HEIGHT;
+    lv_color_t *buf1 = heap_caps_aligned_alloc(FLUSH_DMA_ALIGN, buffer_size * sizeof(lv_color_t), MALLOC_CAP_SPIRAM);
+    lv_color_t *buf2 = heap_caps_aligned_alloc(FLUSH_DMA_ALIGN, buffer_size * sizeof(lv_color_t), MALLOC_CAP_SPIRAM);
+    
+    ESP_RETURN_ON_FALSE(buf1 && buf2, ESP_ERR_NO_MEM, TAG, "Failed to allocate LVGL buffers");
+    
+    ESP_RETURN_ON_ERROR(
+        waveshare_lcd_get_frame_buffer(s_lcd_panel, 1, &s_flush_dma.framebuffer, NULL),
+        TAG, "Failed to get panel framebuffer"
+    );
+    s_dim.framebuffer = s_flush_dma.framebuffer;
+    s_flush_dma.done = xSemaphoreCreateBinary();
+    ESP_RETURN_ON_FALSE(s_flush_dma.done != NULL, ESP_ERR_NO_MEM, TAG, "Failed to create flush semaphore");
+    
+    async_memcpy_config_t dma_config = ASYNC_MEMCPY_DEFAULT_CONFIG();
+    dma_config.backlog = FLUSH_DMA_BACKLOG;
+    dma_config.psram_trans_align = FLUSH_DMA_ALIGN;
+    ESP_RETURN_ON_ERROR(
+        esp_async_memcpy_install(&dma_config, &s_flush_dma.handle),
+        TAG, "Failed to install async memcpy"
+    );
+#else
     // Allocate draw buffers (in SPIRAM for better performance)
     size_t buffer_size = CONFIG_LCD_H_RES * CONFIG_LCD_RGB_BOUNCE_BUFFER_HEIGHT;
     lv_color_t *buf1 = heap_caps_malloc(buffer_size * sizeof(lv_color_t), MALLOC_CAP_SPIRAM);
     lv_color_t *buf2 = heap_caps_malloc(buffer_size * sizeof(lv_color_t), MALLOC_CAP_SPIRAM);
     
     ESP_RETURN_ON_FALSE(buf1 && buf2, ESP_ERR_NO_MEM, TAG, "Failed to allocate LVGL buffers");
+    
+    ESP_RETURN_ON_ERROR(
+        waveshare_lcd_get_frame_buffer(s_lcd_panel, 1, &s_dim.framebuffer, NULL),
+        TAG, "Failed to get panel framebuffer"
+    );
+#endif
+
+    // Vsync paces direct-mode presents and the screen dimming pass
+    s_vsync_sem = xSemaphoreCreateBinary();
+    ESP_RETURN_ON_FALSE(s_vsync_sem != NULL, ESP_ERR_NO_MEM, TAG, "Failed to create vsync semaphore");
+    ESP_RETURN_ON_ERROR(
+        waveshare_lcd_register_vsync_callback(s_lcd_panel, lvgl_vsync_cb, NULL),
+        TAG, "Failed to register vsync callback"
+    );
+    
+#if CONFIG_UI_DIM_SELF_CHECK
+    ui_dim_self_check();
+#endif
+#if CONFIG_UI_DRAW_SELF_CHECK
+    ui_draw_self_check();
+#endif
 
     // Initialize display buffer
     static lv_disp_draw_buf_t disp_buf;
@@ -160,9 +961,18 @@ esp_err_t ui_init(lv_disp_t **disp, lv_indev_t **touch_indev)
     disp_drv.flush_cb = lvgl_flush_cb;
     disp_drv.draw_buf = &disp_buf;
     disp_drv.user_data = s_lcd_panel;
+    disp_drv.draw_ctx_init = ui_draw_ctx_init;
+    disp_drv.draw_ctx_size = sizeof(lv_draw_sw_ctx_t);
+#if CONFIG_LVGL_DIRECT_MODE
+    disp_drv.direct_mode = 1;
+#elif CONFIG_LVGL_FLUSH_ASYNC_DMA
+    disp_drv.rounder_cb = lvgl_rounder_cb;
+    disp_drv.wait_cb = lvgl_flush_wait_cb;
+#endif
     
     s_disp = lv_disp_drv_register(&disp_drv);
     ESP_RETURN_ON_FALSE(s_disp != NULL, ESP_FAIL, TAG, "Failed to register display driver");
+    ui_perf_init(s_disp);
 
     // Register touch input driver
     static lv_indev_drv_t indev_drv;
@@ -174,6 +984,26 @@ esp_err_t ui_init(lv_disp_t **disp, lv_indev_t **touch_indev)
     s_touch_indev = lv_indev_drv_register(&indev_drv);
     ESP_RETURN_ON_FALSE(s_touch_indev != NULL, ESP_FAIL, TAG, "Failed to register touch driver");
 
+#if CONFIG_TOUCH_INTERRUPT
+    // Touch task pinned to CPU1 with LVGL; started before the INT handler
+    // is registered so the handler always has a task to notify
+    BaseType_t task_ret = xTaskCreatePinnedToCore(
+        touch_task,
+        "touch_task",
+        TOUCH_TASK_STACK_SIZE,
+        s_touch,
+        TOUCH_TASK_PRIORITY,
+        &s_touch_task,
+        1  // Pin to CPU1
+    );
+    ESP_RETURN_ON_FALSE(task_ret == pdPASS, ESP_FAIL, TAG, "Failed to create touch task");
+    ESP_RETURN_ON_ERROR(
+        esp_lcd_touch_register_interrupt_callback(s_touch, touch_isr_cb),
+        TAG, "Failed to register touch interrupt"
+    );
+#endif
+
+#if !CONFIG_LV_TICK_CUSTOM
     // Create tick timer
     const esp_timer_create_args_t lvgl_tick_timer_args = {
         .callback = lvgl_tick_timer_cb,
@@ -188,6 +1018,7 @@ esp_err_t ui_init(lv_disp_t **disp, lv_indev_t **touch_indev)
         esp_timer_start_periodic(lvgl_tick_timer, UI_LVGL_TICK_PERIOD_MS * 1000),
         TAG, "Failed to start LVGL tick timer"
     );
+#endif
 
     // Create LVGL task pinned to CPU1 (CPU0 handles LCD DMA ISRs)
     BaseType_t ret = xTaskCreatePinnedToCore(
@@ -196,10 +1027,11 @@ esp_err_t ui_init(lv_disp_t **disp, lv_indev_t **touch_indev)
         UI_LVGL_TASK_STACK_SIZE_KB * 1024,
         NULL,
         UI_LVGL_TASK_PRIORITY,
-        NULL,
+        &s_lvgl_task,
         1  // Pin to CPU1
     );
     ESP_RETURN_ON_FALSE(ret == pdPASS, ESP_FAIL, TAG, "Failed to create LVGL task");
+    atomic_store(&s_cmd_queue.ready, true);
 
     *disp = s_disp;
     *touch_indev = s_touch_indev;
@@ -208,6 +1040,24 @@ esp_err_t ui_init(lv_disp_t **disp, lv_indev_t **touch_indev)
     return ESP_OK;
 }
 
+void ui_start(void)
+{
+    s_started = true;
+    if (s_lvgl_task != NULL) {
+        xTaskNotifyGive(s_lvgl_task);
+    }
+}
+
+bool ui_is_started(void)
+{
+    return s_started;
+}
+
+int64_t ui_get_lvgl_busy_us(void)
+{
+    return s_lvgl_busy_us - s_lvgl_wait_us;
+}
+
 bool ui_lock(void)
 {
     if (s_lvgl_mutex == NULL) {
@@ -221,4 +1071,45 @@ void ui_unlock(void)
     if (s_lvgl_mutex != NULL) {
         xSemaphoreGive(s_lvgl_mutex);
     }
+#if CONFIG_LVGL_RENDER_ON_DEMAND
+    // The caller may have changed the UI; let LVGL look for work
+    if (s_lvgl_task != NULL) {
+        xTaskNotifyGive(s_lvgl_task);
+    }
+#endif
+}
+
+bool ui_post(ui_cmd_fn_t fn, void *arg)
+{
+    if (fn == NULL || !atomic_load(&s_cmd_queue.ready)) {
+        return false;
+    }
+    
+    // Claim a slot: CAS the enqueue position forward once its slot is free
+    ui_cmd_slot_t *slot;
+    unsigned pos = atomic_load_explicit(&s_cmd_queue.enqueue_pos, memory_order_relaxed);
+    while (1) {
+        slot = &s_cmd_queue.slots[pos & (UI_CMD_QUEUE_LEN - 1)];
+        unsigned seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        int diff = (int)(seq - pos);
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&s_cmd_queue.enqueue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // The LVGL task has not drained this slot from the previous pass
+            atomic_fetch_add_explicit(&s_cmd_queue.dropped, 1, memory_order_relaxed);
+            return false;
+        } else {
+            pos = atomic_load_explicit(&s_cmd_queue.enqueue_pos, memory_order_relaxed);
+        }
+    }
+    
+    slot->fn = fn;
+    slot->arg = arg;
+    atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+    
+    xTaskNotifyGive(s_lvgl_task);
+    return true;
 }
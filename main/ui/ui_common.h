@@ -56,10 +56,51 @@ void ui_show_splash(lv_disp_t *disp);
  */
 void ui_show_main(void);
 
+/**
+ * @brief Return the main screen to a saved tab and scene
+ * 
+ * Used after a warm restart; call after ui_show_main() and before
+ * ui_start(), so the first frame already shows them.
+ * 
+ * @param tab Tab index (0 = Scene Selector, 1 = Manual Control)
+ * @param scene_index Scene to select (clamped to the scenes loaded)
+ */
+void ui_restore_selection(uint8_t tab, int scene_index);
+
+/**
+ * @brief Start drawing
+ * 
+ * ui_init() starts the LVGL task without drawing, so the boot splash stays
+ * on screen while the main screen is built under ui_lock() and commands
+ * posted with ui_post() still run. Call once the main screen is ready; the
+ * first frame replaces the splash.
+ */
+void ui_start(void);
+
+/**
+ * @brief Check whether ui_start() has been called
+ * 
+ * @return true once the UI is drawing
+ */
+bool ui_is_started(void);
+
+/**
+ * @brief Get the CPU time the LVGL task has used since boot
+ * 
+ * Time spent in lv_timer_handler() on CPU1, excluding time blocked waiting
+ * for a DMA flush. Sample it twice to get utilisation over an interval.
+ * 
+ * @return Busy time in microseconds
+ */
+int64_t ui_get_lvgl_busy_us(void);
+
 /**
  * @brief Lock LVGL mutex (for non-UI task access)
  * 
- * @param timeout_ms Timeout in milliseconds (default: portMAX_DELAY)
+ * Waits for the LVGL task to finish a whole lv_timer_handler() pass. App
+ * tasks should use ui_post() instead; the lock is for boot-time screen
+ * construction and diagnostics.
+ * 
  * @return true if locked successfully
  */
 bool ui_lock(void);
@@ -69,6 +110,272 @@ bool ui_lock(void);
  */
 void ui_unlock(void);
 
+/**
+ * @brief UI command, run in LVGL context
+ */
+typedef void (*ui_cmd_fn_t)(void *arg);
+
+/**
+ * @brief Queue a UI update for the LVGL task without blocking
+ * 
+ * The command runs at the start of the LVGL task's next cycle, before
+ * lv_timer_handler(), in posting order. Safe to call from any task; the
+ * queue is lock-free so the caller never waits on rendering.
+ * 
+ * @param fn Command to run
+ * @param arg Passed to @p fn; must stay valid until it runs
+ * @return true if queued, false if the UI is not running or the queue is full
+ */
+bool ui_post(ui_cmd_fn_t fn, void *arg);
+
+/**
+ * @brief Pause or resume LVGL while the screen is off
+ * 
+ * While suspended the LVGL task runs ui_post() commands but not
+ * lv_timer_handler(), and sleeps until the next command or touch instead
+ * of the next LVGL timer. With CONFIG_LCD_OFF_PIXEL_CLOCK_HZ the panel
+ * scans out at that clock meanwhile. Timers that came due and areas
+ * invalidated by other tasks are handled on resume.
+ * 
+ * Call from LVGL context (see power_save.h).
+ */
+void ui_set_suspended(bool suspended);
+
+// ----- Screen Dimming -----
+
+/// Dimming level that leaves pixels unchanged (levels run 0-256)
+#define UI_DIM_LEVEL_MAX    256
+
+/**
+ * @brief Called in LVGL context when a dimming fade reaches its level
+ */
+typedef void (*ui_dim_done_cb_t)(void);
+
+/**
+ * @brief Fade the whole screen to a dimming level
+ * 
+ * Scales the framebuffer pixels instead of blending an overlay. The UI is
+ * rendered once into a snapshot, LVGL stops drawing, and every vsync the
+ * LVGL task writes the snapshot scaled by the current level into the
+ * framebuffer (the hidden one in direct mode, then presented). Levels
+ * step in 1/256ths at the panel frame rate.
+ * 
+ * Below UI_DIM_LEVEL_MAX the last frame is held and LVGL keeps running
+ * without drawing. Fading back to UI_DIM_LEVEL_MAX re-renders the snapshot
+ * first, so the fade-in shows the current UI, and resumes drawing at the
+ * end. A call during a fade continues from the level on screen and
+ * replaces the pending callback.
+ * 
+ * Call from LVGL context (a ui_post() command or an LVGL callback).
+ * 
+ * @param level Target level, 0 (black) to UI_DIM_LEVEL_MAX (unchanged)
+ * @param duration_ms Fade time (0 = next frame)
+ * @param done_cb Called when the level is reached (may be NULL)
+ * @return ESP_OK, ESP_ERR_INVALID_ARG for a bad level, or ESP_ERR_NO_MEM
+ *         if the snapshot cannot be allocated (the screen is unchanged)
+ */
+esp_err_t ui_dim_to(uint16_t level, uint32_t duration_ms, ui_dim_done_cb_t done_cb);
+
+/**
+ * @brief Time the last fade presented its first frame
+ * 
+ * @return esp_timer time in microseconds, 0 before the first fade
+ */
+int64_t ui_dim_get_first_frame_us(void);
+
+/**
+ * @brief Scale RGB565 pixels by level / 256
+ * 
+ * Pixels are in the framebuffer byte order (LV_COLOR_16_SWAP). Uses the
+ * ESP32-S3 PIE kernel for 16-byte aligned runs with CONFIG_UI_DIM_PIE,
+ * otherwise ui_dim_rgb565_ref(); both give identical results.
+ * 
+ * @param dst Output pixels (may equal @p src)
+ * @param src Input pixels
+ * @param count Number of pixels
+ * @param level 0 (black) to UI_DIM_LEVEL_MAX (unchanged)
+ */
+void ui_dim_rgb565(uint16_t *dst, const uint16_t *src, size_t count, uint16_t level);
+
+/**
+ * @brief Reference implementation of ui_dim_rgb565(), one pixel at a time
+ * 
+ * Each channel becomes (channel * level) >> 8.
+ */
+void ui_dim_rgb565_ref(uint16_t *dst, const uint16_t *src, size_t count, uint16_t level);
+
+/**
+ * @brief Check the PIE dimming kernel against the reference
+ * 
+ * Dims every RGB565 value at several levels with both. On a mismatch the
+ * PIE kernel is disabled and ui_dim_rgb565() uses the reference.
+ * 
+ * @return ESP_OK if they match (or PIE is not built), ESP_FAIL on a mismatch
+ */
+esp_err_t ui_dim_self_check(void);
+
+// ----- Draw Context -----
+
+/**
+ * @brief Pixels drawn through each path of the draw context
+ */
+typedef struct {
+    uint64_t fill_px;       ///< Unmasked solid fills done by ui_draw
+    uint64_t blend_px;      ///< Unmasked translucent fills done by ui_draw
+    uint64_t lvgl_px;       ///< Everything passed to LVGL's blender
+} ui_draw_stats_t;
+
+/**
+ * @brief Translucent fill parameters for ui_draw_blend_rgb565_pie()
+ * 
+ * One 16-bit word per broadcast load in ui_draw_pie.S; keep the order.
+ */
+typedef struct {
+    uint16_t opa_inv;       ///< 255 - opa
+    uint16_t opa_inv_x8;    ///< (255 - opa) * 8
+    uint16_t fg_r;          ///< Red * opa + LV_COLOR_MIX_ROUND_OFS
+    uint16_t fg_g;          ///< Green * opa + LV_COLOR_MIX_ROUND_OFS
+    uint16_t fg_b;          ///< Blue * opa + LV_COLOR_MIX_ROUND_OFS
+} ui_draw_blend_params_t;
+
+/**
+ * @brief LVGL draw context init (lv_disp_drv_t::draw_ctx_init)
+ * 
+ * LVGL's software draw context with the blend callback replaced: unmasked
+ * colour fills use the PIE kernels when CONFIG_UI_DRAW_PIE is enabled,
+ * everything else goes to lv_draw_sw_blend_basic(). Output is identical
+ * to LVGL's. Use with draw_ctx_size = sizeof(lv_draw_sw_ctx_t).
+ */
+void ui_draw_ctx_init(lv_disp_drv_t *drv, lv_draw_ctx_t *draw_ctx);
+
+/**
+ * @brief Turn the PIE fill kernels on or off at run time (LVGL context)
+ * 
+ * For comparing frame times. Has no effect if the kernels are not built
+ * or failed ui_draw_self_check().
+ */
+void ui_draw_set_pie_enabled(bool enabled);
+
+/**
+ * @brief Whether unmasked fills currently use the PIE kernels
+ */
+bool ui_draw_pie_enabled(void);
+
+/**
+ * @brief Copy the draw path counters (LVGL mutex held)
+ */
+void ui_draw_get_stats(ui_draw_stats_t *stats);
+
+/**
+ * @brief Clear the draw path counters (LVGL mutex held)
+ */
+void ui_draw_reset_stats(void);
+
+/**
+ * @brief Fill 8-pixel vectors with a colour (ui_draw_pie.S)
+ * 
+ * @param dst Output, 16-byte aligned
+ * @param vectors Number of 8-pixel vectors
+ * @param color Pixel value in framebuffer byte order
+ */
+void ui_draw_fill_rgb565_pie(uint16_t *dst, size_t vectors, uint32_t color);
+
+/**
+ * @brief Blend a colour over 8-pixel vectors in place (ui_draw_pie.S)
+ * 
+ * Each channel becomes LV_UDIV255(fg + bg * opa_inv), the sum
+ * lv_color_mix_premult() does.
+ * 
+ * @param dst Pixels, 16-byte aligned
+ * @param vectors Number of 8-pixel vectors
+ * @param params Blend parameters
+ */
+void ui_draw_blend_rgb565_pie(uint16_t *dst, size_t vectors, const ui_draw_blend_params_t *params);
+
+/**
+ * @brief Check the PIE fill kernels against LVGL's colour functions
+ * 
+ * Blends over every RGB565 value at several colours and opacities. On a
+ * mismatch the kernels are disabled and all fills go to LVGL.
+ * 
+ * @return ESP_OK if they match (or PIE is not built), ESP_FAIL on a mismatch
+ */
+esp_err_t ui_draw_self_check(void);
+
+// ----- Render Benchmark -----
+
+/**
+ * @brief Run the render benchmark and log the results
+ * 
+ * Plays a scripted scene (carousel scroll, slider drag, modal open/close)
+ * with the application's draw buffers and then with partial buffers of
+ * several heights in PSRAM and internal DMA-capable RAM, logging FPS,
+ * frame-time percentiles and buffer memory for each. Takes over the
+ * display for about a minute and restores the UI afterwards.
+ * 
+ * Call from a task other than the LVGL task, after ui_init().
+ * 
+ * @return esp_err_t ESP_OK on success
+ */
+esp_err_t ui_benchmark_run(void);
+
+// ----- Performance Instrumentation -----
+
+/**
+ * @brief Start recording render pipeline timings for a display
+ * 
+ * Wraps the display's refresh timer to time each frame and installs a
+ * monitor callback for the invalidated area.
+ */
+void ui_perf_init(lv_disp_t *disp);
+
+/**
+ * @brief Record one LVGL task loop (call from the LVGL task with the mutex held)
+ * 
+ * @param mutex_wait_us Time spent waiting for the LVGL mutex
+ * @param handler_us Time spent in lv_timer_handler()
+ */
+void ui_perf_record_loop(uint32_t mutex_wait_us, uint32_t handler_us);
+
+/**
+ * @brief Add flush time to the frame being rendered (call from flush callbacks)
+ */
+void ui_perf_record_flush(uint32_t flush_us);
+
+/**
+ * @brief Log the time from @p start_us to the end of the next rendered frame
+ * 
+ * Used for modal open latency and boot time to first interactive frame:
+ * call after showing the element, with the time its open began (0 for
+ * boot).
+ * 
+ * @param name Static string identifying what was opened
+ * @param start_us esp_timer_get_time() when the open began
+ */
+void ui_perf_mark_open(const char *name, int64_t start_us);
+
+/**
+ * @brief Show or hide the on-screen perf overlay (LVGL context)
+ */
+void ui_perf_set_overlay_visible(bool visible);
+
+/**
+ * @brief Toggle the perf overlay when @p obj is held for 3 seconds
+ */
+void ui_perf_attach_toggle_gesture(lv_obj_t *obj);
+
+/**
+ * @brief Print rolling histograms and percentiles to the console
+ * 
+ * Takes the LVGL lock; call from a task other than the LVGL task.
+ */
+void ui_perf_dump(void);
+
+/**
+ * @brief Clear all rolling windows and counters
+ */
+void ui_perf_reset(void);
+
 // ----- Main Screen Functions -----
 
 /**
@@ -105,13 +412,15 @@ void ui_manual_get_values(uint8_t *brightness, uint8_t *red, uint8_t *green,
 void ui_manual_set_values(uint8_t brightness, uint8_t red, uint8_t green, 
                           uint8_t blue, uint8_t white);
 
+// ----- Preview Colour -----
+
 /**
- * @brief Calculate display RGB from RGBW + brightness (additive light mixing)
+ * @brief Calculate display RGB from RGBW + brightness
  * 
- * For RGBW LEDs:
- * - RGB channels mix additively (R+G=Yellow, R+B=Magenta, G+B=Cyan)
- * - White LED adds equally to all RGB channels
- * - Brightness is a master dimmer applied to all
+ * Table-driven (see ui_preview.c). By default the white LED blends each
+ * channel towards white and brightness follows a square-root curve; with
+ * CONFIG_PREVIEW_COLOR_CALIBRATED the channels are mixed through the
+ * measured LED colour matrix instead.
  * 
  * @param brightness Master brightness (0-255)
  * @param r Red channel (0-255)
@@ -122,6 +431,15 @@ void ui_manual_set_values(uint8_t brightness, uint8_t red, uint8_t green,
  */
 lv_color_t ui_calculate_preview_color(uint8_t brightness, uint8_t r, uint8_t g, uint8_t b, uint8_t w);
 
+/**
+ * @brief Calculate preview colours for several scenes at once
+ * 
+ * @param scenes Scenes to colour
+ * @param colors Output, one colour per scene
+ * @param count Number of scenes
+ */
+void ui_calculate_preview_colors(const ui_scene_t *scenes, lv_color_t *colors, size_t count);
+
 // ----- Scene Selector Tab Functions -----
 
 /**
@@ -130,12 +448,15 @@ lv_color_t ui_calculate_preview_color(uint8_t brightness, uint8_t r, uint8_t g,
 void ui_create_scenes_tab(lv_obj_t *parent);
 
 /**
- * @brief Load scenes from SD card and populate the list (FR-040)
+ * @brief Build one more piece of the scene selector tab
  * 
- * @param scenes Array of scene structs
- * @param count Number of scenes
+ * The tab is created with only the carousel cards under the viewport;
+ * each call adds one of the remaining pooled cards. Call from LVGL
+ * context while the UI is idle.
+ * 
+ * @return true if a card was built, false when the pool is complete
  */
-void ui_scenes_load_from_sd(const ui_scene_t *scenes, size_t count);
+bool ui_scenes_build_step(void);
 
 /**
  * @brief Update transition progress bar (FR-043)
@@ -147,8 +468,8 @@ void ui_scenes_update_progress(uint8_t percent);
 /**
  * @brief Start the progress bar tracking for a fade in progress
  * 
- * Shows the progress bar and starts a timer to update it
- * based on the fade controller's progress.
+ * Shows the progress bar, which then follows the fade controller's
+ * progress. Safe to call from any task (posted with ui_post()).
  */
 void ui_scenes_start_progress_tracking(void);
 
@@ -157,6 +478,13 @@ void ui_scenes_start_progress_tracking(void);
  */
 int ui_scenes_get_selected_index(void);
 
+/**
+ * @brief Select a scene and centre its card without animation
+ * 
+ * @param index Scene index (clamped to the scenes loaded)
+ */
+void ui_scenes_select(int index);
+
 /**
  * @brief Get current transition duration
  */
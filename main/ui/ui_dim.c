@@ -0,0 +1,139 @@
+/**
+ * @file ui_dim.c
+ * @brief RGB565 dimming kernels for the screen fade
+ * 
+ * Scales each channel of an RGB565 image by level / 256 for ui_dim_to().
+ * Pixels are in the framebuffer byte order, so with LV_COLOR_16_SWAP green
+ * is split across both bytes of a little-endian word:
+ * 
+ *   unswapped: RRRRRGGG GGGBBBBB    swapped: GGGBBBBB RRRRRGGG
+ * 
+ * ui_dim_rgb565_ref() works one pixel at a time in plain C. With
+ * CONFIG_UI_DIM_PIE, 16-byte aligned runs go through ui_dim_pie.S, which
+ * does the same sums on 8 pixels per 128-bit vector: mask a field, shift
+ * it into place, multiply by the level with a >> 8, mask and merge.
+ * tools/ui_host/dim_check.c replays those lane operations on the host
+ * against the reference for every pixel and level.
+ */
+
+#include "ui_common.h"
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include <stdbool.h>
+
+#if CONFIG_UI_DIM_PIE
+static const char *TAG = "ui_dim";
+
+/// Pixels per PIE vector
+#define DIM_PIE_LANES       8
+#define DIM_PIE_ALIGN       16
+
+/**
+ * @brief PIE kernel (ui_dim_pie.S)
+ * 
+ * @param dst Output, 16-byte aligned
+ * @param src Input, 16-byte aligned
+ * @param vectors Number of 8-pixel vectors
+ * @param level 0-256
+ */
+extern void ui_dim_rgb565_pie(uint16_t *dst, const uint16_t *src, size_t vectors, uint32_t level);
+
+/// Cleared by ui_dim_self_check() if the kernel disagrees with the reference
+static bool s_pie_enabled = true;
+#endif
+
+/**
+ * @brief Scale one pixel, in framebuffer byte order
+ */
+static inline uint16_t dim_pixel(uint16_t px, uint32_t level)
+{
+#if LV_COLOR_16_SWAP
+    px = (uint16_t)((px << 8) | (px >> 8));
+#endif
+    uint32_t r = (((px >> 11) & 0x1F) * level) >> 8;
+    uint32_t g = (((px >> 5) & 0x3F) * level) >> 8;
+    uint32_t b = ((px & 0x1F) * level) >> 8;
+    uint16_t out = (uint16_t)((r << 11) | (g << 5) | b);
+#if LV_COLOR_16_SWAP
+    out = (uint16_t)((out << 8) | (out >> 8));
+#endif
+    return out;
+}
+
+void ui_dim_rgb565_ref(uint16_t *dst, const uint16_t *src, size_t count, uint16_t level)
+{
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = dim_pixel(src[i], level);
+    }
+}
+
+void ui_dim_rgb565(uint16_t *dst, const uint16_t *src, size_t count, uint16_t level)
+{
+    if (level > UI_DIM_LEVEL_MAX) {
+        level = UI_DIM_LEVEL_MAX;
+    }
+
+#if CONFIG_UI_DIM_PIE
+    if (s_pie_enabled &&
+        ((uintptr_t)dst % DIM_PIE_ALIGN) == 0 && ((uintptr_t)src % DIM_PIE_ALIGN) == 0) {
+        size_t vectors = count / DIM_PIE_LANES;
+        ui_dim_rgb565_pie(dst, src, vectors, level);
+        dst += vectors * DIM_PIE_LANES;
+        src += vectors * DIM_PIE_LANES;
+        count -= vectors * DIM_PIE_LANES;
+    }
+#endif
+
+    ui_dim_rgb565_ref(dst, src, count, level);
+}
+
+esp_err_t ui_dim_self_check(void)
+{
+#if CONFIG_UI_DIM_PIE
+    static const uint16_t levels[] = { 0, 1, 37, 128, 200, 255, UI_DIM_LEVEL_MAX };
+    const size_t count = 65536;
+    
+    uint16_t *src = heap_caps_aligned_alloc(DIM_PIE_ALIGN, count * sizeof(uint16_t), MALLOC_CAP_SPIRAM);
+    uint16_t *ref = heap_caps_aligned_alloc(DIM_PIE_ALIGN, count * sizeof(uint16_t), MALLOC_CAP_SPIRAM);
+    uint16_t *out = heap_caps_aligned_alloc(DIM_PIE_ALIGN, count * sizeof(uint16_t), MALLOC_CAP_SPIRAM);
+    if (!src || !ref || !out) {
+        heap_caps_free(src);
+        heap_caps_free(ref);
+        heap_caps_free(out);
+        ESP_LOGW(TAG, "Self-check skipped: out of memory");
+        return ESP_OK;
+    }
+    
+    for (size_t i = 0; i < count; i++) {
+        src[i] = (uint16_t)i;
+    }
+    
+    esp_err_t result = ESP_OK;
+    for (size_t l = 0; l < sizeof(levels) / sizeof(levels[0]) && result == ESP_OK; l++) {
+        ui_dim_rgb565_ref(ref, src, count, levels[l]);
+        ui_dim_rgb565_pie(out, src, count / DIM_PIE_LANES, levels[l]);
+        for (size_t i = 0; i < count; i++) {
+            if (out[i] != ref[i]) {
+                ESP_LOGE(TAG, "PIE kernel mismatch at level %u: 0x%04x -> 0x%04x, expected 0x%04x",
+                         levels[l], (unsigned)i, out[i], ref[i]);
+                result = ESP_FAIL;
+                break;
+            }
+        }
+    }
+    
+    heap_caps_free(src);
+    heap_caps_free(ref);
+    heap_caps_free(out);
+    
+    if (result != ESP_OK) {
+        s_pie_enabled = false;
+        ESP_LOGE(TAG, "PIE dimming disabled, using the reference kernel");
+    } else {
+        ESP_LOGI(TAG, "PIE dimming kernel matches the reference");
+    }
+    return result;
+#else
+    return ESP_OK;
+#endif
+}
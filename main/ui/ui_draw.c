@@ -0,0 +1,298 @@
+/**
+ * @file ui_draw.c
+ * @brief LVGL draw context with vector fill kernels
+ * 
+ * Wraps LVGL's software draw context and replaces its blend callback. Most
+ * of the UI is large rectangles: screen and card backgrounds, buttons,
+ * slider tracks and the translucent modal backdrop. With CONFIG_UI_DRAW_PIE
+ * their unmasked fills go through the ESP32-S3 PIE kernels in
+ * ui_draw_pie.S, 8 pixels per vector. Masked fills (anti-aliased edges and
+ * rounded corners, which are short runs), images, text and other blend
+ * modes go to lv_draw_sw_blend_basic() unchanged.
+ * 
+ * The kernels reproduce LVGL's arithmetic exactly. A solid fill is
+ * lv_color_fill(), a translucent fill is lv_color_mix_premult() per pixel,
+ * and the black pixels that lead an area get lv_color_mix() as in LVGL's
+ * fill_normal(). ui_draw_self_check() compares the kernels with LVGL on
+ * the device, and tools/ui_host/draw_check.c renders a test screen through
+ * both draw contexts on the host with a lane-level model of the kernels.
+ */
+
+#include "ui_common.h"
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include <stdbool.h>
+#include <string.h>
+
+#if CONFIG_UI_DRAW_PIE
+static const char *TAG = "ui_draw";
+
+/// Pixels per PIE vector
+#define DRAW_PIE_LANES      8
+#define DRAW_PIE_ALIGN      16
+
+/// Shorter runs stay in C: the alignment head and call cost outweigh the kernel
+#define DRAW_PIE_MIN_RUN    32
+
+/**
+ * @brief Translucent fill of one colour, as LVGL's fill_normal() sets it up
+ */
+typedef struct {
+    uint16_t premult[3];            ///< lv_color_premult() of the colour
+    lv_opa_t opa_inv;
+    ui_draw_blend_params_t params;  ///< The same for the kernel
+} draw_blend_t;
+
+/// Cleared by ui_draw_self_check() if the kernels disagree with LVGL
+static bool s_pie_available = true;
+static bool s_pie_enabled = true;
+#endif
+
+static ui_draw_stats_t s_stats;
+
+#if CONFIG_UI_DRAW_PIE
+/**
+ * @brief Pixels before @p dst reaches a 16-byte boundary
+ */
+static inline lv_coord_t align_head(const lv_color_t *dst)
+{
+    return (lv_coord_t)(((DRAW_PIE_ALIGN - ((uintptr_t)dst % DRAW_PIE_ALIGN)) % DRAW_PIE_ALIGN) /
+                        sizeof(lv_color_t));
+}
+
+/**
+ * @brief Solid fill of one row
+ */
+static void fill_run(lv_color_t *dst, lv_coord_t len, lv_color_t color)
+{
+    if (len >= DRAW_PIE_MIN_RUN) {
+        lv_coord_t head = align_head(dst);
+        lv_color_fill(dst, color, head);
+        dst += head;
+        len -= head;
+        
+        size_t vectors = (size_t)len / DRAW_PIE_LANES;
+        ui_draw_fill_rgb565_pie((uint16_t *)dst, vectors, color.full);
+        dst += vectors * DRAW_PIE_LANES;
+        len -= (lv_coord_t)(vectors * DRAW_PIE_LANES);
+    }
+    
+    lv_color_fill(dst, color, len);
+}
+
+static void blend_init(draw_blend_t *b, lv_color_t color, lv_opa_t opa)
+{
+    lv_color_premult(color, opa, b->premult);
+    b->opa_inv = 255 - opa;
+    b->params.opa_inv = b->opa_inv;
+    b->params.opa_inv_x8 = b->opa_inv * 8;
+    b->params.fg_r = b->premult[0] + LV_COLOR_MIX_ROUND_OFS;
+    b->params.fg_g = b->premult[1] + LV_COLOR_MIX_ROUND_OFS;
+    b->params.fg_b = b->premult[2] + LV_COLOR_MIX_ROUND_OFS;
+}
+
+static void blend_scalar(lv_color_t *dst, lv_coord_t len, const draw_blend_t *b)
+{
+    for (lv_coord_t i = 0; i < len; i++) {
+        dst[i] = lv_color_mix_premult((uint16_t *)b->premult, dst[i], b->opa_inv);
+    }
+}
+
+/**
+ * @brief Translucent fill of one row
+ */
+static void blend_run(lv_color_t *dst, lv_coord_t len, const draw_blend_t *b)
+{
+    if (len >= DRAW_PIE_MIN_RUN) {
+        lv_coord_t head = align_head(dst);
+        blend_scalar(dst, head, b);
+        dst += head;
+        len -= head;
+        
+        size_t vectors = (size_t)len / DRAW_PIE_LANES;
+        ui_draw_blend_rgb565_pie((uint16_t *)dst, vectors, &b->params);
+        dst += vectors * DRAW_PIE_LANES;
+        len -= (lv_coord_t)(vectors * DRAW_PIE_LANES);
+    }
+    
+    blend_scalar(dst, len, b);
+}
+
+/**
+ * @brief Draw an unmasked colour fill with the kernels
+ * 
+ * @return false if LVGL has to draw it
+ */
+static bool draw_fill(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc)
+{
+    if (dsc->src_buf != NULL || dsc->blend_mode != LV_BLEND_MODE_NORMAL) {
+        return false;
+    }
+    if (dsc->mask_buf != NULL && dsc->mask_res != LV_DRAW_MASK_RES_FULL_COVER) {
+        return false;
+    }
+    lv_disp_t *disp = _lv_refr_get_disp_refreshing();
+    if (disp->driver->set_px_cb != NULL || disp->driver->screen_transp) {
+        return false;
+    }
+    
+    lv_area_t area;
+    if (!_lv_area_intersect(&area, dsc->blend_area, draw_ctx->clip_area)) {
+        return true;
+    }
+    
+    lv_coord_t stride = lv_area_get_width(draw_ctx->buf_area);
+    lv_coord_t w = lv_area_get_width(&area);
+    lv_coord_t h = lv_area_get_height(&area);
+    lv_color_t *dest = (lv_color_t *)draw_ctx->buf +
+                       (int32_t)stride * (area.y1 - draw_ctx->buf_area->y1) +
+                       (area.x1 - draw_ctx->buf_area->x1);
+    
+    if (dsc->opa >= LV_OPA_MAX) {
+        for (lv_coord_t y = 0; y < h; y++) {
+            fill_run(dest, w, dsc->color);
+            dest += stride;
+        }
+        s_stats.fill_px += (uint32_t)w * h;
+        return true;
+    }
+    
+    draw_blend_t b;
+    blend_init(&b, dsc->color, dsc->opa);
+    
+    // fill_normal() mixes with lv_color_mix() until it meets a non-black pixel
+    lv_color_t black = lv_color_black();
+    lv_color_t lead = lv_color_mix(dsc->color, black, dsc->opa);
+    bool leading = true;
+    
+    for (lv_coord_t y = 0; y < h; y++) {
+        lv_coord_t x = 0;
+        if (leading) {
+            while (x < w && dest[x].full == black.full) {
+                dest[x++] = lead;
+            }
+            leading = (x == w);
+        }
+        blend_run(dest + x, w - x, &b);
+        dest += stride;
+    }
+    s_stats.blend_px += (uint32_t)w * h;
+    return true;
+}
+#endif
+
+/**
+ * @brief Blend callback (lv_draw_sw_ctx_t::blend)
+ */
+static void ui_draw_blend(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc)
+{
+#if CONFIG_UI_DRAW_PIE
+    if (s_pie_enabled && draw_fill(draw_ctx, dsc)) {
+        return;
+    }
+#endif
+
+    lv_area_t area;
+    if (_lv_area_intersect(&area, dsc->blend_area, draw_ctx->clip_area)) {
+        s_stats.lvgl_px += lv_area_get_size(&area);
+    }
+    lv_draw_sw_blend_basic(draw_ctx, dsc);
+}
+
+void ui_draw_ctx_init(lv_disp_drv_t *drv, lv_draw_ctx_t *draw_ctx)
+{
+    lv_draw_sw_init_ctx(drv, draw_ctx);
+    ((lv_draw_sw_ctx_t *)draw_ctx)->blend = ui_draw_blend;
+}
+
+void ui_draw_set_pie_enabled(bool enabled)
+{
+#if CONFIG_UI_DRAW_PIE
+    s_pie_enabled = enabled && s_pie_available;
+#endif
+}
+
+bool ui_draw_pie_enabled(void)
+{
+#if CONFIG_UI_DRAW_PIE
+    return s_pie_enabled;
+#else
+    return false;
+#endif
+}
+
+void ui_draw_get_stats(ui_draw_stats_t *stats)
+{
+    *stats = s_stats;
+}
+
+void ui_draw_reset_stats(void)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+esp_err_t ui_draw_self_check(void)
+{
+#if CONFIG_UI_DRAW_PIE
+    static const lv_opa_t opas[] = { 1, 2, 64, 127, 128, 200, 253, 254, 255 };
+    const lv_color_t colors[] = {
+        lv_color_white(), lv_color_black(), lv_color_make(0x2a, 0xc0, 0x7f), lv_color_make(0xff, 0x55, 0x00),
+    };
+    const size_t count = 65536;
+    
+    lv_color_t *src = heap_caps_aligned_alloc(DRAW_PIE_ALIGN, count * sizeof(lv_color_t), MALLOC_CAP_SPIRAM);
+    lv_color_t *out = heap_caps_aligned_alloc(DRAW_PIE_ALIGN, count * sizeof(lv_color_t), MALLOC_CAP_SPIRAM);
+    if (!src || !out) {
+        heap_caps_free(src);
+        heap_caps_free(out);
+        ESP_LOGW(TAG, "Self-check skipped: out of memory");
+        return ESP_OK;
+    }
+    
+    for (size_t i = 0; i < count; i++) {
+        src[i].full = (uint16_t)i;
+    }
+    
+    esp_err_t result = ESP_OK;
+    for (size_t c = 0; c < sizeof(colors) / sizeof(colors[0]) && result == ESP_OK; c++) {
+        ui_draw_fill_rgb565_pie((uint16_t *)out, count / DRAW_PIE_LANES, colors[c].full);
+        for (size_t i = 0; i < count; i++) {
+            if (out[i].full != colors[c].full) {
+                ESP_LOGE(TAG, "PIE fill mismatch: 0x%04x, expected 0x%04x", out[i].full, colors[c].full);
+                result = ESP_FAIL;
+                break;
+            }
+        }
+        
+        for (size_t o = 0; o < sizeof(opas) / sizeof(opas[0]) && result == ESP_OK; o++) {
+            draw_blend_t b;
+            blend_init(&b, colors[c], opas[o]);
+            memcpy(out, src, count * sizeof(lv_color_t));
+            ui_draw_blend_rgb565_pie((uint16_t *)out, count / DRAW_PIE_LANES, &b.params);
+            for (size_t i = 0; i < count; i++) {
+                lv_color_t want = lv_color_mix_premult(b.premult, src[i], b.opa_inv);
+                if (out[i].full != want.full) {
+                    ESP_LOGE(TAG, "PIE blend mismatch: 0x%04x under 0x%04x at opa %u -> 0x%04x, expected 0x%04x",
+                             src[i].full, colors[c].full, opas[o], out[i].full, want.full);
+                    result = ESP_FAIL;
+                    break;
+                }
+            }
+        }
+    }
+    
+    heap_caps_free(src);
+    heap_caps_free(out);
+    
+    if (result != ESP_OK) {
+        s_pie_available = false;
+        s_pie_enabled = false;
+        ESP_LOGE(TAG, "PIE fills disabled, LVGL draws everything");
+    } else {
+        ESP_LOGI(TAG, "PIE fill kernels match LVGL");
+    }
+    return result;
+#else
+    return ESP_OK;
+#endif
+}
@@ -6,15 +6,77 @@
  */
 
 #include "ui_common.h"
+#include "../app/warm_restart.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include <string.h>
 
 static const char *TAG = "ui_main";
 
+/// Period of the staged build timer; each run builds one piece
+#define BUILD_SLICE_MS      20
+/// Build steps wait until the screen has not been touched for this long
+#define BUILD_IDLE_MS       200
+
 // UI Objects
 static lv_obj_t *s_tabview = NULL;
 static lv_obj_t *s_tab_manual = NULL;
 static lv_obj_t *s_tab_scenes = NULL;
+static bool s_manual_built = false;
+static lv_timer_t *s_build_timer = NULL;
+
+/**
+ * @brief Build the Manual Control tab content if it has not been built yet
+ */
+static void ensure_manual_tab(void)
+{
+    if (s_manual_built) {
+        return;
+    }
+    s_manual_built = true;
+    
+    int64_t start = esp_timer_get_time();
+    ui_create_manual_tab(s_tab_manual);
+    ESP_LOGI(TAG, "Manual Control tab built in %lld ms", (esp_timer_get_time() - start) / 1000);
+}
+
+/**
+ * @brief Staged build timer - builds the rest of the main screen one piece
+ *        per run while the UI is idle
+ * 
+ * Order: remaining carousel cards, then the Manual Control tab.
+ */
+static void build_timer_cb(lv_timer_t *timer)
+{
+    if (lv_disp_get_inactive_time(NULL) < BUILD_IDLE_MS) {
+        return;
+    }
+    
+    if (ui_scenes_build_step()) {
+        return;
+    }
+    if (!s_manual_built) {
+        ensure_manual_tab();
+        return;
+    }
+    
+    lv_timer_del(timer);
+    s_build_timer = NULL;
+    ESP_LOGI(TAG, "Main screen fully built %lld ms after boot", esp_timer_get_time() / 1000);
+}
+
+/**
+ * @brief Tab change handler - build a tab before it is shown if the staged
+ *        build has not reached it yet
+ */
+static void tabview_changed_cb(lv_event_t *e)
+{
+    uint16_t tab = lv_tabview_get_tab_act(s_tabview);
+    if (tab == 1) {  // Manual Control (second tab)
+        ensure_manual_tab();
+    }
+    warm_restart_save_tab((uint8_t)tab);
+}
 
 /**
  * @brief Create the main screen with tabview
@@ -54,6 +116,9 @@ void ui_create_main_screen(void)
     lv_obj_set_style_bg_opa(tab_btns, LV_OPA_COVER, LV_PART_ITEMS | LV_STATE_CHECKED);
     lv_obj_set_style_text_color(tab_btns, lv_color_make(255, 255, 255), LV_PART_ITEMS | LV_STATE_CHECKED);  // Bright white
 
+    // Hidden gesture: hold the tab bar for 3 s to toggle the perf overlay
+    ui_perf_attach_toggle_gesture(tab_btns);
+
     // Add tabs - Scene Selector first (FR-010)
     s_tab_scenes = lv_tabview_add_tab(s_tabview, "Scene Selector");
     s_tab_manual = lv_tabview_add_tab(s_tabview, "Manual Control");
@@ -62,9 +127,17 @@ void ui_create_main_screen(void)
     lv_obj_set_style_bg_color(s_tab_scenes, lv_color_make(245, 245, 245), LV_PART_MAIN);  // #F5F5F5
     lv_obj_set_style_bg_color(s_tab_manual, lv_color_make(245, 245, 245), LV_PART_MAIN);
 
-    // Create content for each tab
+    // Build the first-visible tab now; the rest follows in idle slices
+    // of the LVGL loop, or on demand when its tab is opened
     ui_create_scenes_tab(s_tab_scenes);
-    ui_create_manual_tab(s_tab_manual);
+    s_manual_built = false;
+    lv_obj_add_event_cb(s_tabview, tabview_changed_cb, LV_EVENT_VALUE_CHANGED, NULL);
+    if (s_build_timer == NULL) {
+        s_build_timer = lv_timer_create(build_timer_cb, BUILD_SLICE_MS, NULL);
+    }
+    
+    // Time to first interactive frame, measured from boot
+    ui_perf_mark_open("Main screen (from boot)", 0);
 
     ESP_LOGI(TAG, "Main screen created");
 
@@ -95,3 +168,21 @@ void ui_show_main(void)
     ESP_LOGI(TAG, "Showing main screen");
     ui_create_main_screen();
 }
+
+/**
+ * @brief Return the main screen to a saved tab and scene
+ */
+void ui_restore_selection(uint8_t tab, int scene_index)
+{
+    ui_lock();
+    
+    ui_scenes_select(scene_index);
+    if (tab == 1) {  // Manual Control (second tab)
+        ensure_manual_tab();
+        lv_tabview_set_act(s_tabview, tab, LV_ANIM_OFF);
+    }
+    warm_restart_save_tab(tab == 1 ? 1 : 0);
+    ESP_LOGI(TAG, "Restored tab %u, scene %d", tab, ui_scenes_get_selected_index());
+    
+    ui_unlock();
+}
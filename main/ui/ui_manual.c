@@ -4,7 +4,7 @@
  * 
  * Implements FR-020 to FR-023:
  * - FR-020: Provide sliders for Brightness, R, G, B, W
- * - FR-021: No CAN traffic until Update is pressed
+ * - FR-021: No CAN traffic until Update is pressed (unless Live is switched on)
  * - FR-022: Update transmits all parameters respecting rate limits
  * - FR-023: Save Scene opens modal dialog with Save and Cancel
  */
@@ -13,6 +13,7 @@
 #include "../app/scene_storage.h"
 #include "../app/fade_controller.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include <stdio.h>
 
 static const char *TAG = "ui_manual";
@@ -48,25 +49,42 @@ static lv_obj_t *s_label_white = NULL;
 static lv_obj_t *s_btn_update = NULL;
 static lv_obj_t *s_btn_save_scene = NULL;
 static lv_obj_t *s_color_preview = NULL;
+static lv_obj_t *s_live_switch = NULL;
 
 // Save Scene modal objects
 static lv_obj_t *s_save_modal = NULL;
 static lv_obj_t *s_save_textarea = NULL;
 static lv_obj_t *s_save_keyboard = NULL;
+static lv_obj_t *s_save_values_label = NULL;
 
 /**
  * @brief Close the save scene modal
+ * 
+ * The modal is hidden, not deleted, and reused on the next open.
  */
 static void close_save_modal(void)
 {
     if (s_save_modal) {
-        lv_obj_del(s_save_modal);
-        s_save_modal = NULL;
-        s_save_textarea = NULL;
-        s_save_keyboard = NULL;
+        lv_obj_add_flag(s_save_keyboard, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_clear_state(s_save_textarea, LV_STATE_FOCUSED);
+        // Forget the textarea as the last pressed object so the next tap
+        // focuses it again and shows the keyboard
+        lv_indev_reset(NULL, s_save_textarea);
+        lv_obj_add_flag(s_save_modal, LV_OBJ_FLAG_HIDDEN);
     }
 }
 
+/**
+ * @brief Save modal delete handler - forget the prebuilt modal if the screen is cleaned
+ */
+static void save_modal_delete_cb(lv_event_t *e)
+{
+    s_save_modal = NULL;
+    s_save_textarea = NULL;
+    s_save_keyboard = NULL;
+    s_save_values_label = NULL;
+}
+
 /**
  * @brief Save button callback in modal
  */
@@ -85,8 +103,7 @@ static void modal_save_btn_cb(lv_event_t *e)
                                            s_manual_state.blue, s_manual_state.white);
         if (ret == ESP_OK) {
             ESP_LOGI(TAG, "Scene saved successfully");
-            // Refresh the Scene Selector UI - already in LVGL context, use no-lock version
-            scene_storage_reload_ui_no_lock();
+            // Scene Selector cards update via the scene store observer
         } else {
             ESP_LOGE(TAG, "Failed to save scene: %s", esp_err_to_name(ret));
         }
@@ -130,9 +147,9 @@ static void textarea_event_cb(lv_event_t *e)
 }
 
 /**
- * @brief Create and show the Save Scene modal dialog (FR-023)
+ * @brief Build the Save Scene modal dialog, hidden (once, on first open)
  */
-static void show_save_scene_modal(void)
+static void create_save_scene_modal(void)
 {
     // Create modal background (semi-transparent overlay)
     s_save_modal = lv_obj_create(lv_scr_act());
@@ -142,6 +159,7 @@ static void show_save_scene_modal(void)
     lv_obj_set_style_bg_opa(s_save_modal, LV_OPA_50, LV_PART_MAIN);
     lv_obj_set_style_border_width(s_save_modal, 0, LV_PART_MAIN);
     lv_obj_set_style_radius(s_save_modal, 0, LV_PART_MAIN);
+    lv_obj_add_event_cb(s_save_modal, save_modal_delete_cb, LV_EVENT_DELETE, NULL);
     
     // Create dialog box
     lv_obj_t *dialog = lv_obj_create(s_save_modal);
@@ -179,16 +197,11 @@ static void show_save_scene_modal(void)
     lv_obj_set_style_radius(s_save_textarea, 8, LV_PART_MAIN);
     lv_obj_add_event_cb(s_save_textarea, textarea_event_cb, LV_EVENT_ALL, NULL);
     
-    // Current values display
-    char values_buf[64];
-    snprintf(values_buf, sizeof(values_buf), "B:%d  R:%d  G:%d  B:%d  W:%d",
-             s_manual_state.brightness, s_manual_state.red, s_manual_state.green,
-             s_manual_state.blue, s_manual_state.white);
-    lv_obj_t *values_label = lv_label_create(dialog);
-    lv_label_set_text(values_label, values_buf);
-    lv_obj_set_style_text_font(values_label, &lv_font_montserrat_18, LV_PART_MAIN);
-    lv_obj_set_style_text_color(values_label, lv_color_make(117, 117, 117), LV_PART_MAIN);
-    lv_obj_align(values_label, LV_ALIGN_TOP_LEFT, 0, 140);
+    // Current values display (text set on open)
+    s_save_values_label = lv_label_create(dialog);
+    lv_obj_set_style_text_font(s_save_values_label, &lv_font_montserrat_18, LV_PART_MAIN);
+    lv_obj_set_style_text_color(s_save_values_label, lv_color_make(117, 117, 117), LV_PART_MAIN);
+    lv_obj_align(s_save_values_label, LV_ALIGN_TOP_LEFT, 0, 140);
     
     // Button container
     lv_obj_t *btn_container = lv_obj_create(dialog);
@@ -233,61 +246,36 @@ static void show_save_scene_modal(void)
     lv_keyboard_set_textarea(s_save_keyboard, s_save_textarea);
     lv_obj_add_flag(s_save_keyboard, LV_OBJ_FLAG_HIDDEN);  // Hidden until textarea focused
     
-    // Focus the textarea to show keyboard
-    lv_obj_add_state(s_save_textarea, LV_STATE_FOCUSED);
+    lv_obj_add_flag(s_save_modal, LV_OBJ_FLAG_HIDDEN);
 }
 
 /**
- * @brief Calculate display RGB from RGBW + brightness (additive light mixing)
- * 
- * For RGBW LEDs:
- * - RGB channels define the hue/color
- * - White LED blends towards white, but doesn't completely wash out color
- * - Brightness acts as intensity using gamma curve for perceptual accuracy
+ * @brief Show the Save Scene modal dialog (FR-023)
  * 
- * @param brightness Master brightness (0-255)
- * @param r Red channel (0-255)
- * @param g Green channel (0-255)
- * @param b Blue channel (0-255)
- * @param w White channel (0-255)
- * @return lv_color_t Display color for preview
+ * The modal is built on first use and reset with the current values on
+ * later opens.
  */
-lv_color_t ui_calculate_preview_color(uint8_t brightness, uint8_t r, uint8_t g, uint8_t b, uint8_t w)
+static void show_save_scene_modal(void)
 {
-    // White LED blends color towards white, but preserves some hue
-    // This keeps color visible even at high white values
-    // blend_factor = w / 320 means max 80% blend towards white at w=255
-    // For each channel: result = color + (255 - color) * blend_factor
-    uint16_t full_r = r + ((255 - r) * w) / 320;
-    uint16_t full_g = g + ((255 - g) * w) / 320;
-    uint16_t full_b = b + ((255 - b) * w) / 320;
-    
-    // Clamp to 255 (shouldn't be needed with /512 but for safety)
-    if (full_r > 255) full_r = 255;
-    if (full_g > 255) full_g = 255;
-    if (full_b > 255) full_b = 255;
-    
-    // Apply brightness as intensity using square root for perceptual linearity
-    // This keeps colors visible at lower brightness (like alpha/opacity)
-    // brightness=0 -> 0%, brightness=64 -> 50%, brightness=255 -> 100%
-    uint32_t b_normalized = (brightness * 255);  // 0-65025
-    uint32_t intensity = 0;
-    if (b_normalized > 0) {
-        // Integer square root using Newton-Raphson
-        uint32_t x = b_normalized;
-        uint32_t y = x;
-        while (y > (x / y)) {
-            y = (y + x / y) / 2;
-        }
-        intensity = y;
+    int64_t open_start = esp_timer_get_time();
+    
+    bool built = false;
+    if (s_save_modal == NULL) {
+        create_save_scene_modal();
+        built = true;
     }
-    // intensity is now 0-255 with gamma 0.5 curve applied
     
-    uint16_t final_r = (full_r * intensity) / 255;
-    uint16_t final_g = (full_g * intensity) / 255;
-    uint16_t final_b = (full_b * intensity) / 255;
+    lv_textarea_set_text(s_save_textarea, "");
+    lv_label_set_text_fmt(s_save_values_label, "B:%d  R:%d  G:%d  B:%d  W:%d",
+                          s_manual_state.brightness, s_manual_state.red, s_manual_state.green,
+                          s_manual_state.blue, s_manual_state.white);
     
-    return lv_color_make((uint8_t)final_r, (uint8_t)final_g, (uint8_t)final_b);
+    // Focus the textarea to show keyboard
+    lv_obj_add_state(s_save_textarea, LV_STATE_FOCUSED);
+    
+    lv_obj_move_foreground(s_save_modal);
+    lv_obj_clear_flag(s_save_modal, LV_OBJ_FLAG_HIDDEN);
+    ui_perf_mark_open(built ? "Save modal (built)" : "Save modal", open_start);
 }
 
 /**
@@ -313,6 +301,29 @@ static void update_slider_label(lv_obj_t *label, const char *name, uint8_t value
     lv_label_set_text(label, buf);
 }
 
+/**
+ * @brief Current slider values as a lighting state
+ */
+static lighting_state_t get_manual_lighting_state(void)
+{
+    lighting_state_t state = {
+        .brightness = s_manual_state.brightness,
+        .red = s_manual_state.red,
+        .green = s_manual_state.green,
+        .blue = s_manual_state.blue,
+        .white = s_manual_state.white
+    };
+    return state;
+}
+
+/**
+ * @brief Check if the Live switch is on
+ */
+static bool is_live_enabled(void)
+{
+    return s_live_switch && lv_obj_has_state(s_live_switch, LV_STATE_CHECKED);
+}
+
 /**
  * @brief Slider value changed event handler
  */
@@ -341,6 +352,39 @@ static void slider_event_cb(lv_event_t *e)
     
     // Update color preview circle
     update_color_preview();
+    
+    // Live mode: the fade controller coalesces drags to a bounded rate
+    if (is_live_enabled()) {
+        lighting_state_t state = get_manual_lighting_state();
+        fade_controller_live_update(&state);
+    }
+}
+
+/**
+ * @brief Slider released event handler - sends the exact final values in Live mode
+ */
+static void slider_released_cb(lv_event_t *e)
+{
+    if (is_live_enabled()) {
+        lighting_state_t state = get_manual_lighting_state();
+        fade_controller_live_commit(&state);
+    }
+}
+
+/**
+ * @brief Live switch event handler
+ * 
+ * Switching on sends the current slider values so the lights match the
+ * preview before the first drag.
+ */
+static void live_switch_event_cb(lv_event_t *e)
+{
+    ESP_LOGI(TAG, "Live preview %s", is_live_enabled() ? "on" : "off");
+    
+    if (is_live_enabled()) {
+        lighting_state_t state = get_manual_lighting_state();
+        fade_controller_live_commit(&state);
+    }
 }
 
 /**
@@ -354,13 +398,7 @@ static void apply_btn_event_cb(lv_event_t *e)
              s_manual_state.blue, s_manual_state.white);
     
     // Apply immediately (no fade from manual control)
-    lighting_state_t state = {
-        .brightness = s_manual_state.brightness,
-        .red = s_manual_state.red,
-        .green = s_manual_state.green,
-        .blue = s_manual_state.blue,
-        .white = s_manual_state.white
-    };
+    lighting_state_t state = get_manual_lighting_state();
     
     esp_err_t ret = fade_controller_apply_immediate(&state);
     if (ret != ESP_OK) {
@@ -400,6 +438,8 @@ static lv_obj_t* create_labeled_slider(lv_obj_t *parent, const char *label_text,
     lv_obj_set_size(slider, 420, 20);  // Taller slider for easier touch
     lv_obj_align(slider, LV_ALIGN_TOP_LEFT, 20, y_pos + 40);  // Increased from 30 to 40
     lv_obj_add_event_cb(slider, slider_event_cb, LV_EVENT_VALUE_CHANGED, NULL);
+    lv_obj_add_event_cb(slider, slider_released_cb, LV_EVENT_RELEASED, NULL);
+    lv_obj_add_event_cb(slider, slider_released_cb, LV_EVENT_PRESS_LOST, NULL);
     
     // Style the slider - Material Blue with darker grey background
     lv_obj_set_style_bg_color(slider, lv_color_make(189, 189, 189), LV_PART_MAIN);  // Darker gray #BDBDBD
@@ -436,13 +476,26 @@ void ui_create_manual_tab(lv_obj_t *parent)
 
     // Create color preview circle on right side
     s_color_preview = lv_obj_create(parent);
-    lv_obj_set_size(s_color_preview, 140, 140);
-    lv_obj_align(s_color_preview, LV_ALIGN_TOP_RIGHT, -60, 20);
+    lv_obj_set_size(s_color_preview, 120, 120);
+    lv_obj_align(s_color_preview, LV_ALIGN_TOP_RIGHT, -70, 15);
     lv_obj_set_style_radius(s_color_preview, LV_RADIUS_CIRCLE, LV_PART_MAIN);
     lv_obj_clear_flag(s_color_preview, LV_OBJ_FLAG_SCROLLABLE);
     
     // Set initial preview color
     update_color_preview();
+    
+    // Live switch below the preview - streams slider drags to the lights
+    lv_obj_t *label_live = lv_label_create(parent);
+    lv_label_set_text(label_live, "Live");
+    lv_obj_set_style_text_font(label_live, &lv_font_montserrat_28, LV_PART_MAIN);
+    lv_obj_set_style_text_color(label_live, lv_color_hex(0x0000), LV_PART_MAIN);  // Black text
+    lv_obj_align(label_live, LV_ALIGN_TOP_RIGHT, -120, 151);
+    
+    s_live_switch = lv_switch_create(parent);
+    lv_obj_set_size(s_live_switch, 70, 36);
+    lv_obj_align(s_live_switch, LV_ALIGN_TOP_RIGHT, -35, 150);
+    lv_obj_set_style_bg_color(s_live_switch, lv_color_make(255, 152, 0), LV_PART_INDICATOR | LV_STATE_CHECKED);  // Material Orange
+    lv_obj_add_event_cb(s_live_switch, live_switch_event_cb, LV_EVENT_VALUE_CHANGED, NULL);
 
     // Create buttons on right third, below color preview
     // Apply button (FR-021, FR-022)
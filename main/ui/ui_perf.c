@@ -0,0 +1,356 @@
+/**
+ * @file ui_perf.c
+ * @brief Render pipeline instrumentation and on-screen perf overlay
+ * 
+ * Records, for the last CONFIG_UI_PERF_WINDOW_FRAMES rendered frames, the
+ * render time, flush time and invalidated area, and for LVGL task loops
+ * the time spent in lv_timer_handler() and waiting for the LVGL mutex.
+ * Histograms and percentiles are computed from these rolling windows on
+ * demand, so recording is a few stores per frame.
+ * 
+ * The render time is measured by wrapping the display's refresh timer;
+ * flush time is reported by the flush callbacks in ui_common.c.
+ */
+
+#include "ui_common.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "ui_perf";
+
+/// Frames slower than this violate the "UI must not block > 50 ms" NFR
+#define PERF_BUDGET_US          50000
+
+/// Hold time on the gesture object that toggles the overlay
+#define PERF_GESTURE_HOLD_MS    3000
+
+/// Overlay refresh period
+#define PERF_OVERLAY_PERIOD_MS  500
+
+#define PERF_WINDOW             CONFIG_UI_PERF_WINDOW_FRAMES
+
+/// Histogram bucket upper bounds in microseconds (last bucket is open)
+static const uint32_t s_bucket_us[] = { 2000, 4000, 8000, 16000, 33000, 50000, 100000 };
+#define PERF_BUCKETS            (sizeof(s_bucket_us) / sizeof(s_bucket_us[0]) + 1)
+
+/**
+ * @brief Rolling window of samples
+ */
+typedef struct {
+    uint32_t samples[PERF_WINDOW];
+    uint32_t head;      ///< Next slot to write
+    uint32_t count;     ///< Valid samples (<= PERF_WINDOW)
+} perf_window_t;
+
+static struct {
+    lv_disp_t *disp;
+    lv_timer_cb_t refr_cb;      ///< LVGL's own refresh timer callback
+    
+    perf_window_t render_us;
+    perf_window_t flush_us;
+    perf_window_t area_px;
+    perf_window_t handler_us;
+    perf_window_t mutex_wait_us;
+    
+    uint32_t frame_flush_us;    ///< Flush time accumulated for the current frame
+    uint32_t frame_px;          ///< Pixels reported by the monitor callback
+    bool frame_rendered;
+    
+    uint32_t frames_total;
+    uint32_t over_budget_total;
+    
+    const char *open_name;      ///< Screen element waiting for its first frame
+    int64_t open_start_us;
+    
+    lv_obj_t *overlay;
+    lv_timer_t *overlay_timer;
+    uint32_t overlay_frames;    ///< frames_total at the last overlay update
+    uint32_t press_start_ms;
+    bool gesture_fired;
+} s_perf;
+
+static void window_add(perf_window_t *w, uint32_t value)
+{
+    w->samples[w->head] = value;
+    w->head = (w->head + 1) % PERF_WINDOW;
+    if (w->count < PERF_WINDOW) {
+        w->count++;
+    }
+}
+
+static int compare_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Summary of a window: percentiles and histogram
+ */
+typedef struct {
+    uint32_t count;
+    uint32_t p50;
+    uint32_t p95;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t buckets[PERF_BUCKETS];
+} perf_summary_t;
+
+static void window_summarize(const perf_window_t *w, perf_summary_t *out)
+{
+    static uint32_t sorted[PERF_WINDOW];
+    
+    memset(out, 0, sizeof(*out));
+    out->count = w->count;
+    if (w->count == 0) {
+        return;
+    }
+    
+    memcpy(sorted, w->samples, w->count * sizeof(uint32_t));
+    qsort(sorted, w->count, sizeof(uint32_t), compare_u32);
+    out->p50 = sorted[w->count * 50 / 100];
+    out->p95 = sorted[w->count * 95 / 100];
+    out->max = sorted[w->count - 1];
+    
+    for (uint32_t i = 0; i < w->count; i++) {
+        out->sum += sorted[i];
+        size_t b = 0;
+        while (b < PERF_BUCKETS - 1 && sorted[i] >= s_bucket_us[b]) {
+            b++;
+        }
+        out->buckets[b]++;
+    }
+}
+
+/**
+ * @brief Display monitor callback - called by LVGL after each rendered frame
+ */
+static void perf_monitor_cb(lv_disp_drv_t *drv, uint32_t time_ms, uint32_t px)
+{
+    s_perf.frame_rendered = true;
+    s_perf.frame_px = px;
+}
+
+/**
+ * @brief Wrapper around LVGL's display refresh timer that times each frame
+ */
+static void perf_refr_timer_cb(lv_timer_t *timer)
+{
+    s_perf.frame_rendered = false;
+    s_perf.frame_flush_us = 0;
+    
+    int64_t start = esp_timer_get_time();
+    s_perf.refr_cb(timer);
+    uint32_t elapsed_us = (uint32_t)(esp_timer_get_time() - start);
+    
+    if (!s_perf.frame_rendered) {
+        return;
+    }
+    
+    // Render time excludes the time spent in flush callbacks
+    uint32_t flush_us = s_perf.frame_flush_us < elapsed_us ? s_perf.frame_flush_us : elapsed_us;
+    window_add(&s_perf.render_us, elapsed_us - flush_us);
+    window_add(&s_perf.flush_us, flush_us);
+    window_add(&s_perf.area_px, s_perf.frame_px);
+    
+    s_perf.frames_total++;
+    if (elapsed_us > PERF_BUDGET_US) {
+        s_perf.over_budget_total++;
+    }
+    
+    if (s_perf.open_name) {
+        ESP_LOGI(TAG, "%s: first frame after %lu ms", s_perf.open_name,
+                 (unsigned long)((esp_timer_get_time() - s_perf.open_start_us) / 1000));
+        s_perf.open_name = NULL;
+    }
+}
+
+void ui_perf_init(lv_disp_t *disp)
+{
+    if (disp == NULL || disp->refr_timer == NULL) {
+        return;
+    }
+    
+    s_perf.disp = disp;
+    s_perf.refr_cb = disp->refr_timer->timer_cb;
+    lv_timer_set_cb(disp->refr_timer, perf_refr_timer_cb);
+    disp->driver->monitor_cb = perf_monitor_cb;
+    
+    ESP_LOGI(TAG, "Render instrumentation enabled (%d frame window)", PERF_WINDOW);
+}
+
+void ui_perf_record_loop(uint32_t mutex_wait_us, uint32_t handler_us)
+{
+    window_add(&s_perf.mutex_wait_us, mutex_wait_us);
+    window_add(&s_perf.handler_us, handler_us);
+}
+
+void ui_perf_record_flush(uint32_t flush_us)
+{
+    s_perf.frame_flush_us += flush_us;
+}
+
+void ui_perf_mark_open(const char *name, int64_t start_us)
+{
+    s_perf.open_name = name;
+    s_perf.open_start_us = start_us;
+}
+
+/**
+ * @brief Overlay timer - refresh the overlay text from the rolling windows
+ */
+static void overlay_timer_cb(lv_timer_t *timer)
+{
+    perf_summary_t render, flush, area, mutex;
+    window_summarize(&s_perf.render_us, &render);
+    window_summarize(&s_perf.flush_us, &flush);
+    window_summarize(&s_perf.area_px, &area);
+    window_summarize(&s_perf.mutex_wait_us, &mutex);
+    
+    uint32_t frames = s_perf.frames_total - s_perf.overlay_frames;
+    s_perf.overlay_frames = s_perf.frames_total;
+    uint32_t screen_px = lv_disp_get_hor_res(s_perf.disp) * lv_disp_get_ver_res(s_perf.disp);
+    
+    lv_label_set_text_fmt(s_perf.overlay,
+        "%lu fps  render p50 %lu.%lu p95 %lu.%lu max %lu ms\n"
+        "flush p95 %lu.%lu ms  area %lu%%  mutex max %lu.%lu ms  >50ms: %lu",
+        (unsigned long)(frames * 1000 / PERF_OVERLAY_PERIOD_MS),
+        (unsigned long)(render.p50 / 1000), (unsigned long)(render.p50 / 100 % 10),
+        (unsigned long)(render.p95 / 1000), (unsigned long)(render.p95 / 100 % 10),
+        (unsigned long)(render.max / 1000),
+        (unsigned long)(flush.p95 / 1000), (unsigned long)(flush.p95 / 100 % 10),
+        (unsigned long)(area.count ? area.sum * 100 / area.count / screen_px : 0),
+        (unsigned long)(mutex.max / 1000), (unsigned long)(mutex.max / 100 % 10),
+        (unsigned long)s_perf.over_budget_total);
+}
+
+void ui_perf_set_overlay_visible(bool visible)
+{
+    if (visible && !s_perf.overlay) {
+        // On the system layer so it stays above modals; not clickable
+        s_perf.overlay = lv_label_create(lv_layer_sys());
+        lv_obj_set_style_text_font(s_perf.overlay, &lv_font_montserrat_14, LV_PART_MAIN);
+        lv_obj_set_style_text_color(s_perf.overlay, lv_color_white(), LV_PART_MAIN);
+        lv_obj_set_style_bg_color(s_perf.overlay, lv_color_black(), LV_PART_MAIN);
+        lv_obj_set_style_bg_opa(s_perf.overlay, LV_OPA_70, LV_PART_MAIN);
+        lv_obj_set_style_pad_all(s_perf.overlay, 4, LV_PART_MAIN);
+        lv_obj_align(s_perf.overlay, LV_ALIGN_BOTTOM_LEFT, 0, 0);
+        s_perf.overlay_frames = s_perf.frames_total;
+        s_perf.overlay_timer = lv_timer_create(overlay_timer_cb, PERF_OVERLAY_PERIOD_MS, NULL);
+        overlay_timer_cb(s_perf.overlay_timer);
+    } else if (!visible && s_perf.overlay) {
+        lv_timer_del(s_perf.overlay_timer);
+        s_perf.overlay_timer = NULL;
+        lv_obj_del(s_perf.overlay);
+        s_perf.overlay = NULL;
+    }
+}
+
+/**
+ * @brief Hidden gesture - holding the object for PERF_GESTURE_HOLD_MS toggles the overlay
+ */
+static void perf_gesture_cb(lv_event_t *e)
+{
+    lv_event_code_t code = lv_event_get_code(e);
+    
+    if (code == LV_EVENT_PRESSED) {
+        s_perf.press_start_ms = lv_tick_get();
+        s_perf.gesture_fired = false;
+    } else if (code == LV_EVENT_LONG_PRESSED_REPEAT && !s_perf.gesture_fired &&
+               lv_tick_elaps(s_perf.press_start_ms) >= PERF_GESTURE_HOLD_MS) {
+        s_perf.gesture_fired = true;
+        ui_perf_set_overlay_visible(s_perf.overlay == NULL);
+    }
+}
+
+void ui_perf_attach_toggle_gesture(lv_obj_t *obj)
+{
+    lv_obj_add_event_cb(obj, perf_gesture_cb, LV_EVENT_PRESSED, NULL);
+    lv_obj_add_event_cb(obj, perf_gesture_cb, LV_EVENT_LONG_PRESSED_REPEAT, NULL);
+}
+
+/**
+ * @brief Print one window's summary and histogram
+ */
+static void dump_window(const char *name, const perf_window_t *w)
+{
+    perf_summary_t sum;
+    window_summarize(w, &sum);
+    if (sum.count == 0) {
+        printf("%-12s no samples\n", name);
+        return;
+    }
+    
+    printf("%-12s n=%lu avg %.2f p50 %.2f p95 %.2f max %.2f ms\n", name,
+           (unsigned long)sum.count, sum.sum / 1000.0 / sum.count,
+           sum.p50 / 1000.0, sum.p95 / 1000.0, sum.max / 1000.0);
+    printf("%-12s", "");
+    for (size_t b = 0; b < PERF_BUCKETS; b++) {
+        if (b < PERF_BUCKETS - 1) {
+            printf(" <%lu:%lu", (unsigned long)(s_bucket_us[b] / 1000), (unsigned long)sum.buckets[b]);
+        } else {
+            printf(" >=%lu:%lu", (unsigned long)(s_bucket_us[b - 1] / 1000), (unsigned long)sum.buckets[b]);
+        }
+    }
+    printf("\n");
+}
+
+void ui_perf_dump(void)
+{
+    if (!ui_lock()) {
+        return;
+    }
+    
+    perf_summary_t area;
+    window_summarize(&s_perf.area_px, &area);
+    uint32_t screen_px = s_perf.disp ?
+        lv_disp_get_hor_res(s_perf.disp) * lv_disp_get_ver_res(s_perf.disp) : 1;
+    
+    printf("Render pipeline (last %d frames, histogram buckets in ms):\n", PERF_WINDOW);
+    dump_window("render", &s_perf.render_us);
+    dump_window("flush", &s_perf.flush_us);
+    dump_window("timer_handler", &s_perf.handler_us);
+    dump_window("mutex_wait", &s_perf.mutex_wait_us);
+    printf("%-12s avg %lu%% p95 %lu%% of screen\n", "area",
+           (unsigned long)(area.count ? area.sum * 100 / area.count / screen_px : 0),
+           (unsigned long)(area.p95 * 100 / screen_px));
+    printf("frames %lu, over 50 ms budget %lu\n",
+           (unsigned long)s_perf.frames_total, (unsigned long)s_perf.over_budget_total);
+    
+    ui_draw_stats_t draw;
+    ui_draw_get_stats(&draw);
+    uint64_t draw_px = draw.fill_px + draw.blend_px + draw.lvgl_px;
+    if (draw_px == 0) {
+        draw_px = 1;
+    }
+    printf("%-12s PIE %s: fill %llu%% blend %llu%% LVGL %llu%% of blended pixels\n", "draw",
+           ui_draw_pie_enabled() ? "on" : "off",
+           (unsigned long long)(draw.fill_px * 100 / draw_px),
+           (unsigned long long)(draw.blend_px * 100 / draw_px),
+           (unsigned long long)(draw.lvgl_px * 100 / draw_px));
+    
+    ui_unlock();
+}
+
+void ui_perf_reset(void)
+{
+    if (!ui_lock()) {
+        return;
+    }
+    
+    memset(&s_perf.render_us, 0, sizeof(s_perf.render_us));
+    memset(&s_perf.flush_us, 0, sizeof(s_perf.flush_us));
+    memset(&s_perf.area_px, 0, sizeof(s_perf.area_px));
+    memset(&s_perf.handler_us, 0, sizeof(s_perf.handler_us));
+    memset(&s_perf.mutex_wait_us, 0, sizeof(s_perf.mutex_wait_us));
+    s_perf.frames_total = 0;
+    s_perf.over_budget_total = 0;
+    s_perf.overlay_frames = 0;
+    ui_draw_reset_stats();
+    
+    ui_unlock();
+}
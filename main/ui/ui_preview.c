@@ -0,0 +1,102 @@
+/**
+ * @file ui_preview.c
+ * @brief RGBW preview colour for sliders, scene cards and the edit modal
+ * 
+ * Maps an RGBW + brightness setting to the colour drawn in the preview
+ * circles. All curves come from the tables in ui_preview_lut.h (generated
+ * by tools/gen_preview_lut.py), so a colour costs a few lookups and
+ * multiplies with no divides or square roots.
+ * 
+ * Two models are available:
+ * - Default: the original perceptual approximation. The white LED blends
+ *   each channel up to 80% towards white and brightness is applied with a
+ *   square-root curve so dim scenes stay visible.
+ * - CONFIG_PREVIEW_COLOR_CALIBRATED: LED drive is treated as linear light,
+ *   mixed through a 3x4 matrix of the emitters' colours in linear sRGB and
+ *   encoded to sRGB. Over-range colours are scaled down keeping their hue.
+ */
+
+#include "ui_common.h"
+#include "ui_preview_lut.h"
+
+#if CONFIG_PREVIEW_COLOR_CALIBRATED
+
+/// Full scale of a drive product (channel * brightness)
+#define DRIVE_MAX       (255 * 255)
+/// Linear light 1.0 at the matrix output (Q12 matrix times full drive)
+#define LINEAR_ONE      ((int64_t)DRIVE_MAX << PREVIEW_CAL_SHIFT)
+
+static lv_color_t preview_color(uint8_t brightness, uint8_t r, uint8_t g, uint8_t b, uint8_t w)
+{
+    // PWM duty is linear light; brightness dims every emitter alike
+    int32_t drive[4] = { r * brightness, g * brightness, b * brightness, w * brightness };
+    
+    int64_t linear[3];
+    int64_t peak = 0;
+    for (int row = 0; row < 3; row++) {
+        const int16_t *m = s_preview_cal_matrix[row];
+        linear[row] = (int64_t)m[0] * drive[0] + (int64_t)m[1] * drive[1] +
+                      (int64_t)m[2] * drive[2] + (int64_t)m[3] * drive[3];
+        if (linear[row] < 0) {
+            linear[row] = 0;
+        }
+        if (linear[row] > peak) {
+            peak = linear[row];
+        }
+    }
+    
+    // Brighter than the display can show: scale down, keeping the hue
+    uint8_t out[3];
+    for (int row = 0; row < 3; row++) {
+        int64_t v = linear[row];
+        if (peak > LINEAR_ONE) {
+            v = v * LINEAR_ONE / peak;
+        }
+        out[row] = s_preview_srgb_lut[v * (PREVIEW_SRGB_LUT_SIZE - 1) / LINEAR_ONE];
+    }
+    
+    return lv_color_make(out[0], out[1], out[2]);
+}
+
+#else
+
+/**
+ * @brief x / 255 for x in [0, 65025] without a divide
+ */
+static inline uint32_t div255(uint32_t x)
+{
+    return (x + 1 + (x >> 8)) >> 8;
+}
+
+static lv_color_t preview_color(uint8_t brightness, uint8_t r, uint8_t g, uint8_t b, uint8_t w)
+{
+    // White LED blends color towards white, but preserves some hue:
+    // result = color + (255 - color) * w / 320
+    uint32_t blend = s_preview_white_blend_lut[w];
+    uint32_t full_r = r + (((255 - r) * blend) >> PREVIEW_WHITE_BLEND_SHIFT);
+    uint32_t full_g = g + (((255 - g) * blend) >> PREVIEW_WHITE_BLEND_SHIFT);
+    uint32_t full_b = b + (((255 - b) * blend) >> PREVIEW_WHITE_BLEND_SHIFT);
+    
+    // Brightness as intensity with a square-root curve:
+    // brightness=0 -> 0%, brightness=64 -> 50%, brightness=255 -> 100%
+    uint32_t intensity = s_preview_intensity_lut[brightness];
+    
+    return lv_color_make((uint8_t)div255(full_r * intensity),
+                         (uint8_t)div255(full_g * intensity),
+                         (uint8_t)div255(full_b * intensity));
+}
+
+#endif
+
+lv_color_t ui_calculate_preview_color(uint8_t brightness, uint8_t r, uint8_t g, uint8_t b, uint8_t w)
+{
+    return preview_color(brightness, r, g, b, w);
+}
+
+void ui_calculate_preview_colors(const ui_scene_t *scenes, lv_color_t *colors, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        const ui_scene_t *s = &scenes[i];
+        colors[i] = preview_color(s->brightness, s->red, s->green, s->blue, s->white);
+    }
+}
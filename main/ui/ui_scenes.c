@@ -12,7 +12,10 @@
 #include "ui_common.h"
 #include "../app/scene_storage.h"
 #include "../app/fade_controller.h"
+#include "../app/warm_restart.h"
 #include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -22,31 +25,81 @@ static const char *TAG = "ui_scenes";
 #define CARD_WIDTH      240
 #define CARD_HEIGHT     260
 #define CARD_GAP        20
+#define CARD_PITCH      (CARD_WIDTH + CARD_GAP)
+#define CAROUSEL_WIDTH  760
 #define CAROUSEL_HEIGHT 260
 
+// Pooled card objects: the ~3 visible cards plus a margin on each side.
+// Cards are rebound to scene data as the carousel scrolls, so object count
+// does not grow with the scene library.
+#define CARD_POOL_SIZE  7
+
+// Cards created with the tab; the rest of the pool is built in idle slices
+// after the first frame (ui_scenes_build_step)
+#define CARD_POOL_INITIAL   3
+
+// Card child order (see create_scene_card)
+#define CARD_CHILD_EDIT_BTN     0
+#define CARD_CHILD_DELETE_BTN   1
+#define CARD_CHILD_COLOR_CIRCLE 2
+#define CARD_CHILD_NAME_LABEL   3
+#define CARD_CHILD_VALUES_LABEL 4
+
 // Scene selector state
 static struct {
     int current_scene_index;
     uint16_t transition_duration_sec;
     bool transition_in_progress;
     bool fade_started;            // True once we've seen FADE_STATE_FADING
-    bool pending_progress_start;  // Request from external task to start progress tracking
     char pending_delete_name[32];  // Scene name pending deletion
 } s_scenes_state = {
     .current_scene_index = 0,
     .transition_duration_sec = 10,
     .transition_in_progress = false,
     .fade_started = false,
-    .pending_progress_start = false,
     .pending_delete_name = ""
 };
 
-// Cached scenes for card access
-static ui_scene_t s_cached_scenes[SCENE_STORAGE_MAX_SCENES];
-static size_t s_cached_scene_count = 0;
+// Card snapshots keep the rounded corners, so they need an alpha channel
+#define CARD_SNAPSHOT_CF        LV_IMG_CF_TRUE_COLOR_ALPHA
+#define CARD_SNAPSHOT_IDLE_MS   250
 
-// Card objects array for selection highlighting
-static lv_obj_t *s_scene_cards[SCENE_STORAGE_MAX_SCENES];
+// Card pool - each card is bound to one scene index (or unbound and hidden)
+static struct {
+    lv_obj_t *card;
+    int scene_index;            // -1 if unbound
+    lv_obj_t *image;            // Drawn instead of the card while scrolling (NULL if disabled)
+    lv_img_dsc_t snapshot;      // Pre-rendered card, buffer in PSRAM
+    uint32_t snapshot_buf_size;
+    bool snapshot_valid;        // False after the card is rebound or edited
+} s_card_pool[CARD_POOL_SIZE];
+static size_t s_card_pool_built = 0;   // Slots created so far (<= CARD_POOL_SIZE)
+static bool s_carousel_scrolling = false;
+
+// Frame timing of the current scroll (interval between scroll events)
+static struct {
+    int64_t start_us;
+    int64_t busy_start_us;      // LVGL task busy time at scroll start
+    int64_t last_us;
+    int64_t worst_us;
+    uint32_t frames;
+} s_scroll_timing;
+static size_t s_scene_card_count = 0;  // Scenes in the carousel (not cards)
+static int s_window_first = -1;        // First scene index of the bound window
+static lv_obj_t *s_carousel_spacer = NULL;  // Sets the scroll extent for all scenes
+
+// Shared card styles (initialized once, never per card)
+static struct {
+    bool initialized;
+    lv_style_t card;
+    lv_style_t card_selected;
+    lv_style_t btn_edit;
+    lv_style_t btn_delete;
+    lv_style_t btn_icon;
+    lv_style_t color_circle;
+    lv_style_t name_label;
+    lv_style_t values_label;
+} s_card_styles;
 
 // UI Objects
 static lv_obj_t *s_carousel = NULL;
@@ -56,9 +109,12 @@ static lv_obj_t *s_btn_apply = NULL;
 static lv_obj_t *s_progress_bar = NULL;
 static lv_obj_t *s_label_no_scenes = NULL;
 
-// Progress bar update timer
+// Progress bar update timer (paused while no fade is tracked)
 static lv_timer_t *s_progress_timer = NULL;
 
+// Snapshot refresh timer (paused while every bound card's snapshot is valid)
+static lv_timer_t *s_snapshot_timer = NULL;
+
 // Delete confirmation modal
 static lv_obj_t *s_delete_modal = NULL;
 
@@ -78,6 +134,7 @@ static struct {
     lv_obj_t *label_blue;
     lv_obj_t *label_white;
     lv_obj_t *color_preview;
+    lv_obj_t *live_switch;
     lv_obj_t *btn_move_left;
     lv_obj_t *btn_move_right;
     lv_obj_t *label_order_index;
@@ -118,24 +175,39 @@ static void update_order_index_label(void)
     }
 }
 
+/**
+ * @brief Mark a card's snapshot stale and wake the snapshot refresh timer
+ */
+static void invalidate_card_snapshot(size_t slot)
+{
+    s_card_pool[slot].snapshot_valid = false;
+    if (s_snapshot_timer) {
+        lv_timer_resume(s_snapshot_timer);
+    }
+}
+
 /**
  * @brief Update card selection visual - highlight selected card with blue border
+ * 
+ * The selected look is the LV_STATE_CHECKED part of the shared card style.
  * Note: Cards have no shadows for scroll performance optimization
  */
 static void update_card_selection(int selected_index)
 {
-    for (size_t i = 0; i < s_cached_scene_count; i++) {
-        if (s_scene_cards[i]) {
-            if ((int)i == selected_index) {
-                // Selected: Material Blue border, thicker
-                lv_obj_set_style_border_color(s_scene_cards[i], lv_color_make(33, 150, 243), LV_PART_MAIN);
-                lv_obj_set_style_border_width(s_scene_cards[i], 4, LV_PART_MAIN);
-            } else {
-                // Unselected: light gray border
-                lv_obj_set_style_border_color(s_scene_cards[i], lv_color_make(224, 224, 224), LV_PART_MAIN);
-                lv_obj_set_style_border_width(s_scene_cards[i], 2, LV_PART_MAIN);
-            }
+    for (size_t i = 0; i < s_card_pool_built; i++) {
+        if (!s_card_pool[i].card) {
+            continue;
+        }
+        bool selected = (s_card_pool[i].scene_index >= 0 && s_card_pool[i].scene_index == selected_index);
+        if (selected == lv_obj_has_state(s_card_pool[i].card, LV_STATE_CHECKED)) {
+            continue;
+        }
+        if (selected) {
+            lv_obj_add_state(s_card_pool[i].card, LV_STATE_CHECKED);
+        } else {
+            lv_obj_clear_state(s_card_pool[i].card, LV_STATE_CHECKED);
         }
+        invalidate_card_snapshot(i);
     }
 }
 
@@ -168,22 +240,9 @@ static void duration_slider_event_cb(lv_event_t *e)
  * @brief Progress bar update timer callback (FR-043)
  * 
  * Called periodically to update the progress bar during fades.
- * Also handles pending progress start requests from external tasks.
  */
 static void progress_timer_cb(lv_timer_t *timer)
 {
-    // Check for pending progress start request from external task
-    if (s_scenes_state.pending_progress_start) {
-        s_scenes_state.pending_progress_start = false;
-        s_scenes_state.transition_in_progress = true;
-        s_scenes_state.fade_started = false;
-        if (s_progress_bar) {
-            lv_obj_clear_flag(s_progress_bar, LV_OBJ_FLAG_HIDDEN);
-            lv_bar_set_value(s_progress_bar, 0, LV_ANIM_OFF);
-        }
-        ESP_LOGD(TAG, "Progress tracking started from pending request");
-    }
-    
     // If we're not tracking a transition, nothing to do
     if (!s_scenes_state.transition_in_progress) {
         return;
@@ -207,6 +266,7 @@ static void progress_timer_cb(lv_timer_t *timer)
         }
         s_scenes_state.transition_in_progress = false;
         s_scenes_state.fade_started = false;
+        lv_timer_pause(timer);
         
         ESP_LOGD(TAG, "Fade complete, progress bar hidden");
     }
@@ -224,19 +284,30 @@ static void start_progress_updates(void)
     }
     s_scenes_state.transition_in_progress = true;
     s_scenes_state.fade_started = false;  // Will be set true when we see FADING
+    if (s_progress_timer) {
+        lv_timer_resume(s_progress_timer);
+    }
+}
+
+/**
+ * @brief ui_post() wrapper for start_progress_updates()
+ */
+static void start_progress_cmd(void *arg)
+{
+    start_progress_updates();
 }
 
 /**
  * @brief Start the progress bar tracking for a fade in progress (public API)
  * 
- * This is called from main.c (outside LVGL task context), so we just set
- * a pending flag that the progress timer will pick up on its next tick.
+ * Called from main.c (outside LVGL task context), so the start is posted
+ * to the LVGL task.
  */
 void ui_scenes_start_progress_tracking(void)
 {
-    // Set pending flag - the persistent timer will pick this up
-    s_scenes_state.pending_progress_start = true;
-    ESP_LOGD(TAG, "Progress tracking requested (pending)");
+    if (!ui_post(start_progress_cmd, NULL)) {
+        ESP_LOGW(TAG, "Could not queue progress tracking start");
+    }
 }
 
 /**
@@ -246,8 +317,9 @@ static void apply_btn_event_cb(lv_event_t *e)
 {
     ESP_LOGD(TAG, "Apply button pressed");
     
-    if (s_cached_scene_count > 0 && s_scenes_state.current_scene_index < (int)s_cached_scene_count) {
-        ui_scene_t *scene = &s_cached_scenes[s_scenes_state.current_scene_index];
+    ui_scene_t selected;
+    if (scene_storage_get_by_index(s_scenes_state.current_scene_index, &selected) == ESP_OK) {
+        const ui_scene_t *scene = &selected;
         ESP_LOGD(TAG, "Applying scene '%s': B=%d R=%d G=%d B=%d W=%d, Duration=%d sec",
                  scene->name, scene->brightness, scene->red, scene->green,
                  scene->blue, scene->white, s_scenes_state.transition_duration_sec);
@@ -303,8 +375,6 @@ static void delete_confirm_btn_cb(lv_event_t *e)
     esp_err_t ret = scene_storage_delete(s_scenes_state.pending_delete_name);
     if (ret == ESP_OK) {
         ESP_LOGD(TAG, "Scene deleted successfully");
-        // Refresh the carousel - already in LVGL context, use no-lock version
-        scene_storage_reload_ui_no_lock();
     } else {
         ESP_LOGE(TAG, "Failed to delete scene: %s", esp_err_to_name(ret));
     }
@@ -414,15 +484,29 @@ static void show_delete_modal(const char *scene_name)
 
 /**
  * @brief Close the edit scene modal
+ * 
+ * The modal is hidden, not deleted, and rebound on the next open.
  */
 static void close_edit_modal(void)
 {
     if (s_edit_state.modal) {
-        lv_obj_del(s_edit_state.modal);
-        memset(&s_edit_state, 0, sizeof(s_edit_state));
+        lv_obj_add_flag(s_edit_state.keyboard, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_clear_state(s_edit_state.name_textarea, LV_STATE_FOCUSED);
+        // Forget the textarea as the last pressed object so the next tap
+        // focuses it again and shows the keyboard
+        lv_indev_reset(NULL, s_edit_state.name_textarea);
+        lv_obj_add_flag(s_edit_state.modal, LV_OBJ_FLAG_HIDDEN);
     }
 }
 
+/**
+ * @brief Edit modal delete handler - forget the prebuilt modal if the screen is cleaned
+ */
+static void edit_modal_delete_cb(lv_event_t *e)
+{
+    memset(&s_edit_state, 0, sizeof(s_edit_state));
+}
+
 /**
  * @brief Update the edit modal color preview
  */
@@ -446,6 +530,29 @@ static void update_edit_slider_label(lv_obj_t *label, const char *name, uint8_t
     lv_label_set_text(label, buf);
 }
 
+/**
+ * @brief Edit modal slider values as a lighting state
+ */
+static lighting_state_t get_edit_lighting_state(void)
+{
+    lighting_state_t state = {
+        .brightness = s_edit_state.brightness,
+        .red = s_edit_state.red,
+        .green = s_edit_state.green,
+        .blue = s_edit_state.blue,
+        .white = s_edit_state.white
+    };
+    return state;
+}
+
+/**
+ * @brief Check if the edit modal's Live switch is on
+ */
+static bool is_edit_live_enabled(void)
+{
+    return s_edit_state.live_switch && lv_obj_has_state(s_edit_state.live_switch, LV_STATE_CHECKED);
+}
+
 /**
  * @brief Edit modal slider event handler
  */
@@ -472,6 +579,35 @@ static void edit_slider_event_cb(lv_event_t *e)
     }
     
     update_edit_color_preview();
+    
+    if (is_edit_live_enabled()) {
+        lighting_state_t state = get_edit_lighting_state();
+        fade_controller_live_update(&state);
+    }
+}
+
+/**
+ * @brief Edit modal slider released handler - sends the exact final values in Live mode
+ */
+static void edit_slider_released_cb(lv_event_t *e)
+{
+    if (is_edit_live_enabled()) {
+        lighting_state_t state = get_edit_lighting_state();
+        fade_controller_live_commit(&state);
+    }
+}
+
+/**
+ * @brief Edit modal Live switch callback - previews slider drags as they happen
+ */
+static void edit_live_switch_cb(lv_event_t *e)
+{
+    ESP_LOGD(TAG, "Edit live preview %s", is_edit_live_enabled() ? "on" : "off");
+    
+    if (is_edit_live_enabled()) {
+        lighting_state_t state = get_edit_lighting_state();
+        fade_controller_live_commit(&state);
+    }
 }
 
 /**
@@ -492,13 +628,7 @@ static void edit_preview_btn_cb(lv_event_t *e)
              s_edit_state.brightness, s_edit_state.red, s_edit_state.green,
              s_edit_state.blue, s_edit_state.white);
     
-    lighting_state_t state = {
-        .brightness = s_edit_state.brightness,
-        .red = s_edit_state.red,
-        .green = s_edit_state.green,
-        .blue = s_edit_state.blue,
-        .white = s_edit_state.white
-    };
+    lighting_state_t state = get_edit_lighting_state();
     
     esp_err_t ret = fade_controller_apply_immediate(&state);
     if (ret != ESP_OK) {
@@ -530,8 +660,6 @@ static void edit_save_btn_cb(lv_event_t *e)
     if (ret == ESP_OK) {
         ESP_LOGD(TAG, "Scene updated successfully");
         close_edit_modal();
-        // Refresh UI - already in LVGL context, use no-lock version
-        scene_storage_reload_ui_no_lock();
     } else if (ret == ESP_ERR_INVALID_STATE) {
         ESP_LOGW(TAG, "Scene name already exists");
         // Could show error message, but for now just log
@@ -566,8 +694,6 @@ static void edit_move_left_btn_cb(lv_event_t *e)
         }
         // Update order index label
         update_order_index_label();
-        // Refresh UI - already in LVGL context, use no-lock version
-        scene_storage_reload_ui_no_lock();
     }
 }
 
@@ -576,7 +702,7 @@ static void edit_move_left_btn_cb(lv_event_t *e)
  */
 static void edit_move_right_btn_cb(lv_event_t *e)
 {
-    if (s_edit_state.scene_index >= (int)s_cached_scene_count - 1) {
+    if (s_edit_state.scene_index >= (int)scene_storage_get_count() - 1) {
         return;  // Already at rightmost position
     }
     
@@ -588,7 +714,7 @@ static void edit_move_right_btn_cb(lv_event_t *e)
         s_edit_state.scene_index = new_index;
         // Update move button states
         if (s_edit_state.btn_move_right) {
-            if (new_index >= s_cached_scene_count - 1) {
+            if (new_index >= scene_storage_get_count() - 1) {
                 lv_obj_add_state(s_edit_state.btn_move_right, LV_STATE_DISABLED);
             }
         }
@@ -597,8 +723,6 @@ static void edit_move_right_btn_cb(lv_event_t *e)
         }
         // Update order index label
         update_order_index_label();
-        // Refresh UI - already in LVGL context, use no-lock version
-        scene_storage_reload_ui_no_lock();
     }
 }
 
@@ -630,14 +754,11 @@ static void edit_textarea_event_cb(lv_event_t *e)
 /**
  * @brief Create a slider with label for edit modal
  */
-static void create_edit_slider(lv_obj_t *parent, const char *name, uint8_t initial_value,
-                               lv_obj_t **out_slider, lv_obj_t **out_label, lv_coord_t y_pos)
+static void create_edit_slider(lv_obj_t *parent, lv_obj_t **out_slider, lv_obj_t **out_label,
+                               lv_coord_t y_pos)
 {
-    // Label
+    // Label (text set when the modal is bound to a scene)
     *out_label = lv_label_create(parent);
-    char buf[24];
-    snprintf(buf, sizeof(buf), "%s: %d", name, initial_value);
-    lv_label_set_text(*out_label, buf);
     lv_obj_set_style_text_font(*out_label, &lv_font_montserrat_16, LV_PART_MAIN);
     lv_obj_set_style_text_color(*out_label, lv_color_make(33, 33, 33), LV_PART_MAIN);
     lv_obj_align(*out_label, LV_ALIGN_TOP_LEFT, 10, y_pos);
@@ -645,10 +766,11 @@ static void create_edit_slider(lv_obj_t *parent, const char *name, uint8_t initi
     // Slider
     *out_slider = lv_slider_create(parent);
     lv_slider_set_range(*out_slider, 0, 255);
-    lv_slider_set_value(*out_slider, initial_value, LV_ANIM_OFF);
     lv_obj_set_size(*out_slider, 340, 15);
     lv_obj_align(*out_slider, LV_ALIGN_TOP_LEFT, 120, y_pos);
     lv_obj_add_event_cb(*out_slider, edit_slider_event_cb, LV_EVENT_VALUE_CHANGED, NULL);
+    lv_obj_add_event_cb(*out_slider, edit_slider_released_cb, LV_EVENT_RELEASED, NULL);
+    lv_obj_add_event_cb(*out_slider, edit_slider_released_cb, LV_EVENT_PRESS_LOST, NULL);
     
     // Style slider
     lv_obj_set_style_bg_color(*out_slider, lv_color_make(189, 189, 189), LV_PART_MAIN);
@@ -657,26 +779,10 @@ static void create_edit_slider(lv_obj_t *parent, const char *name, uint8_t initi
 }
 
 /**
- * @brief Show edit scene modal (FR-044)
+ * @brief Build the edit scene modal, hidden (once, on first open)
  */
-static void show_edit_scene_modal(int scene_index)
+static void create_edit_modal(void)
 {
-    if (scene_index < 0 || scene_index >= (int)s_cached_scene_count) {
-        ESP_LOGE(TAG, "Invalid scene index for edit: %d", scene_index);
-        return;
-    }
-    
-    // Load current scene values
-    ui_scene_t *scene = &s_cached_scenes[scene_index];
-    s_edit_state.scene_index = scene_index;
-    s_edit_state.brightness = scene->brightness;
-    s_edit_state.red = scene->red;
-    s_edit_state.green = scene->green;
-    s_edit_state.blue = scene->blue;
-    s_edit_state.white = scene->white;
-    
-    ESP_LOGI(TAG, "Opening edit modal for scene '%s' at index %d", scene->name, scene_index);
-    
     // Create modal background (semi-transparent overlay)
     s_edit_state.modal = lv_obj_create(lv_scr_act());
     lv_obj_set_size(s_edit_state.modal, 800, 480);
@@ -685,6 +791,7 @@ static void show_edit_scene_modal(int scene_index)
     lv_obj_set_style_bg_opa(s_edit_state.modal, LV_OPA_50, LV_PART_MAIN);
     lv_obj_set_style_border_width(s_edit_state.modal, 0, LV_PART_MAIN);
     lv_obj_set_style_radius(s_edit_state.modal, 0, LV_PART_MAIN);
+    lv_obj_add_event_cb(s_edit_state.modal, edit_modal_delete_cb, LV_EVENT_DELETE, NULL);
     
     // Create dialog box
     lv_obj_t *dialog = lv_obj_create(s_edit_state.modal);
@@ -719,9 +826,6 @@ static void show_edit_scene_modal(int scene_index)
     lv_obj_add_event_cb(s_edit_state.btn_move_left, edit_move_left_btn_cb, LV_EVENT_CLICKED, NULL);
     lv_obj_set_style_bg_color(s_edit_state.btn_move_left, lv_color_make(33, 150, 243), LV_PART_MAIN);
     lv_obj_set_style_radius(s_edit_state.btn_move_left, 6, LV_PART_MAIN);
-    if (scene_index == 0) {
-        lv_obj_add_state(s_edit_state.btn_move_left, LV_STATE_DISABLED);
-    }
     
     lv_obj_t *left_label = lv_label_create(s_edit_state.btn_move_left);
     lv_label_set_text(left_label, LV_SYMBOL_LEFT);
@@ -734,7 +838,6 @@ static void show_edit_scene_modal(int scene_index)
     lv_obj_set_style_text_font(s_edit_state.label_order_index, &lv_font_montserrat_20, LV_PART_MAIN);
     lv_obj_set_style_text_color(s_edit_state.label_order_index, lv_color_make(33, 33, 33), LV_PART_MAIN);
     lv_obj_align(s_edit_state.label_order_index, LV_ALIGN_TOP_RIGHT, -80, 38);
-    update_order_index_label();  // Set initial value
     
     // Move right button
     s_edit_state.btn_move_right = lv_btn_create(dialog);
@@ -743,9 +846,6 @@ static void show_edit_scene_modal(int scene_index)
     lv_obj_add_event_cb(s_edit_state.btn_move_right, edit_move_right_btn_cb, LV_EVENT_CLICKED, NULL);
     lv_obj_set_style_bg_color(s_edit_state.btn_move_right, lv_color_make(33, 150, 243), LV_PART_MAIN);
     lv_obj_set_style_radius(s_edit_state.btn_move_right, 6, LV_PART_MAIN);
-    if (scene_index >= (int)s_cached_scene_count - 1) {
-        lv_obj_add_state(s_edit_state.btn_move_right, LV_STATE_DISABLED);
-    }
     
     lv_obj_t *right_label = lv_label_create(s_edit_state.btn_move_right);
     lv_label_set_text(right_label, LV_SYMBOL_RIGHT);
@@ -762,7 +862,6 @@ static void show_edit_scene_modal(int scene_index)
     
     s_edit_state.name_textarea = lv_textarea_create(dialog);
     lv_textarea_set_one_line(s_edit_state.name_textarea, true);
-    lv_textarea_set_text(s_edit_state.name_textarea, scene->name);
     lv_obj_set_size(s_edit_state.name_textarea, 280, 40);
     lv_obj_align(s_edit_state.name_textarea, LV_ALIGN_TOP_LEFT, 80, 45);
     lv_obj_set_style_text_font(s_edit_state.name_textarea, &lv_font_montserrat_20, LV_PART_MAIN);
@@ -777,12 +876,11 @@ static void show_edit_scene_modal(int scene_index)
     lv_obj_align(s_edit_state.color_preview, LV_ALIGN_TOP_RIGHT, -30, 100);
     lv_obj_set_style_radius(s_edit_state.color_preview, LV_RADIUS_CIRCLE, LV_PART_MAIN);
     lv_obj_clear_flag(s_edit_state.color_preview, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_CLICKABLE);
-    update_edit_color_preview();
     
     // Preview button (below color preview circle)
     lv_obj_t *btn_preview = lv_btn_create(dialog);
     lv_obj_set_size(btn_preview, 150, 45);
-    lv_obj_align(btn_preview, LV_ALIGN_TOP_RIGHT, -30, 260);
+    lv_obj_align(btn_preview, LV_ALIGN_TOP_RIGHT, -30, 255);
     lv_obj_add_event_cb(btn_preview, edit_preview_btn_cb, LV_EVENT_CLICKED, NULL);
     lv_obj_set_style_bg_color(btn_preview, lv_color_make(255, 152, 0), LV_PART_MAIN);  // Material Orange
     lv_obj_set_style_radius(btn_preview, 8, LV_PART_MAIN);
@@ -793,6 +891,19 @@ static void show_edit_scene_modal(int scene_index)
     lv_obj_set_style_text_color(preview_label, lv_color_make(255, 255, 255), LV_PART_MAIN);
     lv_obj_center(preview_label);
     
+    // Live switch (below Preview) - streams slider drags to the lights
+    lv_obj_t *live_label = lv_label_create(dialog);
+    lv_label_set_text(live_label, "Live");
+    lv_obj_set_style_text_font(live_label, &lv_font_montserrat_18, LV_PART_MAIN);
+    lv_obj_set_style_text_color(live_label, lv_color_make(97, 97, 97), LV_PART_MAIN);
+    lv_obj_align(live_label, LV_ALIGN_TOP_RIGHT, -110, 312);
+    
+    s_edit_state.live_switch = lv_switch_create(dialog);
+    lv_obj_set_size(s_edit_state.live_switch, 56, 28);
+    lv_obj_align(s_edit_state.live_switch, LV_ALIGN_TOP_RIGHT, -40, 310);
+    lv_obj_set_style_bg_color(s_edit_state.live_switch, lv_color_make(255, 152, 0), LV_PART_INDICATOR | LV_STATE_CHECKED);  // Material Orange
+    lv_obj_add_event_cb(s_edit_state.live_switch, edit_live_switch_cb, LV_EVENT_VALUE_CHANGED, NULL);
+    
     // Sliders container (left side)
     lv_obj_t *sliders_container = lv_obj_create(dialog);
     lv_obj_set_size(sliders_container, 480, 350);
@@ -803,16 +914,11 @@ static void show_edit_scene_modal(int scene_index)
     lv_obj_clear_flag(sliders_container, LV_OBJ_FLAG_SCROLLABLE);
     
     // Create sliders
-    create_edit_slider(sliders_container, "Bright", s_edit_state.brightness,
-                       &s_edit_state.slider_brightness, &s_edit_state.label_brightness, 5);
-    create_edit_slider(sliders_container, "Red", s_edit_state.red,
-                       &s_edit_state.slider_red, &s_edit_state.label_red, 55);
-    create_edit_slider(sliders_container, "Green", s_edit_state.green,
-                       &s_edit_state.slider_green, &s_edit_state.label_green, 105);
-    create_edit_slider(sliders_container, "Blue", s_edit_state.blue,
-                       &s_edit_state.slider_blue, &s_edit_state.label_blue, 155);
-    create_edit_slider(sliders_container, "White", s_edit_state.white,
-                       &s_edit_state.slider_white, &s_edit_state.label_white, 205);
+    create_edit_slider(sliders_container, &s_edit_state.slider_brightness, &s_edit_state.label_brightness, 5);
+    create_edit_slider(sliders_container, &s_edit_state.slider_red, &s_edit_state.label_red, 55);
+    create_edit_slider(sliders_container, &s_edit_state.slider_green, &s_edit_state.label_green, 105);
+    create_edit_slider(sliders_container, &s_edit_state.slider_blue, &s_edit_state.label_blue, 155);
+    create_edit_slider(sliders_container, &s_edit_state.slider_white, &s_edit_state.label_white, 205);
     
     // Button container
     lv_obj_t *btn_container = lv_obj_create(dialog);
@@ -850,12 +956,99 @@ static void show_edit_scene_modal(int scene_index)
     lv_obj_set_style_text_color(save_label, lv_color_make(255, 255, 255), LV_PART_MAIN);
     lv_obj_center(save_label);
     
-    // Create keyboard at bottom of modal (hidden initially)
+    // Create keyboard at bottom of modal (hidden until the name is tapped)
     s_edit_state.keyboard = lv_keyboard_create(s_edit_state.modal);
     lv_obj_set_size(s_edit_state.keyboard, 800, 200);
     lv_obj_align(s_edit_state.keyboard, LV_ALIGN_BOTTOM_MID, 0, 0);
     lv_keyboard_set_textarea(s_edit_state.keyboard, s_edit_state.name_textarea);
     lv_obj_add_flag(s_edit_state.keyboard, LV_OBJ_FLAG_HIDDEN);
+    
+    lv_obj_add_flag(s_edit_state.modal, LV_OBJ_FLAG_HIDDEN);
+}
+
+/**
+ * @brief Set a slider and its label without sending VALUE_CHANGED
+ */
+static void bind_edit_slider(lv_obj_t *slider, lv_obj_t *label, const char *name, uint8_t value)
+{
+    lv_slider_set_value(slider, value, LV_ANIM_OFF);
+    update_edit_slider_label(label, name, value);
+}
+
+/**
+ * @brief Show edit scene modal (FR-044)
+ * 
+ * The modal is built on first use and rebound to the scene on later opens.
+ */
+static void show_edit_scene_modal(int scene_index)
+{
+    int64_t open_start = esp_timer_get_time();
+    
+    ui_scene_t current;
+    if (scene_index < 0 || scene_storage_get_by_index(scene_index, &current) != ESP_OK) {
+        ESP_LOGE(TAG, "Invalid scene index for edit: %d", scene_index);
+        return;
+    }
+    
+    bool built = false;
+    if (s_edit_state.modal == NULL) {
+        create_edit_modal();
+        built = true;
+    }
+    
+    // Load current scene values
+    const ui_scene_t *scene = &current;
+    s_edit_state.scene_index = scene_index;
+    s_edit_state.brightness = scene->brightness;
+    s_edit_state.red = scene->red;
+    s_edit_state.green = scene->green;
+    s_edit_state.blue = scene->blue;
+    s_edit_state.white = scene->white;
+    
+    ESP_LOGI(TAG, "Opening edit modal for scene '%s' at index %d", scene->name, scene_index);
+    
+    // Bind the widgets to the scene
+    lv_textarea_set_text(s_edit_state.name_textarea, scene->name);
+    bind_edit_slider(s_edit_state.slider_brightness, s_edit_state.label_brightness, "Bright", scene->brightness);
+    bind_edit_slider(s_edit_state.slider_red, s_edit_state.label_red, "Red", scene->red);
+    bind_edit_slider(s_edit_state.slider_green, s_edit_state.label_green, "Green", scene->green);
+    bind_edit_slider(s_edit_state.slider_blue, s_edit_state.label_blue, "Blue", scene->blue);
+    bind_edit_slider(s_edit_state.slider_white, s_edit_state.label_white, "White", scene->white);
+    
+    if (scene_index == 0) {
+        lv_obj_add_state(s_edit_state.btn_move_left, LV_STATE_DISABLED);
+    } else {
+        lv_obj_clear_state(s_edit_state.btn_move_left, LV_STATE_DISABLED);
+    }
+    if (scene_index >= (int)scene_storage_get_count() - 1) {
+        lv_obj_add_state(s_edit_state.btn_move_right, LV_STATE_DISABLED);
+    } else {
+        lv_obj_clear_state(s_edit_state.btn_move_right, LV_STATE_DISABLED);
+    }
+    update_order_index_label();
+    update_edit_color_preview();
+    
+    // Live preview is opt-in per edit, so opening a scene never changes the lights
+    lv_obj_clear_state(s_edit_state.live_switch, LV_STATE_CHECKED);
+    
+    lv_obj_move_foreground(s_edit_state.modal);
+    lv_obj_clear_flag(s_edit_state.modal, LV_OBJ_FLAG_HIDDEN);
+    ui_perf_mark_open(built ? "Edit modal (built)" : "Edit modal", open_start);
+}
+
+/**
+ * @brief Get the scene index a card is currently bound to
+ * 
+ * @return Scene index, or -1 if the card is not bound
+ */
+static int get_card_index(lv_obj_t *card)
+{
+    for (size_t i = 0; i < s_card_pool_built; i++) {
+        if (s_card_pool[i].card == card) {
+            return s_card_pool[i].scene_index;
+        }
+    }
+    return -1;
 }
 
 /**
@@ -864,9 +1057,9 @@ static void show_edit_scene_modal(int scene_index)
 static void card_edit_btn_cb(lv_event_t *e)
 {
     lv_obj_t *btn = lv_event_get_target(e);
-    int scene_index = (int)(intptr_t)lv_obj_get_user_data(btn);
+    int scene_index = get_card_index(lv_obj_get_user_data(btn));
     
-    if (scene_index >= 0 && scene_index < (int)s_cached_scene_count) {
+    if (scene_index >= 0) {
         ESP_LOGI(TAG, "Edit button pressed for scene index %d", scene_index);
         show_edit_scene_modal(scene_index);
     }
@@ -878,10 +1071,11 @@ static void card_edit_btn_cb(lv_event_t *e)
 static void card_delete_btn_cb(lv_event_t *e)
 {
     lv_obj_t *btn = lv_event_get_target(e);
-    int scene_index = (int)(intptr_t)lv_obj_get_user_data(btn);
+    int scene_index = get_card_index(lv_obj_get_user_data(btn));
     
-    if (scene_index >= 0 && scene_index < (int)s_cached_scene_count) {
-        const char *scene_name = s_cached_scenes[scene_index].name;
+    ui_scene_t scene;
+    if (scene_index >= 0 && scene_storage_get_by_index(scene_index, &scene) == ESP_OK) {
+        const char *scene_name = scene.name;
         ESP_LOGI(TAG, "Delete button pressed for scene: %s (index %d)", scene_name, scene_index);
         show_delete_modal(scene_name);
     }
@@ -893,9 +1087,13 @@ static void card_delete_btn_cb(lv_event_t *e)
 static void card_click_cb(lv_event_t *e)
 {
     lv_obj_t *card = lv_event_get_target(e);
-    int index = (int)(intptr_t)lv_obj_get_user_data(card);
+    int index = get_card_index(card);
+    if (index < 0) {
+        return;
+    }
     
     s_scenes_state.current_scene_index = index;
+    warm_restart_save_scene(index);
     ESP_LOGI(TAG, "Scene card selected: %d", index);
     
     // Update visual selection
@@ -903,26 +1101,319 @@ static void card_click_cb(lv_event_t *e)
     
     // Scroll to center this card
     if (s_carousel) {
-        lv_coord_t scroll_x = index * (CARD_WIDTH + CARD_GAP);
+        lv_coord_t scroll_x = index * CARD_PITCH;
         lv_obj_scroll_to_x(s_carousel, scroll_x, LV_ANIM_ON);
     }
 }
 
+/**
+ * @brief Bind scene data to an existing card's circle, name and values
+ * 
+ * @param preview_color The scene's preview colour (ui_calculate_preview_color)
+ */
+static void update_scene_card(lv_obj_t *card, const ui_scene_t *scene, lv_color_t preview_color)
+{
+    lv_obj_t *color_circle = lv_obj_get_child(card, CARD_CHILD_COLOR_CIRCLE);
+    lv_obj_set_style_bg_color(color_circle, preview_color, LV_PART_MAIN);
+    
+    lv_label_set_text(lv_obj_get_child(card, CARD_CHILD_NAME_LABEL), scene->name);
+    
+    char values_buf[80];
+    snprintf(values_buf, sizeof(values_buf), "Brightness:%d\nR:%d G:%d B:%d W:%d",
+             scene->brightness, scene->red, scene->green, scene->blue, scene->white);
+    lv_label_set_text(lv_obj_get_child(card, CARD_CHILD_VALUES_LABEL), values_buf);
+}
+
+/**
+ * @brief Render a bound card into its snapshot buffer if the snapshot is stale
+ * 
+ * @return true if the slot has a valid snapshot
+ */
+static bool take_card_snapshot(size_t slot)
+{
+#if CONFIG_SCENE_CARD_SNAPSHOTS
+    lv_obj_t *card = s_card_pool[slot].card;
+    
+    if (!s_card_pool[slot].image || s_card_pool[slot].scene_index < 0) {
+        return false;
+    }
+    if (s_card_pool[slot].snapshot_valid) {
+        return true;
+    }
+    
+    // lv_snapshot skips hidden objects, so render with the card shown
+    bool hidden = lv_obj_has_flag(card, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_clear_flag(card, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_update_layout(card);
+    
+    uint32_t size = lv_snapshot_buf_size_needed(card, CARD_SNAPSHOT_CF);
+    if (s_card_pool[slot].snapshot_buf_size < size) {
+        // Card size is fixed, so this allocates once per slot
+        heap_caps_free((void *)s_card_pool[slot].snapshot.data);
+        s_card_pool[slot].snapshot.data = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        s_card_pool[slot].snapshot_buf_size = s_card_pool[slot].snapshot.data ? size : 0;
+    }
+    
+    lv_res_t res = LV_RES_INV;
+    if (s_card_pool[slot].snapshot.data) {
+        res = lv_snapshot_take_to_buf(card, CARD_SNAPSHOT_CF, &s_card_pool[slot].snapshot,
+                                      (void *)s_card_pool[slot].snapshot.data, size);
+    } else {
+        ESP_LOGW(TAG, "No PSRAM for %lu byte card snapshot", (unsigned long)size);
+    }
+    
+    if (hidden) {
+        lv_obj_add_flag(card, LV_OBJ_FLAG_HIDDEN);
+    }
+    lv_img_cache_invalidate_src(&s_card_pool[slot].snapshot);
+    s_card_pool[slot].snapshot_valid = (res == LV_RES_OK);
+    return s_card_pool[slot].snapshot_valid;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Show a card as its snapshot image or as live widgets
+ * 
+ * Falls back to the live card when no snapshot can be taken.
+ */
+static void show_card_snapshot(size_t slot, bool snapshot)
+{
+    lv_obj_t *card = s_card_pool[slot].card;
+    lv_obj_t *image = s_card_pool[slot].image;
+    int scene_index = s_card_pool[slot].scene_index;
+    
+    if (snapshot && take_card_snapshot(slot)) {
+        // Snapshot includes the card's extra draw area on each side
+        lv_coord_t ext = (s_card_pool[slot].snapshot.header.w - lv_obj_get_width(card)) / 2;
+        lv_img_set_src(image, &s_card_pool[slot].snapshot);
+        lv_obj_set_x(image, scene_index * CARD_PITCH - ext);
+        lv_obj_clear_flag(image, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_add_flag(card, LV_OBJ_FLAG_HIDDEN);
+        return;
+    }
+    
+    if (image) {
+        lv_obj_add_flag(image, LV_OBJ_FLAG_HIDDEN);
+    }
+    if (scene_index >= 0) {
+        lv_obj_clear_flag(card, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_add_flag(card, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+#if CONFIG_SCENE_CARD_SNAPSHOTS
+/**
+ * @brief Refresh one stale snapshot per tick while the carousel is idle
+ * 
+ * Keeps snapshots ready for the next scroll so scroll start does not have
+ * to render every card at once.
+ */
+static void snapshot_timer_cb(lv_timer_t *timer)
+{
+    if (s_carousel_scrolling) {
+        return;
+    }
+    
+    for (size_t i = 0; i < s_card_pool_built; i++) {
+        if (s_card_pool[i].image && s_card_pool[i].scene_index >= 0 && !s_card_pool[i].snapshot_valid) {
+            take_card_snapshot(i);
+            return;
+        }
+    }
+    
+    // All snapshots current: sleep until a card is rebound or changed
+    lv_timer_pause(timer);
+}
+#endif
+
+/**
+ * @brief Bind a pooled card to a scene, or unbind and hide it
+ * 
+ * @param scene Scene data, or NULL to unbind
+ * @param preview_color The scene's preview colour (ignored when unbinding)
+ */
+static void bind_card(size_t slot, int scene_index, const ui_scene_t *scene, lv_color_t preview_color)
+{
+    lv_obj_t *card = s_card_pool[slot].card;
+    
+    invalidate_card_snapshot(slot);
+    
+    if (scene == NULL) {
+        s_card_pool[slot].scene_index = -1;
+        show_card_snapshot(slot, false);
+        return;
+    }
+    
+    s_card_pool[slot].scene_index = scene_index;
+    update_scene_card(card, scene, preview_color);
+    lv_obj_set_x(card, scene_index * CARD_PITCH);
+    if (scene_index == s_scenes_state.current_scene_index) {
+        lv_obj_add_state(card, LV_STATE_CHECKED);
+    } else {
+        lv_obj_clear_state(card, LV_STATE_CHECKED);
+    }
+    
+    // Cards that scroll into view mid-scroll are rendered once and then blitted
+    show_card_snapshot(slot, s_carousel_scrolling);
+}
+
+/**
+ * @brief Bind the card pool to the scenes around the current scroll position
+ * 
+ * Cards whose scene is still inside the window keep their binding; only the
+ * cards that fell out of it are rebound to the scenes that came into view.
+ * 
+ * @param force Rebind every card (scene data or order changed)
+ */
+static void update_card_window(bool force)
+{
+    int count = (int)s_scene_card_count;
+    int center = (lv_obj_get_scroll_x(s_carousel) + CARD_WIDTH / 2) / CARD_PITCH;
+    int pool = (int)s_card_pool_built;
+    int first = center - pool / 2;
+    if (first > count - pool) first = count - pool;
+    if (first < 0) first = 0;
+    
+    if (!force && first == s_window_first) {
+        return;
+    }
+    s_window_first = first;
+    
+    // Mark which scenes in the window already have a card
+    bool covered[CARD_POOL_SIZE] = {0};
+    bool free_slot[CARD_POOL_SIZE] = {0};
+    for (size_t i = 0; i < s_card_pool_built; i++) {
+        int index = s_card_pool[i].scene_index;
+        if (!force && index >= first && index < first + pool && index < count) {
+            covered[index - first] = true;
+        } else {
+            free_slot[i] = true;
+        }
+    }
+    
+    // Hand the free cards to the uncovered scenes
+    size_t bind_slot[CARD_POOL_SIZE];
+    int bind_index[CARD_POOL_SIZE];
+    ui_scene_t bind_scene[CARD_POOL_SIZE];
+    size_t binds = 0;
+    int next = 0;
+    for (size_t i = 0; i < s_card_pool_built; i++) {
+        if (!free_slot[i]) {
+            continue;
+        }
+        while (next < pool && (covered[next] || first + next >= count)) {
+            next++;
+        }
+        if (next < pool && scene_storage_get_by_index(first + next, &bind_scene[binds]) == ESP_OK) {
+            bind_slot[binds] = i;
+            bind_index[binds] = first + next;
+            binds++;
+            covered[next] = true;
+        } else {
+            bind_card(i, -1, NULL, lv_color_black());  // Hide the rest
+        }
+    }
+    
+    // Colour every rebound card in one pass, then bind them
+    lv_color_t bind_color[CARD_POOL_SIZE];
+    ui_calculate_preview_colors(bind_scene, bind_color, binds);
+    for (size_t n = 0; n < binds; n++) {
+        bind_card(bind_slot[n], bind_index[n], &bind_scene[n], bind_color[n]);
+    }
+}
+
+/**
+ * @brief Carousel scroll begin handler - swap cards for their snapshots
+ * 
+ * While scrolling each card is drawn as one pre-rendered image instead of
+ * its widget tree (border, radius, labels, swatch and buttons).
+ */
+static void carousel_scroll_begin_cb(lv_event_t *e)
+{
+    int64_t now = esp_timer_get_time();
+    s_scroll_timing.start_us = now;
+    s_scroll_timing.busy_start_us = ui_get_lvgl_busy_us();
+    s_scroll_timing.last_us = now;
+    s_scroll_timing.worst_us = 0;
+    s_scroll_timing.frames = 0;
+    
+    if (s_carousel_scrolling) {
+        return;
+    }
+    s_carousel_scrolling = true;
+    
+    for (size_t i = 0; i < s_card_pool_built; i++) {
+        if (s_card_pool[i].scene_index >= 0) {
+            show_card_snapshot(i, true);
+        }
+    }
+}
+
+/**
+ * @brief Carousel scroll handler - keep the card pool under the viewport
+ */
+static void carousel_scroll_cb(lv_event_t *e)
+{
+    int64_t now = esp_timer_get_time();
+    int64_t frame_us = now - s_scroll_timing.last_us;
+    if (frame_us > s_scroll_timing.worst_us) {
+        s_scroll_timing.worst_us = frame_us;
+    }
+    s_scroll_timing.last_us = now;
+    s_scroll_timing.frames++;
+    
+    update_card_window(false);
+}
+
+/**
+ * @brief Swap snapshots back to live cards and log the scroll's frame times
+ */
+static void end_card_scroll(void)
+{
+    if (!s_carousel_scrolling) {
+        return;
+    }
+    s_carousel_scrolling = false;
+    
+    for (size_t i = 0; i < s_card_pool_built; i++) {
+        show_card_snapshot(i, false);
+    }
+    
+    if (s_scroll_timing.frames > 0) {
+        int64_t total_us = s_scroll_timing.last_us - s_scroll_timing.start_us;
+        int64_t busy_us = ui_get_lvgl_busy_us() - s_scroll_timing.busy_start_us;
+        int64_t wall_us = esp_timer_get_time() - s_scroll_timing.start_us;
+        ESP_LOGI(TAG, "Carousel scroll: %lu frames in %lld ms, avg %lld.%lld ms, worst %lld.%lld ms, "
+                 "CPU1 LVGL busy %lld%% (snapshots %s)",
+                 (unsigned long)s_scroll_timing.frames, total_us / 1000,
+                 total_us / s_scroll_timing.frames / 1000, (total_us / s_scroll_timing.frames / 100) % 10,
+                 s_scroll_timing.worst_us / 1000, (s_scroll_timing.worst_us / 100) % 10,
+                 wall_us > 0 ? busy_us * 100 / wall_us : 0,
+                 s_card_pool[0].image ? "on" : "off");
+    }
+}
+
 /**
  * @brief Carousel scroll end handler - update selected scene based on centered card
  */
 static void carousel_scroll_end_cb(lv_event_t *e)
 {
-    if (!s_carousel || s_cached_scene_count == 0) return;
+    end_card_scroll();
+    
+    if (!s_carousel || s_scene_card_count == 0) return;
     
     lv_coord_t scroll_x = lv_obj_get_scroll_x(s_carousel);
-    int card_index = (scroll_x + CARD_WIDTH / 2) / (CARD_WIDTH + CARD_GAP);
+    int card_index = (scroll_x + CARD_WIDTH / 2) / CARD_PITCH;
     
     if (card_index < 0) card_index = 0;
-    if (card_index >= (int)s_cached_scene_count) card_index = s_cached_scene_count - 1;
+    if (card_index >= (int)s_scene_card_count) card_index = s_scene_card_count - 1;
     
     if (card_index != s_scenes_state.current_scene_index) {
         s_scenes_state.current_scene_index = card_index;
+        warm_restart_save_scene(card_index);
         ESP_LOGI(TAG, "Carousel scroll ended, selected scene: %d", card_index);
     }
     
@@ -931,93 +1422,309 @@ static void carousel_scroll_end_cb(lv_event_t *e)
 }
 
 /**
- * @brief Create a scene card
+ * @brief Initialize the styles shared by every card
+ * 
+ * Cards only carry local styles for what differs per scene (x position and
+ * the preview circle colour), so rebinding a card does not allocate.
  */
-static lv_obj_t* create_scene_card(lv_obj_t *parent, const ui_scene_t *scene, int index)
+static void init_card_styles(void)
 {
+    if (s_card_styles.initialized) {
+        return;
+    }
+    
     // Card container (no shadows for smooth scroll performance)
+    lv_style_init(&s_card_styles.card);
+    lv_style_set_width(&s_card_styles.card, CARD_WIDTH);
+    lv_style_set_height(&s_card_styles.card, CARD_HEIGHT);
+    lv_style_set_align(&s_card_styles.card, LV_ALIGN_LEFT_MID);
+    lv_style_set_bg_color(&s_card_styles.card, lv_color_make(255, 255, 255));
+    lv_style_set_radius(&s_card_styles.card, 16);
+    lv_style_set_border_width(&s_card_styles.card, 2);
+    lv_style_set_border_color(&s_card_styles.card, lv_color_make(224, 224, 224));  // Light gray
+    lv_style_set_pad_all(&s_card_styles.card, 15);
+    
+    // Selected card: Material Blue border, thicker (applied in LV_STATE_CHECKED)
+    lv_style_init(&s_card_styles.card_selected);
+    lv_style_set_border_width(&s_card_styles.card_selected, 4);
+    lv_style_set_border_color(&s_card_styles.card_selected, lv_color_make(33, 150, 243));
+    
+    // Round edit/delete buttons in the top corners
+    lv_style_init(&s_card_styles.btn_edit);
+    lv_style_set_width(&s_card_styles.btn_edit, 36);
+    lv_style_set_height(&s_card_styles.btn_edit, 36);
+    lv_style_set_radius(&s_card_styles.btn_edit, LV_RADIUS_CIRCLE);
+    lv_style_set_bg_color(&s_card_styles.btn_edit, lv_color_make(33, 150, 243));  // Material Blue
+    lv_style_set_align(&s_card_styles.btn_edit, LV_ALIGN_TOP_LEFT);
+    lv_style_set_x(&s_card_styles.btn_edit, -5);
+    lv_style_set_y(&s_card_styles.btn_edit, -5);
+    
+    lv_style_init(&s_card_styles.btn_delete);
+    lv_style_set_width(&s_card_styles.btn_delete, 36);
+    lv_style_set_height(&s_card_styles.btn_delete, 36);
+    lv_style_set_radius(&s_card_styles.btn_delete, LV_RADIUS_CIRCLE);
+    lv_style_set_bg_color(&s_card_styles.btn_delete, lv_color_make(244, 67, 54));  // Material Red
+    lv_style_set_align(&s_card_styles.btn_delete, LV_ALIGN_TOP_RIGHT);
+    lv_style_set_x(&s_card_styles.btn_delete, 5);
+    lv_style_set_y(&s_card_styles.btn_delete, -5);
+    
+    lv_style_init(&s_card_styles.btn_icon);
+    lv_style_set_text_font(&s_card_styles.btn_icon, &lv_font_montserrat_16);
+    lv_style_set_text_color(&s_card_styles.btn_icon, lv_color_make(255, 255, 255));
+    lv_style_set_align(&s_card_styles.btn_icon, LV_ALIGN_CENTER);
+    
+    // Color preview circle (shows approximate light color)
+    lv_style_init(&s_card_styles.color_circle);
+    lv_style_set_width(&s_card_styles.color_circle, 80);
+    lv_style_set_height(&s_card_styles.color_circle, 80);
+    lv_style_set_radius(&s_card_styles.color_circle, LV_RADIUS_CIRCLE);
+    lv_style_set_align(&s_card_styles.color_circle, LV_ALIGN_TOP_MID);
+    lv_style_set_y(&s_card_styles.color_circle, 40);
+    
+    // Scene name (below color circle)
+    lv_style_init(&s_card_styles.name_label);
+    lv_style_set_text_font(&s_card_styles.name_label, &lv_font_montserrat_24);
+    lv_style_set_text_color(&s_card_styles.name_label, lv_color_make(33, 33, 33));
+    lv_style_set_text_align(&s_card_styles.name_label, LV_TEXT_ALIGN_CENTER);
+    lv_style_set_width(&s_card_styles.name_label, CARD_WIDTH - 50);
+    lv_style_set_align(&s_card_styles.name_label, LV_ALIGN_TOP_MID);
+    lv_style_set_y(&s_card_styles.name_label, 140);
+    
+    // RGBW values (smaller font)
+    lv_style_init(&s_card_styles.values_label);
+    lv_style_set_text_font(&s_card_styles.values_label, &lv_font_montserrat_16);
+    lv_style_set_text_color(&s_card_styles.values_label, lv_color_make(117, 117, 117));
+    lv_style_set_text_align(&s_card_styles.values_label, LV_TEXT_ALIGN_CENTER);
+    lv_style_set_align(&s_card_styles.values_label, LV_ALIGN_BOTTOM_MID);
+    lv_style_set_y(&s_card_styles.values_label, -5);
+    
+    s_card_styles.initialized = true;
+}
+
+/**
+ * @brief Create an unbound pooled card
+ * 
+ * Children are created in CARD_CHILD_* order so update_scene_card() can
+ * rebind them in place. The buttons store the card itself as user data;
+ * the card's scene is looked up on click since cards are rebound as the
+ * carousel scrolls.
+ */
+static lv_obj_t* create_scene_card(lv_obj_t *parent)
+{
     lv_obj_t *card = lv_obj_create(parent);
-    lv_obj_set_size(card, CARD_WIDTH, CARD_HEIGHT);
-    lv_obj_set_style_bg_color(card, lv_color_make(255, 255, 255), LV_PART_MAIN);
-    lv_obj_set_style_radius(card, 16, LV_PART_MAIN);
-    lv_obj_set_style_border_width(card, 2, LV_PART_MAIN);
-    lv_obj_set_style_border_color(card, lv_color_make(224, 224, 224), LV_PART_MAIN);
-    lv_obj_set_style_pad_all(card, 15, LV_PART_MAIN);
+    lv_obj_add_style(card, &s_card_styles.card, LV_PART_MAIN);
+    lv_obj_add_style(card, &s_card_styles.card_selected, LV_PART_MAIN | LV_STATE_CHECKED);
     lv_obj_clear_flag(card, LV_OBJ_FLAG_SCROLLABLE);
-    
-    // Store scene index for selection
-    lv_obj_set_user_data(card, (void*)(intptr_t)index);
+    lv_obj_add_flag(card, LV_OBJ_FLAG_HIDDEN);
     lv_obj_add_event_cb(card, card_click_cb, LV_EVENT_CLICKED, NULL);
     
     // Edit button (top-left corner)
     lv_obj_t *btn_edit = lv_btn_create(card);
-    lv_obj_set_size(btn_edit, 36, 36);
-    lv_obj_align(btn_edit, LV_ALIGN_TOP_LEFT, -5, -5);
-    lv_obj_set_style_bg_color(btn_edit, lv_color_make(33, 150, 243), LV_PART_MAIN);  // Material Blue
-    lv_obj_set_style_radius(btn_edit, LV_RADIUS_CIRCLE, LV_PART_MAIN);
-    
-    // Store scene index in edit button for callback
-    lv_obj_set_user_data(btn_edit, (void*)(intptr_t)index);
+    lv_obj_add_style(btn_edit, &s_card_styles.btn_edit, LV_PART_MAIN);
+    lv_obj_set_user_data(btn_edit, card);
     lv_obj_add_event_cb(btn_edit, card_edit_btn_cb, LV_EVENT_CLICKED, NULL);
     
     lv_obj_t *edit_icon = lv_label_create(btn_edit);
-    lv_label_set_text(edit_icon, LV_SYMBOL_EDIT);
-    lv_obj_set_style_text_font(edit_icon, &lv_font_montserrat_16, LV_PART_MAIN);
-    lv_obj_set_style_text_color(edit_icon, lv_color_make(255, 255, 255), LV_PART_MAIN);
-    lv_obj_center(edit_icon);
+    lv_label_set_text_static(edit_icon, LV_SYMBOL_EDIT);
+    lv_obj_add_style(edit_icon, &s_card_styles.btn_icon, LV_PART_MAIN);
     
     // Delete button (top-right corner)
     lv_obj_t *btn_delete = lv_btn_create(card);
-    lv_obj_set_size(btn_delete, 36, 36);
-    lv_obj_align(btn_delete, LV_ALIGN_TOP_RIGHT, 5, -5);
-    lv_obj_set_style_bg_color(btn_delete, lv_color_make(244, 67, 54), LV_PART_MAIN);  // Material Red
-    lv_obj_set_style_radius(btn_delete, LV_RADIUS_CIRCLE, LV_PART_MAIN);
-    
-    // Store scene index in delete button for callback (same as card)
-    lv_obj_set_user_data(btn_delete, (void*)(intptr_t)index);
+    lv_obj_add_style(btn_delete, &s_card_styles.btn_delete, LV_PART_MAIN);
+    lv_obj_set_user_data(btn_delete, card);
     lv_obj_add_event_cb(btn_delete, card_delete_btn_cb, LV_EVENT_CLICKED, NULL);
     
     lv_obj_t *trash_icon = lv_label_create(btn_delete);
-    lv_label_set_text(trash_icon, LV_SYMBOL_TRASH);
-    lv_obj_set_style_text_font(trash_icon, &lv_font_montserrat_16, LV_PART_MAIN);
-    lv_obj_set_style_text_color(trash_icon, lv_color_make(255, 255, 255), LV_PART_MAIN);
-    lv_obj_center(trash_icon);
+    lv_label_set_text_static(trash_icon, LV_SYMBOL_TRASH);
+    lv_obj_add_style(trash_icon, &s_card_styles.btn_icon, LV_PART_MAIN);
     
-    // Color preview circle (shows approximate light color)
     lv_obj_t *color_circle = lv_obj_create(card);
-    lv_obj_set_size(color_circle, 80, 80);
-    lv_obj_align(color_circle, LV_ALIGN_TOP_MID, 0, 40);
-    lv_obj_set_style_radius(color_circle, LV_RADIUS_CIRCLE, LV_PART_MAIN);
-    lv_color_t preview_color = ui_calculate_preview_color(
-        scene->brightness, scene->red, scene->green, scene->blue, scene->white);
-    lv_obj_set_style_bg_color(color_circle, preview_color, LV_PART_MAIN);
+    lv_obj_add_style(color_circle, &s_card_styles.color_circle, LV_PART_MAIN);
     lv_obj_clear_flag(color_circle, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_CLICKABLE);
     
-    // Scene name (below color circle)
     lv_obj_t *name_label = lv_label_create(card);
-    lv_label_set_text(name_label, scene->name);
-    lv_obj_set_style_text_font(name_label, &lv_font_montserrat_24, LV_PART_MAIN);
-    lv_obj_set_style_text_color(name_label, lv_color_make(33, 33, 33), LV_PART_MAIN);
-    lv_obj_set_style_text_align(name_label, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
-    lv_obj_set_width(name_label, CARD_WIDTH - 50);
+    lv_obj_add_style(name_label, &s_card_styles.name_label, LV_PART_MAIN);
     lv_label_set_long_mode(name_label, LV_LABEL_LONG_WRAP);
-    lv_obj_align(name_label, LV_ALIGN_TOP_MID, 0, 140);
-    
-    // RGBW values (smaller font)
-    char values_buf[80];
-    snprintf(values_buf, sizeof(values_buf), "Brightness:%d\nR:%d G:%d B:%d W:%d",
-             scene->brightness, scene->red, scene->green, scene->blue, scene->white);
     
     lv_obj_t *values_label = lv_label_create(card);
-    lv_label_set_text(values_label, values_buf);
-    lv_obj_set_style_text_font(values_label, &lv_font_montserrat_16, LV_PART_MAIN);
-    lv_obj_set_style_text_color(values_label, lv_color_make(117, 117, 117), LV_PART_MAIN);
-    lv_obj_set_style_text_align(values_label, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
-    lv_obj_align(values_label, LV_ALIGN_BOTTOM_MID, 0, -5);
+    lv_obj_add_style(values_label, &s_card_styles.values_label, LV_PART_MAIN);
     
     return card;
 }
 
+/**
+ * @brief Show or hide the "No scenes" placeholder
+ */
+static void set_no_scenes_label_visible(bool visible)
+{
+    if (visible && !s_label_no_scenes) {
+        s_label_no_scenes = lv_label_create(s_carousel);
+        lv_label_set_text(s_label_no_scenes, "No scenes\n\nSave a scene from Manual Control");
+        lv_obj_set_style_text_font(s_label_no_scenes, &lv_font_montserrat_28, LV_PART_MAIN);
+        lv_obj_set_style_text_color(s_label_no_scenes, lv_color_make(158, 158, 158), LV_PART_MAIN);
+        lv_obj_set_style_text_align(s_label_no_scenes, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
+        lv_obj_center(s_label_no_scenes);
+    } else if (!visible && s_label_no_scenes) {
+        lv_obj_del(s_label_no_scenes);
+        s_label_no_scenes = NULL;
+    }
+}
+
+/**
+ * @brief Resize the carousel's scroll extent to the current scene count
+ * 
+ * Only pooled cards exist, so an invisible spacer spanning every scene
+ * position keeps the scroll range (and snap positions) correct.
+ */
+static void update_carousel_extent(void)
+{
+    s_scene_card_count = scene_storage_get_count();
+    lv_coord_t width = s_scene_card_count > 0 ? (lv_coord_t)(s_scene_card_count * CARD_PITCH - CARD_GAP) : 0;
+    lv_obj_set_width(s_carousel_spacer, width);
+    set_no_scenes_label_visible(s_scene_card_count == 0);
+}
+
+/**
+ * @brief Select a card and scroll it to the center of the carousel
+ */
+static void select_card(int index, lv_anim_enable_t anim)
+{
+    if (s_scene_card_count == 0) {
+        s_scenes_state.current_scene_index = 0;
+        warm_restart_save_scene(0);
+        update_card_window(true);
+        return;
+    }
+    
+    if (index < 0) index = 0;
+    if (index >= (int)s_scene_card_count) index = s_scene_card_count - 1;
+    
+    s_scenes_state.current_scene_index = index;
+    warm_restart_save_scene(index);
+    
+    // Scroll extent changes after insert/remove, so settle layout first
+    lv_obj_update_layout(s_carousel);
+    lv_obj_scroll_to_x(s_carousel, index * CARD_PITCH, anim);
+    update_card_window(true);
+    update_card_selection(index);
+}
+
+/**
+ * @brief Rebind the card pool from the scene store
+ * 
+ * Cost is bounded by CARD_POOL_SIZE regardless of the number of scenes.
+ */
+static void rebuild_scene_cards(void)
+{
+    update_carousel_extent();
+    
+    // Reset to first scene and update selection visual
+    select_card(0, LV_ANIM_OFF);
+    
+    ESP_LOGI(TAG, "Bound %d scenes to %d pooled cards", s_scene_card_count, (int)s_card_pool_built);
+}
+
+/**
+ * @brief Scene store observer - keeps the selection on the same scene and
+ *        rebinds the card pool
+ * 
+ * Only the cards under the viewport exist, so every change costs at most
+ * CARD_POOL_SIZE rebinds. Scene mutations come from LVGL event callbacks,
+ * so this runs with the LVGL mutex already held.
+ */
+static void scene_store_observer(const scene_change_t *change, void *user_ctx)
+{
+    if (!s_carousel) {
+        return;
+    }
+    
+    int selected = s_scenes_state.current_scene_index;
+    int index = (int)change->index;
+    int from = (int)change->from_index;
+    bool was_empty = (s_scene_card_count == 0);
+    
+    switch (change->type) {
+        case SCENE_CHANGE_ADDED:
+            if (was_empty) {
+                selected = index;
+            } else if (index <= selected) {
+                selected++;
+            }
+            break;
+        
+        case SCENE_CHANGE_REMOVED:
+            // A removed selection moves to the card that took its place
+            if (index < selected) {
+                selected--;
+            }
+            break;
+        
+        case SCENE_CHANGE_MOVED:
+            if (selected == from) {
+                selected = index;
+            } else if (from < selected && selected <= index) {
+                selected--;
+            } else if (index <= selected && selected < from) {
+                selected++;
+            }
+            break;
+        
+        case SCENE_CHANGE_UPDATED:
+            // Order unchanged, selection unaffected - rebind that card if bound
+            for (size_t i = 0; i < s_card_pool_built; i++) {
+                if (s_card_pool[i].scene_index == index) {
+                    const ui_scene_t *scene = &change->scene;
+                    update_scene_card(s_card_pool[i].card, scene,
+                                      ui_calculate_preview_color(scene->brightness, scene->red,
+                                                                 scene->green, scene->blue, scene->white));
+                    invalidate_card_snapshot(i);
+                }
+            }
+            return;
+        
+        case SCENE_CHANGE_RELOADED:
+        default:
+            rebuild_scene_cards();
+            return;
+    }
+    
+    update_carousel_extent();
+    select_card(selected, LV_ANIM_ON);
+}
+
+/**
+ * @brief Create the next card of the pool (unbound)
+ */
+static void create_pool_card(void)
+{
+    size_t i = s_card_pool_built;
+    s_card_pool[i].card = create_scene_card(s_carousel);
+    s_card_pool[i].scene_index = -1;
+#if CONFIG_SCENE_CARD_SNAPSHOTS
+    // Snapshot stand-in; snappable so scroll snapping still finds it
+    s_card_pool[i].image = lv_img_create(s_carousel);
+    lv_obj_align(s_card_pool[i].image, LV_ALIGN_LEFT_MID, 0, 0);
+    lv_obj_add_flag(s_card_pool[i].image, LV_OBJ_FLAG_HIDDEN);
+#endif
+    s_card_pool_built++;
+}
+
+bool ui_scenes_build_step(void)
+{
+    if (!s_carousel || s_card_pool_built >= CARD_POOL_SIZE) {
+        return false;
+    }
+    
+    create_pool_card();
+    
+    // Widen the window: bound cards keep their scenes, the new card takes
+    // the scene that came into the window
+    s_window_first = -1;
+    update_card_window(false);
+    update_card_selection(s_scenes_state.current_scene_index);
+    return true;
+}
+
 /**
  * @brief Create the scene selector tab content (FR-040)
  */
@@ -1026,11 +1733,11 @@ void ui_create_scenes_tab(lv_obj_t *parent)
     ESP_LOGI(TAG, "Creating scene selector tab");
 
     // Calculate padding to center cards: (carousel_width - card_width) / 2
-    lv_coord_t center_pad = (760 - CARD_WIDTH) / 2;
+    lv_coord_t center_pad = (CAROUSEL_WIDTH - CARD_WIDTH) / 2;
 
     // Create horizontal scrolling carousel container (FR-040)
     s_carousel = lv_obj_create(parent);
-    lv_obj_set_size(s_carousel, 760, CAROUSEL_HEIGHT);
+    lv_obj_set_size(s_carousel, CAROUSEL_WIDTH, CAROUSEL_HEIGHT);
     lv_obj_align(s_carousel, LV_ALIGN_TOP_MID, 0, 5);
     lv_obj_set_style_bg_opa(s_carousel, LV_OPA_TRANSP, LV_PART_MAIN);
     lv_obj_set_style_border_width(s_carousel, 0, LV_PART_MAIN);
@@ -1045,20 +1752,36 @@ void ui_create_scenes_tab(lv_obj_t *parent)
     lv_obj_set_scroll_snap_x(s_carousel, LV_SCROLL_SNAP_CENTER);
     lv_obj_set_scrollbar_mode(s_carousel, LV_SCROLLBAR_MODE_OFF);
     
-    // Flex layout for cards
-    lv_obj_set_flex_flow(s_carousel, LV_FLEX_FLOW_ROW);
-    lv_obj_set_flex_align(s_carousel, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-    lv_obj_set_style_pad_column(s_carousel, CARD_GAP, LV_PART_MAIN);
+    // Cards are placed at index * CARD_PITCH; an empty spacer spans all
+    // scene positions so the scroll range covers cards that don't exist yet
+    s_carousel_spacer = lv_obj_create(s_carousel);
+    lv_obj_remove_style_all(s_carousel_spacer);
+    lv_obj_set_size(s_carousel_spacer, 0, 1);
+    lv_obj_align(s_carousel_spacer, LV_ALIGN_LEFT_MID, 0, 0);
+    lv_obj_clear_flag(s_carousel_spacer, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SNAPPABLE | LV_OBJ_FLAG_SCROLLABLE);
+    
+    // Fixed card pool, rebound to scenes as the carousel scrolls. Only the
+    // cards under the viewport are created now; ui_scenes_build_step()
+    // adds the margin cards once the first frame is up.
+    init_card_styles();
+    for (size_t i = 0; i < CARD_POOL_INITIAL; i++) {
+        create_pool_card();
+    }
+    s_window_first = -1;
+    
+#if CONFIG_SCENE_CARD_SNAPSHOTS
+    s_snapshot_timer = lv_timer_create(snapshot_timer_cb, CARD_SNAPSHOT_IDLE_MS, NULL);
+#endif
+    
+    lv_obj_add_event_cb(s_carousel, carousel_scroll_begin_cb, LV_EVENT_SCROLL_BEGIN, NULL);
+    lv_obj_add_event_cb(s_carousel, carousel_scroll_cb, LV_EVENT_SCROLL, NULL);
     
     // Add scroll end event to update selected scene
     lv_obj_add_event_cb(s_carousel, carousel_scroll_end_cb, LV_EVENT_SCROLL_END, NULL);
 
-    // Placeholder "No scenes" label (will be replaced when scenes are loaded)
-    s_label_no_scenes = lv_label_create(s_carousel);
-    lv_label_set_text(s_label_no_scenes, "No scenes\n\nSave a scene from Manual Control");
-    lv_obj_set_style_text_font(s_label_no_scenes, &lv_font_montserrat_28, LV_PART_MAIN);
-    lv_obj_set_style_text_color(s_label_no_scenes, lv_color_make(158, 158, 158), LV_PART_MAIN);
-    lv_obj_set_style_text_align(s_label_no_scenes, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
+    // Populate cards from the scene store and follow its changes from here on
+    rebuild_scene_cards();
+    scene_storage_add_observer(scene_store_observer, NULL);
 
     // Create transition duration slider (FR-041)
     // Position below carousel with proper spacing
@@ -1116,61 +1839,15 @@ void ui_create_scenes_tab(lv_obj_t *parent)
     lv_obj_set_style_shadow_opa(s_btn_apply, LV_OPA_30, LV_PART_MAIN);
     lv_obj_set_style_radius(s_btn_apply, 8, LV_PART_MAIN);
 
-    // Create persistent timer for progress bar updates (runs every 100ms)
-    // This timer handles both internal and external fade tracking
+    // Create persistent timer for progress bar updates (every 100ms while a
+    // fade is tracked). It handles both internal and external fade tracking
+    // and starts paused, so an idle screen has no timer waking LVGL
     s_progress_timer = lv_timer_create(progress_timer_cb, 100, NULL);
+    lv_timer_pause(s_progress_timer);
 
     ESP_LOGI(TAG, "Scene selector tab created");
 }
 
-/**
- * @brief Load scenes from SD card and populate the carousel (FR-040)
- * 
- * @param scenes Array of scene structs
- * @param count Number of scenes
- */
-void ui_scenes_load_from_sd(const ui_scene_t *scenes, size_t count)
-{
-    if (!s_carousel) {
-        ESP_LOGE(TAG, "Carousel not initialized");
-        return;
-    }
-
-    // Clear card array
-    memset(s_scene_cards, 0, sizeof(s_scene_cards));
-
-    // Cache scenes for later access
-    s_cached_scene_count = (count > SCENE_STORAGE_MAX_SCENES) ? SCENE_STORAGE_MAX_SCENES : count;
-    if (scenes && count > 0) {
-        memcpy(s_cached_scenes, scenes, s_cached_scene_count * sizeof(ui_scene_t));
-    }
-
-    // Clear existing carousel content
-    lv_obj_clean(s_carousel);
-
-    if (count == 0) {
-        // Show "no scenes" message
-        s_label_no_scenes = lv_label_create(s_carousel);
-        lv_label_set_text(s_label_no_scenes, "No scenes\n\nSave a scene from Manual Control");
-        lv_obj_set_style_text_font(s_label_no_scenes, &lv_font_montserrat_28, LV_PART_MAIN);
-        lv_obj_set_style_text_color(s_label_no_scenes, lv_color_make(158, 158, 158), LV_PART_MAIN);
-        lv_obj_set_style_text_align(s_label_no_scenes, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
-        s_scenes_state.current_scene_index = 0;
-    } else {
-        // Create cards for each scene and store in array
-        // (Carousel uses left/right padding to center first/last cards)
-        for (size_t i = 0; i < count; i++) {
-            s_scene_cards[i] = create_scene_card(s_carousel, &scenes[i], i);
-        }
-        
-        // Reset to first scene and update selection visual
-        s_scenes_state.current_scene_index = 0;
-        update_card_selection(0);
-        
-        ESP_LOGI(TAG, "Loaded %d scene cards", count);
-    }
-}
-
 /**
  * @brief Update transition progress bar (FR-043)
  * 
@@ -1187,11 +1864,17 @@ void ui_scenes_update_progress(uint8_t percent)
         lv_obj_clear_flag(s_progress_bar, LV_OBJ_FLAG_HIDDEN);
         lv_bar_set_value(s_progress_bar, percent, LV_ANIM_OFF);
         s_scenes_state.transition_in_progress = true;
+        if (s_progress_timer) {
+            lv_timer_resume(s_progress_timer);
+        }
     } else {
         // Hide progress bar when complete or not started
         lv_obj_add_flag(s_progress_bar, LV_OBJ_FLAG_HIDDEN);
         lv_bar_set_value(s_progress_bar, 0, LV_ANIM_OFF);
         s_scenes_state.transition_in_progress = false;
+        if (s_progress_timer) {
+            lv_timer_pause(s_progress_timer);
+        }
     }
 }
 
@@ -1203,6 +1886,16 @@ int ui_scenes_get_selected_index(void)
     return s_scenes_state.current_scene_index;
 }
 
+/**
+ * @brief Select a scene and centre its card without animation
+ */
+void ui_scenes_select(int index)
+{
+    if (s_carousel) {
+        select_card(index, LV_ANIM_OFF);
+    }
+}
+
 /**
  * @brief Get current transition duration
  */
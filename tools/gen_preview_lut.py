@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+"""
+Generate main/ui/ui_preview_lut.h, the lookup tables behind the RGBW
+preview colour (ui_preview.c).
+
+    python3 tools/gen_preview_lut.py > main/ui/ui_preview_lut.h
+
+Uncalibrated tables reproduce the original arithmetic exactly:
+    intensity = isqrt(brightness * 255)
+    channel   = c + (255 - c) * w / 320
+
+The calibration matrix maps linear LED drive (R, G, B, W) to linear sRGB
+primaries. The defaults are nominal WS2814 values (625/525/465 nm emitters,
+4000 K white); replace CAL_MATRIX with measurements of the installed strip
+and regenerate.
+"""
+
+import math
+
+WHITE_BLEND_DIV = 320   # w = 255 blends at most 80% towards white
+WHITE_BLEND_SHIFT = 20  # Q20 keeps (255 - c) * lut[w] >> 20 exact
+CAL_SHIFT = 12          # Matrix and linear values in Q12
+SRGB_LUT_SIZE = 4096
+
+# Columns: R, G, B, W emitter at full drive. Rows: linear sRGB R, G, B.
+CAL_MATRIX = [
+    [1.00, 0.00, 0.02, 1.00],
+    [0.05, 1.00, 0.00, 0.88],
+    [0.00, 0.12, 1.00, 0.72],
+]
+
+
+def srgb_encode(linear):
+    if linear <= 0.0031308:
+        return 12.92 * linear
+    return 1.055 * linear ** (1 / 2.4) - 0.055
+
+
+def table(name, ctype, values, per_line, width):
+    lines = [f"static const {ctype} {name}[{len(values)}] = {{"]
+    for i in range(0, len(values), per_line):
+        chunk = values[i:i + per_line]
+        lines.append("    " + ", ".join(f"{v:{width}d}" for v in chunk) + ",")
+    lines.append("};")
+    return "\n".join(lines)
+
+
+def main():
+    intensity = [math.isqrt(b * 255) for b in range(256)]
+    white_blend = [-(-(w << WHITE_BLEND_SHIFT) // WHITE_BLEND_DIV) for w in range(256)]
+    srgb = [min(255, round(srgb_encode(i / (SRGB_LUT_SIZE - 1)) * 255)) for i in range(SRGB_LUT_SIZE)]
+    matrix = [[round(v * (1 << CAL_SHIFT)) for v in row] for row in CAL_MATRIX]
+
+    out = []
+    out.append("/**")
+    out.append(" * @file ui_preview_lut.h")
+    out.append(" * @brief Preview colour lookup tables")
+    out.append(" * ")
+    out.append(" * Generated by tools/gen_preview_lut.py - do not edit. Included only by")
+    out.append(" * ui_preview.c.")
+    out.append(" */")
+    out.append("")
+    out.append("#pragma once")
+    out.append("")
+    out.append("#include <stdint.h>")
+    out.append("")
+    out.append(f"#define PREVIEW_WHITE_BLEND_SHIFT   {WHITE_BLEND_SHIFT}")
+    out.append(f"#define PREVIEW_CAL_SHIFT           {CAL_SHIFT}")
+    out.append(f"#define PREVIEW_SRGB_LUT_SIZE       {SRGB_LUT_SIZE}")
+    out.append("")
+    out.append("/// Brightness to display intensity: isqrt(brightness * 255)")
+    out.append(table("s_preview_intensity_lut", "uint8_t", intensity, 16, 3))
+    out.append("")
+    out.append(f"/// White level to blend factor towards white, Q{WHITE_BLEND_SHIFT} (w / {WHITE_BLEND_DIV}, rounded up)")
+    out.append(table("s_preview_white_blend_lut", "uint32_t", white_blend, 8, 6))
+    out.append("")
+    out.append(f"/// Linear light (Q{CAL_SHIFT}) to 8-bit sRGB")
+    out.append(table("s_preview_srgb_lut", "uint8_t", srgb, 16, 3))
+    out.append("")
+    out.append(f"/// LED drive (R, G, B, W) to linear sRGB, Q{CAL_SHIFT}")
+    out.append(f"static const int16_t s_preview_cal_matrix[3][4] = {{")
+    for row in matrix:
+        out.append("    { " + ", ".join(f"{v:4d}" for v in row) + " },")
+    out.append("};")
+    print("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
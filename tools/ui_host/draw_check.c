@@ -0,0 +1,468 @@
+/**
+ * @file draw_check.c
+ * @brief Host check of the draw context against LVGL's own rendering
+ * 
+ * Builds ui_draw.c with CONFIG_UI_DRAW_PIE and supplies the two kernels of
+ * ui_draw_pie.S as a model of their lane operations (8 x 16-bit lanes,
+ * EE.VMUL.U16 keeping the low 16 bits of the product >> SAR, saturating
+ * EE.VADDS.S16). Then:
+ * 
+ * 1. Blends every RGB565 value with the model, in both byte orders, at
+ *    every opacity for a set of colours, and compares with LVGL's
+ *    lv_color_mix_premult().
+ * 2. Renders the same test screen on displays using LVGL's draw context
+ *    and ui_draw_ctx_init(), with full-screen and 40-line draw buffers,
+ *    changes part of it and renders again, and compares the framebuffers
+ *    pixel for pixel.
+ * 
+ * Exits with status 1 on the first difference.
+ * 
+ *   cmake --build build-host --target draw_check
+ */
+
+#include "ui_host.h"
+#include "ui_common.h"
+#include "esp_log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+esp_log_level_t ui_host_log_level = ESP_LOG_WARN;
+
+#define LANES           8
+#define PARTIAL_LINES   40
+
+uint32_t ui_host_tick_get(void)
+{
+    return 0;
+}
+
+// ----- Kernel model -----
+
+/// One PIE q register
+typedef struct {
+    uint16_t h[LANES];
+} vec_t;
+
+/// Xtensa SAR, set by SSAI
+static unsigned s_sar;
+
+static vec_t vbcast(uint16_t v)
+{
+    vec_t r;
+    for (int i = 0; i < LANES; i++) {
+        r.h[i] = v;
+    }
+    return r;
+}
+
+static vec_t vand(vec_t a, vec_t b)
+{
+    for (int i = 0; i < LANES; i++) {
+        a.h[i] &= b.h[i];
+    }
+    return a;
+}
+
+static vec_t vor(vec_t a, vec_t b)
+{
+    for (int i = 0; i < LANES; i++) {
+        a.h[i] |= b.h[i];
+    }
+    return a;
+}
+
+/// EE.VMUL.U16: (a * b) >> SAR, low 16 bits
+static vec_t vmul_u16(vec_t a, vec_t b)
+{
+    for (int i = 0; i < LANES; i++) {
+        a.h[i] = (uint16_t)(((uint32_t)a.h[i] * b.h[i]) >> s_sar);
+    }
+    return a;
+}
+
+/// EE.VADDS.S16: signed saturating add
+static vec_t vadds_s16(vec_t a, vec_t b)
+{
+    for (int i = 0; i < LANES; i++) {
+        int32_t sum = (int16_t)a.h[i] + (int16_t)b.h[i];
+        if (sum > INT16_MAX) {
+            sum = INT16_MAX;
+        } else if (sum < INT16_MIN) {
+            sum = INT16_MIN;
+        }
+        a.h[i] = (uint16_t)sum;
+    }
+    return a;
+}
+
+/**
+ * @brief Loop body of ui_draw_blend_rgb565_pie, CONFIG_LV_COLOR_16_SWAP path
+ */
+static vec_t blend_swapped(vec_t q0, const ui_draw_blend_params_t *p)
+{
+    vec_t q7 = vbcast(p->opa_inv);
+    vec_t q6 = vbcast(0x8081);
+    vec_t q5 = vbcast(1);
+    vec_t q1, q2, q3, q4;
+    
+    q1 = vbcast(0x1F00);
+    q2 = vand(q0, q1);
+    s_sar = 8;
+    q2 = vmul_u16(q2, q7);
+    q2 = vadds_s16(q2, vbcast(p->fg_b));
+    s_sar = 15;
+    q2 = vmul_u16(q2, q6);
+    q4 = vand(q2, q1);
+    
+    q1 = vbcast(0x00F8);
+    q2 = vand(q0, q1);
+    s_sar = 3;
+    q2 = vmul_u16(q2, q7);
+    q2 = vadds_s16(q2, vbcast(p->fg_r));
+    s_sar = 20;
+    q2 = vmul_u16(q2, q6);
+    q2 = vand(q2, q1);
+    q4 = vor(q4, q2);
+    
+    q2 = vand(q0, vbcast(0x0007));
+    q3 = vbcast(p->opa_inv_x8);
+    s_sar = 0;
+    q2 = vmul_u16(q2, q3);
+    q3 = vand(q0, vbcast(0xE000));
+    s_sar = 13;
+    q3 = vmul_u16(q3, q7);
+    q2 = vadds_s16(q2, q3);
+    q2 = vadds_s16(q2, vbcast(p->fg_g));
+    s_sar = 23;
+    q2 = vmul_u16(q2, q6);
+    s_sar = 3;
+    q3 = vmul_u16(q2, q5);
+    q4 = vor(q4, q3);
+    s_sar = 0;
+    q3 = vmul_u16(q2, vbcast(0x2000));
+    return vor(q4, q3);
+}
+
+/**
+ * @brief Loop body of ui_draw_blend_rgb565_pie, native byte order path
+ */
+static vec_t blend_native(vec_t q0, const ui_draw_blend_params_t *p)
+{
+    vec_t q7 = vbcast(p->opa_inv);
+    vec_t q6 = vbcast(0x8081);
+    vec_t q1, q2, q4;
+    
+    q1 = vbcast(0xF800);
+    q2 = vand(q0, q1);
+    s_sar = 11;
+    q2 = vmul_u16(q2, q7);
+    q2 = vadds_s16(q2, vbcast(p->fg_r));
+    s_sar = 12;
+    q2 = vmul_u16(q2, q6);
+    q4 = vand(q2, q1);
+    
+    q1 = vbcast(0x07E0);
+    q2 = vand(q0, q1);
+    s_sar = 5;
+    q2 = vmul_u16(q2, q7);
+    q2 = vadds_s16(q2, vbcast(p->fg_g));
+    s_sar = 18;
+    q2 = vmul_u16(q2, q6);
+    q2 = vand(q2, q1);
+    q4 = vor(q4, q2);
+    
+    q2 = vand(q0, vbcast(0x001F));
+    s_sar = 0;
+    q2 = vmul_u16(q2, q7);
+    q2 = vadds_s16(q2, vbcast(p->fg_b));
+    s_sar = 23;
+    q2 = vmul_u16(q2, q6);
+    return vor(q4, q2);
+}
+
+void ui_draw_fill_rgb565_pie(uint16_t *dst, size_t vectors, uint32_t color)
+{
+    if ((uintptr_t)dst % 16 != 0) {
+        fprintf(stderr, "FAIL fill kernel called with unaligned dst %p\n", (void *)dst);
+        exit(1);
+    }
+    for (size_t i = 0; i < vectors * LANES; i++) {
+        dst[i] = (uint16_t)color;
+    }
+}
+
+void ui_draw_blend_rgb565_pie(uint16_t *dst, size_t vectors, const ui_draw_blend_params_t *params)
+{
+    if ((uintptr_t)dst % 16 != 0) {
+        fprintf(stderr, "FAIL blend kernel called with unaligned dst %p\n", (void *)dst);
+        exit(1);
+    }
+    for (size_t v = 0; v < vectors; v++) {
+        vec_t q0;
+        memcpy(q0.h, dst + v * LANES, sizeof(q0.h));
+#if LV_COLOR_16_SWAP
+        vec_t out = blend_swapped(q0, params);
+#else
+        vec_t out = blend_native(q0, params);
+#endif
+        memcpy(dst + v * LANES, out.h, sizeof(out.h));
+    }
+}
+
+static uint16_t bswap16(uint16_t v)
+{
+    return (uint16_t)((v << 8) | (v >> 8));
+}
+
+/**
+ * @brief Model against lv_color_mix_premult() for every pixel and opacity
+ */
+static bool check_kernel_model(void)
+{
+    static const uint32_t colors[] = { 0xFFFFFF, 0x000000, 0x2AC07F, 0xFF5500, 0x0055FF, 0x808080 };
+    
+    for (size_t c = 0; c < sizeof(colors) / sizeof(colors[0]); c++) {
+        lv_color_t color = lv_color_hex(colors[c]);
+        for (int opa = 0; opa <= 255; opa++) {
+            uint16_t premult[3];
+            lv_color_premult(color, (lv_opa_t)opa, premult);
+            ui_draw_blend_params_t p = {
+                .opa_inv = (uint16_t)(255 - opa),
+                .opa_inv_x8 = (uint16_t)((255 - opa) * 8),
+                .fg_r = (uint16_t)(premult[0] + LV_COLOR_MIX_ROUND_OFS),
+                .fg_g = (uint16_t)(premult[1] + LV_COLOR_MIX_ROUND_OFS),
+                .fg_b = (uint16_t)(premult[2] + LV_COLOR_MIX_ROUND_OFS),
+            };
+            
+            for (uint32_t px = 0; px < 65536; px += LANES) {
+                vec_t in;
+                for (int lane = 0; lane < LANES; lane++) {
+                    in.h[lane] = (uint16_t)(px + lane);
+                }
+                vec_t swapped = blend_swapped(in, &p);
+                vec_t native = blend_native(in, &p);
+                
+                for (int lane = 0; lane < LANES; lane++) {
+                    // LVGL is built for one byte order; the other is the
+                    // same sum on byte-swapped pixels
+                    lv_color_t bg = { .full = in.h[lane] };
+                    lv_color_t bg_other = { .full = bswap16(in.h[lane]) };
+                    uint16_t want = lv_color_mix_premult(premult, bg, (lv_opa_t)(255 - opa)).full;
+                    uint16_t want_other =
+                        bswap16(lv_color_mix_premult(premult, bg_other, (lv_opa_t)(255 - opa)).full);
+#if LV_COLOR_16_SWAP
+                    uint16_t want_swapped = want;
+                    uint16_t want_native = want_other;
+#else
+                    uint16_t want_swapped = want_other;
+                    uint16_t want_native = want;
+#endif
+                    if (swapped.h[lane] != want_swapped || native.h[lane] != want_native) {
+                        printf("FAIL colour 0x%06x opa %d over 0x%04x: swapped 0x%04x (want 0x%04x), "
+                               "native 0x%04x (want 0x%04x)\n",
+                               (unsigned)colors[c], opa, in.h[lane], swapped.h[lane], want_swapped,
+                               native.h[lane], want_native);
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+    
+    printf("Blend kernel model matches lv_color_mix_premult(): %u colours x 256 opacities x 65536 pixels\n",
+           (unsigned)(sizeof(colors) / sizeof(colors[0])));
+    return true;
+}
+
+// ----- Rendering -----
+
+typedef struct {
+    lv_disp_t *disp;
+    lv_color_t *fb;
+    lv_obj_t *changing[3];
+    const char *name;
+} test_disp_t;
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
+{
+    lv_color_t *fb = drv->user_data;
+    lv_coord_t w = lv_area_get_width(area);
+    for (lv_coord_t y = area->y1; y <= area->y2; y++) {
+        memcpy(&fb[y * UI_HOST_HOR_RES + area->x1], color_map, w * sizeof(lv_color_t));
+        color_map += w;
+    }
+    lv_disp_flush_ready(drv);
+}
+
+static void test_disp_init(test_disp_t *t, const char *name, uint16_t lines, bool ui_draw)
+{
+    static lv_disp_draw_buf_t draw_bufs[4];
+    static lv_disp_drv_t drvs[4];
+    static int n;
+    
+    size_t px = (size_t)UI_HOST_HOR_RES * lines;
+    lv_color_t *buf = malloc(px * sizeof(lv_color_t));
+    t->fb = calloc((size_t)UI_HOST_HOR_RES * UI_HOST_VER_RES, sizeof(lv_color_t));
+    t->name = name;
+    lv_disp_draw_buf_init(&draw_bufs[n], buf, NULL, px);
+    
+    lv_disp_drv_t *drv = &drvs[n++];
+    lv_disp_drv_init(drv);
+    drv->hor_res = UI_HOST_HOR_RES;
+    drv->ver_res = UI_HOST_VER_RES;
+    drv->flush_cb = flush_cb;
+    drv->draw_buf = &draw_bufs[n - 1];
+    drv->user_data = t->fb;
+    if (ui_draw) {
+        drv->draw_ctx_init = ui_draw_ctx_init;
+        drv->draw_ctx_size = sizeof(lv_draw_sw_ctx_t);
+    }
+    t->disp = lv_disp_drv_register(drv);
+}
+
+/// Deterministic pseudo-random numbers, the same sequence for every display
+static uint32_t s_rand;
+
+static uint32_t next_rand(void)
+{
+    s_rand = s_rand * 1664525u + 1013904223u;
+    return s_rand >> 8;
+}
+
+static lv_obj_t *add_rect(lv_obj_t *parent, lv_coord_t x, lv_coord_t y, lv_coord_t w, lv_coord_t h,
+                          uint32_t color, lv_opa_t opa)
+{
+    lv_obj_t *obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_pos(obj, x, y);
+    lv_obj_set_size(obj, w, h);
+    lv_obj_set_style_bg_color(obj, lv_color_hex(color), 0);
+    lv_obj_set_style_bg_opa(obj, opa, 0);
+    return obj;
+}
+
+/**
+ * @brief The test screen: solid and translucent fills at awkward offsets
+ * and widths, over black and over colour, plus the masked and image paths
+ * LVGL keeps (rounded cards, borders, shadows, text, widgets)
+ */
+static void build_scene(test_disp_t *t)
+{
+    s_rand = 12345;
+    lv_obj_t *scr = lv_disp_get_scr_act(t->disp);
+    lv_obj_set_style_bg_color(scr, lv_color_black(), 0);
+    lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, 0);
+    
+    // Translucent fills over black: the leading-black rule of fill_normal()
+    add_rect(scr, 0, 0, 400, 60, 0x3366CC, LV_OPA_50);
+    add_rect(scr, 13, 70, 77, 40, 0xFFFFFF, 1);
+    add_rect(scr, 7, 120, 300, 50, 0xFF0000, 254);
+    
+    // Coloured background, then fills at every alignment and many widths
+    add_rect(scr, 400, 0, 400, 480, 0x20B0A0, LV_OPA_COVER);
+    add_rect(scr, 0, 180, 400, 300, 0x707070, LV_OPA_COVER);
+    for (int i = 0; i < 120; i++) {
+        lv_coord_t x = (lv_coord_t)(next_rand() % 760);
+        lv_coord_t y = (lv_coord_t)(next_rand() % 460);
+        lv_coord_t w = (lv_coord_t)(1 + next_rand() % 200);
+        lv_coord_t h = (lv_coord_t)(1 + next_rand() % 60);
+        uint32_t color = next_rand() & 0xFFFFFF;
+        lv_opa_t opa = (i % 3 == 0) ? LV_OPA_COVER : (lv_opa_t)(1 + next_rand() % 254);
+        add_rect(scr, x, y, w, h, color, opa);
+    }
+    
+    // Overlapping translucent layers
+    for (int i = 0; i < 8; i++) {
+        add_rect(scr, (lv_coord_t)(420 + i * 9), (lv_coord_t)(300 + i * 7), 250, 120,
+                 0x101010u * (uint32_t)(i + 3), (lv_opa_t)(30 + i * 25));
+    }
+    
+    // Scene-card-like widgets: rounded, bordered, shadowed, with text
+    for (int i = 0; i < 3; i++) {
+        lv_obj_t *card = lv_obj_create(scr);
+        lv_obj_set_pos(card, (lv_coord_t)(30 + i * 250), 200);
+        lv_obj_set_size(card, 220, 200);
+        lv_obj_set_style_radius(card, 16, 0);
+        lv_obj_set_style_border_width(card, 3, 0);
+        lv_obj_set_style_shadow_width(card, 12, 0);
+        lv_obj_set_style_bg_opa(card, (lv_opa_t)(LV_OPA_COVER - i * 80), 0);
+        lv_obj_t *label = lv_label_create(card);
+        lv_label_set_text(label, "Scene card");
+        lv_obj_center(label);
+    }
+    lv_obj_t *slider = lv_slider_create(scr);
+    lv_obj_set_pos(slider, 450, 40);
+    lv_obj_set_width(slider, 300);
+    lv_slider_set_value(slider, 40, LV_ANIM_OFF);
+    lv_obj_t *btn = lv_btn_create(scr);
+    lv_obj_set_pos(btn, 450, 100);
+    lv_obj_set_size(btn, 151, 50);
+    
+    // Objects changed between the two renders (small invalidated areas)
+    t->changing[0] = add_rect(scr, 101, 201, 37, 23, 0xFFCC00, LV_OPA_70);
+    t->changing[1] = add_rect(scr, 555, 333, 99, 17, 0x00FF00, LV_OPA_COVER);
+    t->changing[2] = add_rect(scr, 3, 5, 45, 9, 0x0000FF, LV_OPA_20);
+}
+
+static void change_scene(test_disp_t *t)
+{
+    lv_obj_set_pos(t->changing[0], 129, 215);
+    lv_obj_set_style_bg_opa(t->changing[1], LV_OPA_40, 0);
+    lv_obj_set_size(t->changing[2], 333, 41);
+}
+
+static bool compare(const test_disp_t *a, const test_disp_t *b, const char *pass)
+{
+    for (size_t i = 0; i < (size_t)UI_HOST_HOR_RES * UI_HOST_VER_RES; i++) {
+        if (a->fb[i].full != b->fb[i].full) {
+            printf("FAIL %s: %s 0x%04x vs %s 0x%04x at (%u, %u)\n", pass, a->name, a->fb[i].full,
+                   b->name, b->fb[i].full, (unsigned)(i % UI_HOST_HOR_RES), (unsigned)(i / UI_HOST_HOR_RES));
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool check_rendering(void)
+{
+    test_disp_t disps[4];
+    test_disp_init(&disps[0], "LVGL full", UI_HOST_VER_RES, false);
+    test_disp_init(&disps[1], "ui_draw full", UI_HOST_VER_RES, true);
+    test_disp_init(&disps[2], "LVGL 40-line", PARTIAL_LINES, false);
+    test_disp_init(&disps[3], "ui_draw 40-line", PARTIAL_LINES, true);
+    
+    for (int i = 0; i < 4; i++) {
+        build_scene(&disps[i]);
+        lv_refr_now(disps[i].disp);
+    }
+    if (!compare(&disps[0], &disps[1], "first frame") || !compare(&disps[2], &disps[3], "first frame")) {
+        return false;
+    }
+    
+    for (int i = 0; i < 4; i++) {
+        change_scene(&disps[i]);
+        lv_refr_now(disps[i].disp);
+    }
+    if (!compare(&disps[0], &disps[1], "update") || !compare(&disps[2], &disps[3], "update")) {
+        return false;
+    }
+    
+    ui_draw_stats_t stats;
+    ui_draw_get_stats(&stats);
+    printf("Draw context matches LVGL (full and %d-line buffers, two frames): "
+           "%llu px filled, %llu px blended by the kernels, %llu px by LVGL\n",
+           PARTIAL_LINES, (unsigned long long)stats.fill_px, (unsigned long long)stats.blend_px,
+           (unsigned long long)stats.lvgl_px);
+    return true;
+}
+
+int main(void)
+{
+    lv_init();
+    
+    if (!check_kernel_model() || !check_rendering()) {
+        return 1;
+    }
+    return 0;
+}
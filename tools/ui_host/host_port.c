@@ -0,0 +1,374 @@
+/**
+ * @file host_port.c
+ * @brief Host stand-ins for the ESP-IDF and app modules used by the UI
+ * 
+ * Provides just enough of esp_timer, esp_err, the LVGL task lock, the
+ * scene store and the fade controller for the UI sources to run without
+ * hardware. The scene store is kept in memory and notifies observers the
+ * same way scene_storage.c does, so carousel updates after an edit or
+ * delete go through the firmware's code paths.
+ */
+
+#include "ui_host.h"
+#include "ui_common.h"
+#include "../../main/app/scene_storage.h"
+#include "../../main/app/fade_controller.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+static const char *TAG = "host_port";
+
+esp_log_level_t ui_host_log_level = ESP_LOG_WARN;
+
+// ----- ESP-IDF -----
+
+const char *esp_err_to_name(esp_err_t code)
+{
+    switch (code) {
+    case ESP_OK:                return "ESP_OK";
+    case ESP_FAIL:              return "ESP_FAIL";
+    case ESP_ERR_NO_MEM:        return "ESP_ERR_NO_MEM";
+    case ESP_ERR_INVALID_ARG:   return "ESP_ERR_INVALID_ARG";
+    case ESP_ERR_INVALID_STATE: return "ESP_ERR_INVALID_STATE";
+    case ESP_ERR_INVALID_SIZE:  return "ESP_ERR_INVALID_SIZE";
+    case ESP_ERR_NOT_FOUND:     return "ESP_ERR_NOT_FOUND";
+    case ESP_ERR_TIMEOUT:       return "ESP_ERR_TIMEOUT";
+    default:                    return "UNKNOWN ERROR";
+    }
+}
+
+int64_t esp_timer_get_time(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+// ----- ui_common.c -----
+
+// The runner calls LVGL from a single thread, so the lock is a no-op
+bool ui_lock(void)
+{
+    return true;
+}
+
+void ui_unlock(void)
+{
+}
+
+bool ui_post(ui_cmd_fn_t fn, void *arg)
+{
+    // Single-threaded: the caller is already in LVGL context
+    fn(arg);
+    return true;
+}
+
+int64_t ui_get_lvgl_busy_us(void)
+{
+    return ui_host_busy_us();
+}
+
+void ui_perf_mark_open(const char *name, int64_t start_us)
+{
+}
+
+void ui_perf_attach_toggle_gesture(lv_obj_t *obj)
+{
+    // The runner reports its own frame statistics
+    (void)obj;
+}
+
+// ----- Scene store -----
+
+static ui_scene_t s_scenes[SCENE_STORAGE_MAX_SCENES];
+static size_t s_scene_count = 0;
+
+static struct {
+    scene_storage_observer_t cb;
+    void *user_ctx;
+} s_observers[SCENE_STORAGE_MAX_OBSERVERS];
+
+static void notify_observers(scene_change_type_t type, size_t index, size_t from_index,
+                             const ui_scene_t *scene)
+{
+    scene_change_t change = {
+        .type = type,
+        .index = index,
+        .from_index = from_index,
+        .count = s_scene_count,
+    };
+    if (scene) {
+        change.scene = *scene;
+    }
+    
+    for (size_t i = 0; i < SCENE_STORAGE_MAX_OBSERVERS; i++) {
+        if (s_observers[i].cb) {
+            s_observers[i].cb(&change, s_observers[i].user_ctx);
+        }
+    }
+}
+
+static int find_scene(const char *name)
+{
+    for (size_t i = 0; i < s_scene_count; i++) {
+        if (strcmp(s_scenes[i].name, name) == 0) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+static void set_scene(ui_scene_t *scene, const char *name, uint8_t brightness,
+                      uint8_t red, uint8_t green, uint8_t blue, uint8_t white)
+{
+    strncpy(scene->name, name, sizeof(scene->name) - 1);
+    scene->name[sizeof(scene->name) - 1] = '\0';
+    scene->brightness = brightness;
+    scene->red = red;
+    scene->green = green;
+    scene->blue = blue;
+    scene->white = white;
+}
+
+void ui_host_seed_scenes(size_t count)
+{
+    static const char *names[] = {
+        "Sunrise", "Morning", "Daylight", "Overcast", "Afternoon", "Golden Hour",
+        "Sunset", "Dusk", "Evening", "Moonlight", "Night", "Storm",
+    };
+    const size_t name_count = sizeof(names) / sizeof(names[0]);
+    
+    if (count > SCENE_STORAGE_MAX_SCENES) {
+        count = SCENE_STORAGE_MAX_SCENES;
+    }
+    
+    for (size_t i = 0; i < count; i++) {
+        char name[32];
+        if (i < name_count) {
+            snprintf(name, sizeof(name), "%s", names[i]);
+        } else {
+            snprintf(name, sizeof(name), "%s %d", names[i % name_count], (int)(i / name_count) + 1);
+        }
+        // Spread the colours so every card preview differs
+        set_scene(&s_scenes[i], name, (uint8_t)(80 + (i * 37) % 176),
+                  (uint8_t)((i * 97) % 256), (uint8_t)((i * 53 + 64) % 256),
+                  (uint8_t)((i * 29 + 128) % 256), (uint8_t)((i * 71) % 256));
+    }
+    s_scene_count = count;
+    notify_observers(SCENE_CHANGE_RELOADED, 0, 0, NULL);
+}
+
+esp_err_t scene_storage_init(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t scene_storage_add_observer(scene_storage_observer_t observer, void *user_ctx)
+{
+    for (size_t i = 0; i < SCENE_STORAGE_MAX_OBSERVERS; i++) {
+        if (!s_observers[i].cb) {
+            s_observers[i].cb = observer;
+            s_observers[i].user_ctx = user_ctx;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NO_MEM;
+}
+
+void scene_storage_remove_observer(scene_storage_observer_t observer)
+{
+    for (size_t i = 0; i < SCENE_STORAGE_MAX_OBSERVERS; i++) {
+        if (s_observers[i].cb == observer) {
+            s_observers[i].cb = NULL;
+            s_observers[i].user_ctx = NULL;
+        }
+    }
+}
+
+esp_err_t scene_storage_save(const char *name, uint8_t brightness,
+                             uint8_t red, uint8_t green, uint8_t blue, uint8_t white)
+{
+    if (!name || strlen(name) == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    int existing_idx = find_scene(name);
+    scene_change_type_t type = SCENE_CHANGE_UPDATED;
+    size_t index;
+    
+    if (existing_idx >= 0) {
+        index = existing_idx;
+    } else {
+        if (s_scene_count >= SCENE_STORAGE_MAX_SCENES) {
+            return ESP_ERR_NO_MEM;
+        }
+        type = SCENE_CHANGE_ADDED;
+        index = s_scene_count++;
+    }
+    
+    set_scene(&s_scenes[index], name, brightness, red, green, blue, white);
+    notify_observers(type, index, index, &s_scenes[index]);
+    return ESP_OK;
+}
+
+esp_err_t scene_storage_delete(const char *name)
+{
+    if (!name || strlen(name) == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    int found_idx = find_scene(name);
+    if (found_idx < 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    
+    ui_scene_t removed = s_scenes[found_idx];
+    memmove(&s_scenes[found_idx], &s_scenes[found_idx + 1],
+            (s_scene_count - found_idx - 1) * sizeof(ui_scene_t));
+    s_scene_count--;
+    
+    notify_observers(SCENE_CHANGE_REMOVED, found_idx, found_idx, &removed);
+    return ESP_OK;
+}
+
+size_t scene_storage_get_count(void)
+{
+    return s_scene_count;
+}
+
+esp_err_t scene_storage_get_first(ui_scene_t *scene)
+{
+    return scene_storage_get_by_index(0, scene);
+}
+
+esp_err_t scene_storage_update(size_t index, const char *new_name,
+                               uint8_t brightness, uint8_t red, uint8_t green,
+                               uint8_t blue, uint8_t white)
+{
+    if (index >= s_scene_count || !new_name || strlen(new_name) == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    int existing_idx = find_scene(new_name);
+    if (existing_idx >= 0 && (size_t)existing_idx != index) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    set_scene(&s_scenes[index], new_name, brightness, red, green, blue, white);
+    notify_observers(SCENE_CHANGE_UPDATED, index, index, &s_scenes[index]);
+    return ESP_OK;
+}
+
+esp_err_t scene_storage_reorder(size_t from_index, size_t to_index)
+{
+    if (from_index >= s_scene_count || to_index >= s_scene_count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (from_index == to_index) {
+        return ESP_OK;
+    }
+    
+    ui_scene_t moved = s_scenes[from_index];
+    if (from_index < to_index) {
+        memmove(&s_scenes[from_index], &s_scenes[from_index + 1],
+                (to_index - from_index) * sizeof(ui_scene_t));
+    } else {
+        memmove(&s_scenes[to_index + 1], &s_scenes[to_index],
+                (from_index - to_index) * sizeof(ui_scene_t));
+    }
+    s_scenes[to_index] = moved;
+    
+    notify_observers(SCENE_CHANGE_MOVED, to_index, from_index, &moved);
+    return ESP_OK;
+}
+
+esp_err_t scene_storage_get_by_index(size_t index, ui_scene_t *scene)
+{
+    if (!scene || index >= s_scene_count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *scene = s_scenes[index];
+    return ESP_OK;
+}
+
+// ----- Fade controller -----
+
+// Fades run on the simulated tick so the progress bar animates in traces
+static struct {
+    bool active;
+    uint32_t start_tick;
+    uint32_t duration_ms;
+    lighting_state_t target;
+} s_fade;
+
+esp_err_t fade_controller_init(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t fade_controller_start(const fade_params_t *params)
+{
+    if (!params) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    ESP_LOGI(TAG, "Fade to B=%d R=%d G=%d B=%d W=%d over %u ms",
+             params->target.brightness, params->target.red, params->target.green,
+             params->target.blue, params->target.white, (unsigned)params->duration_ms);
+    s_fade.target = params->target;
+    s_fade.duration_ms = params->duration_ms;
+    s_fade.start_tick = ui_host_tick_get();
+    s_fade.active = params->duration_ms > 0;
+    return ESP_OK;
+}
+
+esp_err_t fade_controller_apply_immediate(const lighting_state_t *state)
+{
+    if (!state) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    s_fade.target = *state;
+    s_fade.active = false;
+    return ESP_OK;
+}
+
+esp_err_t fade_controller_live_update(const lighting_state_t *state)
+{
+    return fade_controller_apply_immediate(state);
+}
+
+esp_err_t fade_controller_live_commit(const lighting_state_t *state)
+{
+    return fade_controller_apply_immediate(state);
+}
+
+fade_state_t fade_controller_get_progress(fade_progress_t *progress)
+{
+    uint32_t elapsed = 0;
+    fade_state_t state = FADE_STATE_IDLE;
+    
+    if (s_fade.active) {
+        elapsed = ui_host_tick_get() - s_fade.start_tick;
+        if (elapsed >= s_fade.duration_ms) {
+            // Reported once, like the real controller's COMPLETE tick
+            s_fade.active = false;
+            elapsed = s_fade.duration_ms;
+            state = FADE_STATE_COMPLETE;
+        } else {
+            state = FADE_STATE_FADING;
+        }
+    }
+    
+    if (progress) {
+        progress->state = state;
+        progress->elapsed_ms = elapsed;
+        progress->total_ms = s_fade.duration_ms;
+        progress->progress_percent = s_fade.duration_ms > 0 ?
+            (uint8_t)((uint64_t)elapsed * 100 / s_fade.duration_ms) : 0;
+        progress->current = s_fade.target;
+    }
+    return state;
+}
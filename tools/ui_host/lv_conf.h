@@ -0,0 +1,58 @@
+/**
+ * @file lv_conf.h
+ * @brief LVGL configuration for the headless host build of the UI
+ * 
+ * Mirrors the firmware's LVGL settings (sdkconfig.defaults and the tuning
+ * table in docs/ARCHITECTURE.md) so frame timings and object counts track
+ * the device. Options not listed here use the LVGL defaults, as they do
+ * in the firmware build.
+ */
+
+#ifndef LV_CONF_H
+#define LV_CONF_H
+
+#include <stdint.h>
+
+/* Color settings (same as the panel) */
+#define LV_COLOR_DEPTH 16
+#define LV_COLOR_16_SWAP 1
+
+/* Memory settings: stdlib malloc, as CONFIG_LV_MEM_CUSTOM on the device */
+#define LV_MEM_CUSTOM 1
+#define LV_MEMCPY_MEMSET_STD 1
+
+/* Display settings */
+#define LV_DISP_DEF_REFR_PERIOD 10
+
+/* Input device settings */
+#define LV_INDEV_DEF_READ_PERIOD 10
+#define LV_INDEV_DEF_SCROLL_THROW 5
+#define LV_INDEV_DEF_SCROLL_LIMIT 30
+
+/* Simulated clock driven by the replay runner */
+#define LV_TICK_CUSTOM 1
+#define LV_TICK_CUSTOM_INCLUDE "ui_host.h"
+#define LV_TICK_CUSTOM_SYS_TIME_EXPR (ui_host_tick_get())
+
+/* Logging */
+#define LV_USE_LOG 1
+#define LV_LOG_LEVEL LV_LOG_LEVEL_WARN
+#define LV_LOG_PRINTF 1
+
+/* Font settings */
+#define LV_FONT_MONTSERRAT_12 1
+#define LV_FONT_MONTSERRAT_14 1
+#define LV_FONT_MONTSERRAT_16 1
+#define LV_FONT_MONTSERRAT_18 1
+#define LV_FONT_MONTSERRAT_20 1
+#define LV_FONT_MONTSERRAT_24 1
+#define LV_FONT_MONTSERRAT_28 1
+#define LV_FONT_MONTSERRAT_32 1
+
+/* Other settings */
+#define LV_USE_ASSERT_NULL 1
+#define LV_USE_ASSERT_MALLOC 1
+#define LV_USE_USER_DATA 1
+#define LV_USE_SNAPSHOT 1
+
+#endif /* LV_CONF_H */
@@ -0,0 +1,141 @@
+/**
+ * @file png_writer.c
+ * @brief Minimal PNG writer for framebuffer dumps
+ * 
+ * Writes 8-bit RGB with uncompressed (stored) deflate blocks, so no zlib
+ * is needed. Files are larger than a compressed PNG but open in any viewer
+ * and diff tool.
+ */
+
+#include "ui_host.h"
+#include "lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEFLATE_STORED_MAX  65535
+
+static uint32_t s_crc_table[256];
+
+static void crc_init(void)
+{
+    for (uint32_t n = 0; n < 256; n++) {
+        uint32_t c = n;
+        for (int k = 0; k < 8; k++) {
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+        s_crc_table[n] = c;
+    }
+}
+
+static uint32_t crc_update(uint32_t crc, const uint8_t *buf, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        crc = s_crc_table[(crc ^ buf[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+static void put_be32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static bool write_chunk(FILE *f, const char *type, const uint8_t *data, uint32_t len)
+{
+    uint8_t hdr[8];
+    put_be32(hdr, len);
+    memcpy(hdr + 4, type, 4);
+    
+    uint32_t crc = crc_update(0xFFFFFFFFu, hdr + 4, 4);
+    crc = crc_update(crc, data, len) ^ 0xFFFFFFFFu;
+    uint8_t tail[4];
+    put_be32(tail, crc);
+    
+    return fwrite(hdr, 1, 8, f) == 8 &&
+           (len == 0 || fwrite(data, 1, len, f) == len) &&
+           fwrite(tail, 1, 4, f) == 4;
+}
+
+bool ui_host_write_png(const char *path, const void *pixels, uint32_t width, uint32_t height)
+{
+    static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    
+    if (!s_crc_table[1]) {
+        crc_init();
+    }
+    
+    // Raw scanlines: filter type 0 followed by RGB triples
+    size_t row_len = 1 + (size_t)width * 3;
+    size_t raw_len = row_len * height;
+    size_t blocks = (raw_len + DEFLATE_STORED_MAX - 1) / DEFLATE_STORED_MAX;
+    size_t idat_len = 2 + raw_len + blocks * 5 + 4;
+    
+    uint8_t *raw = malloc(raw_len);
+    uint8_t *idat = malloc(idat_len);
+    if (!raw || !idat) {
+        free(raw);
+        free(idat);
+        return false;
+    }
+    
+    const lv_color_t *px = pixels;
+    for (uint32_t y = 0; y < height; y++) {
+        uint8_t *row = raw + y * row_len;
+        row[0] = 0;
+        for (uint32_t x = 0; x < width; x++) {
+            lv_color32_t c;
+            c.full = lv_color_to32(px[y * width + x]);
+            row[1 + x * 3] = c.ch.red;
+            row[2 + x * 3] = c.ch.green;
+            row[3 + x * 3] = c.ch.blue;
+        }
+    }
+    
+    // zlib stream of stored blocks
+    uint8_t *out = idat;
+    *out++ = 0x78;
+    *out++ = 0x01;
+    uint32_t a = 1, b = 0;
+    for (size_t off = 0; off < raw_len; off += DEFLATE_STORED_MAX) {
+        size_t n = raw_len - off < DEFLATE_STORED_MAX ? raw_len - off : DEFLATE_STORED_MAX;
+        *out++ = (off + n == raw_len) ? 1 : 0;
+        *out++ = (uint8_t)n;
+        *out++ = (uint8_t)(n >> 8);
+        *out++ = (uint8_t)~n;
+        *out++ = (uint8_t)(~n >> 8);
+        memcpy(out, raw + off, n);
+        out += n;
+        for (size_t i = 0; i < n; i++) {
+            a = (a + raw[off + i]) % 65521;
+            b = (b + a) % 65521;
+        }
+    }
+    put_be32(out, (b << 16) | a);
+    
+    uint8_t ihdr[13];
+    put_be32(ihdr, width);
+    put_be32(ihdr + 4, height);
+    ihdr[8] = 8;    // Bit depth
+    ihdr[9] = 2;    // Colour type: RGB
+    ihdr[10] = 0;   // Compression
+    ihdr[11] = 0;   // Filter
+    ihdr[12] = 0;   // No interlace
+    
+    bool ok = false;
+    FILE *f = fopen(path, "wb");
+    if (f) {
+        ok = fwrite(signature, 1, sizeof(signature), f) == sizeof(signature) &&
+             write_chunk(f, "IHDR", ihdr, sizeof(ihdr)) &&
+             write_chunk(f, "IDAT", idat, (uint32_t)idat_len) &&
+             write_chunk(f, "IEND", NULL, 0);
+        ok = (fclose(f) == 0) && ok;
+    }
+    
+    free(raw);
+    free(idat);
+    return ok;
+}
@@ -0,0 +1,464 @@
+/**
+ * @file replay.c
+ * @brief Headless UI runner: replays touch traces and reports frame costs
+ * 
+ * Builds the main screen from the firmware UI sources on an in-memory
+ * 800x480 RGB565 display, then plays a trace file through a scripted
+ * pointer input device. LVGL runs on a simulated tick, so a trace produces
+ * the same frames on every run; the wall-clock time of each frame is
+ * measured and reported per trace section along with the number of
+ * pixels flushed and the number of live LVGL objects.
+ * 
+ * Trace format (one command per line, '#' starts a comment):
+ * 
+ *     mark <name>           start a new report section
+ *     press <x> <y>         touch down
+ *     move <x> <y> <ms>     drag to (x, y) over ms, linearly
+ *     release               touch up
+ *     tap <x> <y>           press, hold 60 ms, release
+ *     wait <ms>             let the UI run
+ *     snap <name>           write <png-dir>/<name>.png (with --png-dir)
+ * 
+ * Usage:
+ * 
+ *     ui_host_replay [options] <trace>
+ *       --scenes N       scenes in the store (default 12)
+ *       --buf-lines N    partial draw buffer of N lines; 0 renders straight
+ *                        into the framebuffer like LVGL_DIRECT_MODE (default)
+ *       --png-dir DIR    enable snap commands
+ *       --png-every      also dump every rendered frame
+ *       --csv FILE       per-frame samples
+ *       --max-p95-ms X   exit with status 2 if any section's p95 exceeds X
+ *       --verbose        show the UI's ESP_LOGI output
+ */
+
+#include "ui_host.h"
+#include "ui_common.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+// Simulated time per lv_timer_handler() call; the display refreshes on
+// every second step (LV_DISP_DEF_REFR_PERIOD = 10 ms)
+#define STEP_MS             5
+#define TAP_HOLD_MS         60
+#define SETTLE_MS           500
+#define MAX_FRAMES          65536
+#define MAX_SECTION_NAME    32
+
+static lv_color_t s_framebuffer[UI_HOST_HOR_RES * UI_HOST_VER_RES];
+static lv_color_t *s_draw_buf = NULL;
+
+static uint32_t s_tick_ms = 0;
+static int64_t s_busy_us = 0;
+
+static struct {
+    lv_coord_t x;
+    lv_coord_t y;
+    bool pressed;
+} s_touch;
+
+// Frame in progress (filled by the flush callback)
+static struct {
+    bool done;
+    uint32_t pixels;
+} s_frame;
+
+typedef struct {
+    uint32_t render_us;
+    uint32_t pixels;
+    uint32_t objects;
+} frame_sample_t;
+
+static struct {
+    char name[MAX_SECTION_NAME];
+    frame_sample_t *samples;
+    size_t count;
+    uint32_t start_tick;
+} s_section;
+
+static struct {
+    const char *png_dir;
+    bool png_every;
+    FILE *csv;
+    double max_p95_ms;
+    bool over_budget;
+    uint32_t frame_number;
+} s_opts;
+
+uint32_t ui_host_tick_get(void)
+{
+    return s_tick_ms;
+}
+
+int64_t ui_host_busy_us(void)
+{
+    return s_busy_us;
+}
+
+// ----- Display and input -----
+
+static void host_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    s_frame.pixels += (uint32_t)lv_area_get_size(area);
+    
+    // Partial mode: copy the chunk into the framebuffer like the panel DMA
+    if (!drv->direct_mode) {
+        for (lv_coord_t y = area->y1; y <= area->y2; y++) {
+            memcpy(&s_framebuffer[y * UI_HOST_HOR_RES + area->x1],
+                   &color_map[(y - area->y1) * w], w * sizeof(lv_color_t));
+        }
+    }
+    
+    if (lv_disp_flush_is_last(drv)) {
+        s_frame.done = true;
+    }
+    lv_disp_flush_ready(drv);
+}
+
+static void host_touch_read_cb(lv_indev_drv_t *drv, lv_indev_data_t *data)
+{
+    (void)drv;
+    data->point.x = s_touch.x;
+    data->point.y = s_touch.y;
+    data->state = s_touch.pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
+static bool display_init(uint32_t buf_lines)
+{
+    static lv_disp_draw_buf_t draw_buf;
+    static lv_disp_drv_t disp_drv;
+    static lv_indev_drv_t indev_drv;
+    
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = UI_HOST_HOR_RES;
+    disp_drv.ver_res = UI_HOST_VER_RES;
+    disp_drv.flush_cb = host_flush_cb;
+    
+    if (buf_lines == 0) {
+        lv_disp_draw_buf_init(&draw_buf, s_framebuffer, NULL, UI_HOST_HOR_RES * UI_HOST_VER_RES);
+        disp_drv.direct_mode = 1;
+    } else {
+        s_draw_buf = malloc(UI_HOST_HOR_RES * buf_lines * sizeof(lv_color_t));
+        if (!s_draw_buf) {
+            return false;
+        }
+        lv_disp_draw_buf_init(&draw_buf, s_draw_buf, NULL, UI_HOST_HOR_RES * buf_lines);
+    }
+    disp_drv.draw_buf = &draw_buf;
+    lv_disp_drv_register(&disp_drv);
+    
+    lv_indev_drv_init(&indev_drv);
+    indev_drv.type = LV_INDEV_TYPE_POINTER;
+    indev_drv.read_cb = host_touch_read_cb;
+    lv_indev_drv_register(&indev_drv);
+    return true;
+}
+
+// ----- Statistics -----
+
+static uint32_t count_objects(lv_obj_t *obj)
+{
+    uint32_t count = 1;
+    uint32_t children = lv_obj_get_child_cnt(obj);
+    for (uint32_t i = 0; i < children; i++) {
+        count += count_objects(lv_obj_get_child(obj, i));
+    }
+    return count;
+}
+
+static uint32_t count_live_objects(void)
+{
+    return count_objects(lv_scr_act()) + count_objects(lv_layer_top()) +
+           count_objects(lv_layer_sys());
+}
+
+static int compare_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void print_report_header(void)
+{
+    printf("%-16s %7s %8s %8s %8s %8s %8s %9s %8s\n", "section", "sim_ms", "frames",
+           "mean_ms", "p50_ms", "p95_ms", "max_ms", "px/frame", "objects");
+}
+
+static void section_report(void)
+{
+    if (!s_section.name[0]) {
+        return;
+    }
+    
+    uint32_t duration_ms = s_tick_ms - s_section.start_tick;
+    size_t n = s_section.count;
+    if (n == 0) {
+        printf("%-16s %7u %8u %8s %8s %8s %8s %9s %8u\n", s_section.name, (unsigned)duration_ms,
+               0u, "-", "-", "-", "-", "-", (unsigned)count_live_objects());
+        return;
+    }
+    
+    uint32_t *sorted = malloc(n * sizeof(uint32_t));
+    uint64_t total_us = 0;
+    uint64_t total_px = 0;
+    uint32_t max_objects = 0;
+    for (size_t i = 0; i < n; i++) {
+        sorted[i] = s_section.samples[i].render_us;
+        total_us += s_section.samples[i].render_us;
+        total_px += s_section.samples[i].pixels;
+        if (s_section.samples[i].objects > max_objects) {
+            max_objects = s_section.samples[i].objects;
+        }
+    }
+    qsort(sorted, n, sizeof(uint32_t), compare_u32);
+    
+    double p50 = sorted[n / 2] / 1000.0;
+    double p95 = sorted[(n * 95) / 100] / 1000.0;
+    printf("%-16s %7u %8u %8.2f %8.2f %8.2f %8.2f %9llu %8u\n", s_section.name,
+           (unsigned)duration_ms, (unsigned)n, total_us / 1000.0 / n, p50, p95,
+           sorted[n - 1] / 1000.0, (unsigned long long)(total_px / n), (unsigned)max_objects);
+    
+    if (s_opts.max_p95_ms > 0 && p95 > s_opts.max_p95_ms) {
+        s_opts.over_budget = true;
+    }
+    free(sorted);
+}
+
+static void section_start(const char *name)
+{
+    section_report();
+    snprintf(s_section.name, sizeof(s_section.name), "%s", name);
+    s_section.count = 0;
+    s_section.start_tick = s_tick_ms;
+}
+
+static void write_png(const char *name)
+{
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s.png", s_opts.png_dir, name);
+    if (!ui_host_write_png(path, s_framebuffer, UI_HOST_HOR_RES, UI_HOST_VER_RES)) {
+        fprintf(stderr, "Failed to write %s: %s\n", path, strerror(errno));
+    }
+}
+
+// ----- Replay -----
+
+/**
+ * @brief Advance the simulated clock by one step and run LVGL
+ */
+static void step(void)
+{
+    s_tick_ms += STEP_MS;
+    s_frame.done = false;
+    s_frame.pixels = 0;
+    
+    int64_t start = esp_timer_get_time();
+    lv_timer_handler();
+    int64_t elapsed = esp_timer_get_time() - start;
+    s_busy_us += elapsed;
+    
+    if (!s_frame.done) {
+        return;
+    }
+    
+    uint32_t objects = count_live_objects();
+    if (s_section.count < MAX_FRAMES) {
+        frame_sample_t *sample = &s_section.samples[s_section.count++];
+        sample->render_us = (uint32_t)elapsed;
+        sample->pixels = s_frame.pixels;
+        sample->objects = objects;
+    }
+    s_opts.frame_number++;
+    
+    if (s_opts.csv) {
+        fprintf(s_opts.csv, "%u,%s,%u,%u,%u\n", (unsigned)s_tick_ms, s_section.name,
+                (unsigned)elapsed, (unsigned)s_frame.pixels, (unsigned)objects);
+    }
+    if (s_opts.png_dir && s_opts.png_every) {
+        char name[64];
+        snprintf(name, sizeof(name), "frame_%06u", (unsigned)s_opts.frame_number);
+        write_png(name);
+    }
+}
+
+static void run_for(uint32_t ms)
+{
+    for (uint32_t t = 0; t < ms; t += STEP_MS) {
+        step();
+    }
+}
+
+static void drag_to(lv_coord_t x, lv_coord_t y, uint32_t ms)
+{
+    lv_coord_t x0 = s_touch.x;
+    lv_coord_t y0 = s_touch.y;
+    uint32_t steps = ms / STEP_MS;
+    
+    for (uint32_t i = 1; i <= steps; i++) {
+        s_touch.x = x0 + (lv_coord_t)((x - x0) * (int32_t)i / (int32_t)steps);
+        s_touch.y = y0 + (lv_coord_t)((y - y0) * (int32_t)i / (int32_t)steps);
+        step();
+    }
+    s_touch.x = x;
+    s_touch.y = y;
+}
+
+static bool run_trace(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "Cannot open trace %s: %s\n", path, strerror(errno));
+        return false;
+    }
+    
+    char line[256];
+    int line_no = 0;
+    bool ok = true;
+    while (ok && fgets(line, sizeof(line), f)) {
+        line_no++;
+        char *comment = strchr(line, '#');
+        if (comment) {
+            *comment = '\0';
+        }
+        
+        char cmd[16];
+        char name[MAX_SECTION_NAME];
+        int x, y, ms;
+        if (sscanf(line, "%15s", cmd) != 1) {
+            continue;
+        }
+        
+        if (strcmp(cmd, "mark") == 0 && sscanf(line, "%*s %31s", name) == 1) {
+            section_start(name);
+        } else if (strcmp(cmd, "press") == 0 && sscanf(line, "%*s %d %d", &x, &y) == 2) {
+            s_touch.x = x;
+            s_touch.y = y;
+            s_touch.pressed = true;
+            step();
+        } else if (strcmp(cmd, "move") == 0 && sscanf(line, "%*s %d %d %d", &x, &y, &ms) == 3) {
+            drag_to(x, y, ms);
+        } else if (strcmp(cmd, "release") == 0) {
+            s_touch.pressed = false;
+            step();
+        } else if (strcmp(cmd, "tap") == 0 && sscanf(line, "%*s %d %d", &x, &y) == 2) {
+            s_touch.x = x;
+            s_touch.y = y;
+            s_touch.pressed = true;
+            run_for(TAP_HOLD_MS);
+            s_touch.pressed = false;
+            step();
+        } else if (strcmp(cmd, "wait") == 0 && sscanf(line, "%*s %d", &ms) == 1) {
+            run_for(ms);
+        } else if (strcmp(cmd, "snap") == 0 && sscanf(line, "%*s %31s", name) == 1) {
+            if (s_opts.png_dir) {
+                write_png(name);
+            }
+        } else {
+            fprintf(stderr, "%s:%d: bad command: %s", path, line_no, line);
+            ok = false;
+        }
+    }
+    
+    fclose(f);
+    return ok;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [--scenes N] [--buf-lines N] [--png-dir DIR] [--png-every]\n"
+            "          [--csv FILE] [--max-p95-ms X] [--verbose] <trace>\n", prog);
+}
+
+int main(int argc, char **argv)
+{
+    size_t scene_count = 12;
+    uint32_t buf_lines = 0;
+    const char *trace = NULL;
+    
+    for (int i = 1; i < argc; i++) {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--scenes") == 0 && has_value) {
+            scene_count = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--buf-lines") == 0 && has_value) {
+            buf_lines = strtoul(argv[++i], NULL, 10);
+            if (buf_lines > UI_HOST_VER_RES) {
+                buf_lines = UI_HOST_VER_RES;
+            }
+        } else if (strcmp(argv[i], "--png-dir") == 0 && has_value) {
+            s_opts.png_dir = argv[++i];
+        } else if (strcmp(argv[i], "--png-every") == 0) {
+            s_opts.png_every = true;
+        } else if (strcmp(argv[i], "--csv") == 0 && has_value) {
+            s_opts.csv = fopen(argv[++i], "w");
+            if (!s_opts.csv) {
+                fprintf(stderr, "Cannot open %s: %s\n", argv[i], strerror(errno));
+                return 1;
+            }
+            fprintf(s_opts.csv, "tick_ms,section,render_us,pixels,objects\n");
+        } else if (strcmp(argv[i], "--max-p95-ms") == 0 && has_value) {
+            s_opts.max_p95_ms = strtod(argv[++i], NULL);
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            ui_host_log_level = ESP_LOG_INFO;
+        } else if (argv[i][0] != '-' && !trace) {
+            trace = argv[i];
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (!trace) {
+        usage(argv[0]);
+        return 1;
+    }
+    
+    s_section.samples = calloc(MAX_FRAMES, sizeof(frame_sample_t));
+    if (!s_section.samples) {
+        return 1;
+    }
+    
+    lv_init();
+    if (!display_init(buf_lines)) {
+        fprintf(stderr, "Out of memory for the draw buffer\n");
+        return 1;
+    }
+    
+    // Screen build is timed on its own; frames start with the settle period
+    ui_host_seed_scenes(scene_count);
+    int64_t build_start = esp_timer_get_time();
+    ui_create_main_screen();
+    int64_t build_us = esp_timer_get_time() - build_start;
+    s_busy_us += build_us;
+    
+    printf("trace %s, %u scenes, %s", trace, (unsigned)scene_count,
+           buf_lines ? "partial buffer" : "direct mode");
+    if (buf_lines) {
+        printf(" (%u lines)", (unsigned)buf_lines);
+    }
+    printf("\nscreen build %.2f ms, %u objects\n", build_us / 1000.0,
+           (unsigned)count_live_objects());
+    print_report_header();
+    
+    section_start("startup");
+    run_for(SETTLE_MS);
+    
+    bool ok = run_trace(trace);
+    section_report();
+    
+    if (s_opts.csv) {
+        fclose(s_opts.csv);
+    }
+    free(s_draw_buf);
+    free(s_section.samples);
+    
+    if (!ok) {
+        return 1;
+    }
+    return s_opts.over_budget ? 2 : 0;
+}
@@ -0,0 +1,17 @@
+/**
+ * @file esp_heap_caps.h
+ * @brief Host stand-in for capability-based allocation (plain malloc)
+ */
+
+#pragma once
+
+#include <stdlib.h>
+
+#define MALLOC_CAP_8BIT         (1 << 2)
+#define MALLOC_CAP_DMA          (1 << 3)
+#define MALLOC_CAP_INTERNAL     (1 << 11)
+#define MALLOC_CAP_SPIRAM       (1 << 10)
+
+#define heap_caps_malloc(size, caps)    malloc(size)
+#define heap_caps_calloc(n, size, caps) calloc(n, size)
+#define heap_caps_free(ptr)             free(ptr)
@@ -0,0 +1,31 @@
+/**
+ * @file esp_log.h
+ * @brief Host stand-in for ESP-IDF logging (stderr, level set by the runner)
+ */
+
+#pragma once
+
+#include <stdio.h>
+
+typedef enum {
+    ESP_LOG_NONE,
+    ESP_LOG_ERROR,
+    ESP_LOG_WARN,
+    ESP_LOG_INFO,
+    ESP_LOG_DEBUG,
+    ESP_LOG_VERBOSE
+} esp_log_level_t;
+
+extern esp_log_level_t ui_host_log_level;
+
+#define UI_HOST_LOG(level, letter, tag, format, ...) do {                       \
+        if (ui_host_log_level >= (level)) {                                     \
+            fprintf(stderr, letter " (%s) " format "\n", tag, ##__VA_ARGS__);   \
+        }                                                                       \
+    } while (0)
+
+#define ESP_LOGE(tag, format, ...) UI_HOST_LOG(ESP_LOG_ERROR, "E", tag, format, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) UI_HOST_LOG(ESP_LOG_WARN, "W", tag, format, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) UI_HOST_LOG(ESP_LOG_INFO, "I", tag, format, ##__VA_ARGS__)
+#define ESP_LOGD(tag, format, ...) UI_HOST_LOG(ESP_LOG_DEBUG, "D", tag, format, ##__VA_ARGS__)
+#define ESP_LOGV(tag, format, ...) UI_HOST_LOG(ESP_LOG_VERBOSE, "V", tag, format, ##__VA_ARGS__)
@@ -0,0 +1,10 @@
+/**
+ * @file esp_timer.h
+ * @brief Host stand-in for esp_timer_get_time() (monotonic wall clock)
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+int64_t esp_timer_get_time(void);
@@ -0,0 +1,62 @@
+/**
+ * @file ui_host.h
+ * @brief Headless host build of the UI - runner interfaces
+ * 
+ * The firmware's ui_main.c, ui_scenes.c and ui_manual.c are compiled
+ * unchanged against LVGL on the host. host_port.c stands in for the
+ * ESP-IDF and app modules they call, and replay.c drives them from
+ * scripted touch traces on an in-memory 800x480 framebuffer.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UI_HOST_HOR_RES     800
+#define UI_HOST_VER_RES     480
+
+/**
+ * @brief Simulated LVGL tick (ms), advanced by the runner each frame
+ * 
+ * Traces replay on simulated time so animations, scroll throw and timers
+ * run the same way on every machine; only render time is measured in
+ * wall-clock time.
+ */
+uint32_t ui_host_tick_get(void);
+
+/**
+ * @brief Wall-clock time spent in lv_timer_handler() so far (us)
+ * 
+ * Backs ui_get_lvgl_busy_us() for the carousel scroll log.
+ */
+int64_t ui_host_busy_us(void);
+
+/**
+ * @brief Fill the in-memory scene store with generated scenes
+ * 
+ * Must be called before the UI is created.
+ * 
+ * @param count Number of scenes (clamped to SCENE_STORAGE_MAX_SCENES)
+ */
+void ui_host_seed_scenes(size_t count);
+
+/**
+ * @brief Write an RGB565 framebuffer to a PNG file
+ * 
+ * @param path Output file
+ * @param pixels Framebuffer in LVGL colour format
+ * @param width Width in pixels
+ * @param height Height in pixels
+ * @return true on success
+ */
+bool ui_host_write_png(const char *path, const void *pixels, uint32_t width, uint32_t height);
+
+#ifdef __cplusplus
+}
+#endif